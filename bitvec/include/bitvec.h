@@ -0,0 +1,231 @@
+/**
+ * @file bitvec.h
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Packed bit vector with rank and select.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @def BITVEC_WORD_BITS
+ * Bits stored per word.
+ */
+#define BITVEC_WORD_BITS 64
+
+/**
+ * @struct bitvec
+ * Bit vector object. Fields should not be edited.
+ *
+ * @var bitvec::count
+ * Current bit count.
+ *
+ * @internal
+ *
+ * @var bitvec::_words
+ * Bit storage, bits past count are always zero.
+ * @var bitvec::_alloc_words
+ * How many words can fit in _words.
+ * @var bitvec::_ranks
+ * Index: amount of set bits before each block.
+ * @var bitvec::_samples
+ * Index: block holding every sampled set bit, used by select.
+ * @var bitvec::_sample_count
+ * Amount of entries in _samples.
+ * @var bitvec::_indexed
+ * Whether the index matches the current contents.
+ *
+ * @endinternal
+ */
+typedef struct {
+	size_t count;
+
+	uint64_t *_words;
+	size_t _alloc_words;
+	size_t *_ranks;
+	size_t *_samples;
+	size_t _sample_count;
+	bool _indexed;
+} bitvec;
+
+/**
+ * @enum bitvec_status
+ * Result of bit vector operation.
+ *
+ * @var bitvec_status::BITVEC_STATUS_OK
+ * Operation completed successfully.
+ *
+ * @var bitvec_status::BITVEC_STATUS_NULL
+ * Bit vector argument is null.
+ *
+ * @var bitvec_status::BITVEC_STATUS_BOUNDS
+ * Operation was out of bounds.
+ *
+ * @var bitvec_status::BITVEC_STATUS_ALLOC
+ * Memory allocation failed.
+ */
+typedef enum {
+	BITVEC_STATUS_OK = 0,
+	BITVEC_STATUS_NULL = 1,
+	BITVEC_STATUS_BOUNDS = 2,
+	BITVEC_STATUS_ALLOC = 3,
+} bitvec_status;
+
+/**
+ * @brief Create bit vector object on the stack.
+ *
+ * @return Bit vector object.
+ * @note Delete with bitvec_deinit.
+ */
+bitvec bitvec_init(void);
+
+/**
+ * @brief Create bit vector object on the heap.
+ *
+ * @return Bit vector object.
+ * @note Delete with bitvec_delete.
+ */
+bitvec *bitvec_new(void);
+
+/**
+ * @brief Delete bit vector object from the stack.
+ *
+ * @param[in] bv - Bit vector object.
+ * @return Status code.
+ */
+bitvec_status bitvec_deinit(bitvec *bv);
+
+/**
+ * @brief Delete bit vector object from the heap.
+ *
+ * @param[in] bv - Bit vector object.
+ * @return Status code.
+ */
+bitvec_status bitvec_delete(bitvec *bv);
+
+/**
+ * @brief Reserve space for bits.
+ *
+ * @param[in,out] bv - Bit vector object.
+ * @param[in] count - Amount of bits to reserve.
+ * @return Status code.
+ * @note Will only grow the object.
+ */
+bitvec_status bitvec_reserve(bitvec *bv, size_t count);
+
+/**
+ * @brief Add bit to the end.
+ *
+ * @param[in,out] bv - Bit vector object.
+ * @param[in] bit - New bit.
+ * @return Status code.
+ */
+bitvec_status bitvec_push(bitvec *bv, bool bit);
+
+/**
+ * @brief Read bit at specified location.
+ *
+ * @param[in] bv - Bit vector object.
+ * @param[in] index - Access index.
+ * @param[out] bit - Bit value.
+ * @return Status code.
+ */
+bitvec_status bitvec_get(const bitvec *bv, size_t index, bool *bit);
+
+/**
+ * @brief Write bit at specified location.
+ *
+ * @param[in,out] bv - Bit vector object.
+ * @param[in] index - Access index.
+ * @param[in] bit - New bit value.
+ * @return Status code.
+ */
+bitvec_status bitvec_set(bitvec *bv, size_t index, bool bit);
+
+/**
+ * @brief Bitwise AND another bit vector into this one.
+ *
+ * @param[in,out] dst - Bit vector object, receives the result.
+ * @param[in] src - Bit vector of the same count.
+ * @return Status code.
+ */
+bitvec_status bitvec_and(bitvec *dst, const bitvec *src);
+
+/**
+ * @brief Bitwise OR another bit vector into this one.
+ *
+ * @param[in,out] dst - Bit vector object, receives the result.
+ * @param[in] src - Bit vector of the same count.
+ * @return Status code.
+ */
+bitvec_status bitvec_or(bitvec *dst, const bitvec *src);
+
+/**
+ * @brief Bitwise XOR another bit vector into this one.
+ *
+ * @param[in,out] dst - Bit vector object, receives the result.
+ * @param[in] src - Bit vector of the same count.
+ * @return Status code.
+ */
+bitvec_status bitvec_xor(bitvec *dst, const bitvec *src);
+
+/**
+ * @brief Clear bits of this bit vector that are set in another one.
+ *
+ * @param[in,out] dst - Bit vector object, receives the result.
+ * @param[in] src - Bit vector of the same count.
+ * @return Status code.
+ */
+bitvec_status bitvec_andnot(bitvec *dst, const bitvec *src);
+
+/**
+ * @brief Count set bits.
+ *
+ * @param[in] bv - Bit vector object.
+ * @return Amount of set bits, 0 if bv is NULL.
+ */
+size_t bitvec_popcount(const bitvec *bv);
+
+/**
+ * @brief Build the rank and select index.
+ *
+ * @param[in,out] bv - Bit vector object.
+ * @return Status code.
+ * @note Called by bitvec_rank and bitvec_select when the bit vector was
+ * modified since the last build.
+ */
+bitvec_status bitvec_build_index(bitvec *bv);
+
+/**
+ * @brief Count set bits before specified location in O(1).
+ *
+ * @param[in,out] bv - Bit vector object.
+ * @param[in] index - End index (exclusive), up to count.
+ * @param[out] rank - Amount of set bits in [0, index).
+ * @return Status code.
+ */
+bitvec_status bitvec_rank(bitvec *bv, size_t index, size_t *rank);
+
+/**
+ * @brief Find location of a set bit by its rank.
+ *
+ * @param[in,out] bv - Bit vector object.
+ * @param[in] rank - Amount of set bits before the one to find.
+ * @param[out] index - Location of the set bit.
+ * @return Status code.
+ */
+bitvec_status bitvec_select(bitvec *bv, size_t rank, size_t *index);
+
+/**
+ * @brief Collect bit vector words, resetting the bit vector.
+ *
+ * @param[in] bv - Bit vector object.
+ * @return Word array, bit i is stored in word i / 64 at position i % 64.
+ * @note User is responsible for freeing the memory.
+ */
+uint64_t *bitvec_collect(bitvec *bv);
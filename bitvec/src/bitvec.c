@@ -0,0 +1,440 @@
+/**
+ * @file bitvec.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Packed bit vector with rank and select.
+ */
+#include "bitvec.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Growth factor
+#define FACTOR 2
+
+// Words per rank block (512 bits)
+#define BLOCK_WORDS 8
+
+// Set bits per select sample
+#define SELECT_SAMPLE 4096
+
+// Words needed to store bits
+#define word_count(bits)                                                       \
+	((bits) / BITVEC_WORD_BITS + ((bits) % BITVEC_WORD_BITS != 0))
+
+// Mask of a bit inside its word
+#define bit_mask(index) ((uint64_t)1 << ((index) % BITVEC_WORD_BITS))
+
+// Hardware popcount when built for a target that has it (e.g. -mpopcnt)
+#define popcount(word) ((size_t)__builtin_popcountll(word))
+
+// Otherwise counting functions get a popcnt clone selected at load time
+#if defined(__x86_64__) && defined(__linux__) && !defined(__POPCNT__)
+#define POPCNT_DISPATCH __attribute__((target_clones("popcnt", "default")))
+#else
+#define POPCNT_DISPATCH
+#endif
+
+static bitvec_status check_pair(const bitvec *dst, const bitvec *src);
+static size_t select_in_word(uint64_t word, size_t rank);
+
+bitvec bitvec_init(void) {
+	bitvec bv = {
+		.count = 0,
+		._words = NULL,
+		._alloc_words = 0,
+		._ranks = NULL,
+		._samples = NULL,
+		._sample_count = 0,
+		._indexed = false,
+	};
+
+	return bv;
+}
+
+bitvec *bitvec_new(void) {
+	bitvec *bv = malloc(sizeof(bitvec));
+	if (bv == NULL) {
+		return NULL;
+	}
+
+	*bv = bitvec_init();
+	return bv;
+}
+
+bitvec_status bitvec_deinit(bitvec *bv) {
+	if (bv == NULL) {
+		return BITVEC_STATUS_NULL;
+	}
+
+	free(bv->_words);
+	free(bv->_ranks);
+	free(bv->_samples);
+
+	return BITVEC_STATUS_OK;
+}
+
+bitvec_status bitvec_delete(bitvec *bv) {
+	if (bitvec_deinit(bv) == BITVEC_STATUS_NULL) {
+		return BITVEC_STATUS_NULL;
+	}
+
+	free(bv);
+	return BITVEC_STATUS_OK;
+}
+
+bitvec_status bitvec_reserve(bitvec *bv, size_t count) {
+	if (bv == NULL) {
+		return BITVEC_STATUS_NULL;
+	}
+
+	size_t words = word_count(count);
+	if (words <= bv->_alloc_words) {
+		return BITVEC_STATUS_OK;
+	}
+
+	if (words > SIZE_MAX / sizeof(uint64_t)) {
+		return BITVEC_STATUS_ALLOC;
+	}
+
+	uint64_t *new_words = realloc(bv->_words, sizeof(uint64_t) * words);
+	if (new_words == NULL) {
+		return BITVEC_STATUS_ALLOC;
+	}
+
+	// Keep bits past count cleared
+	memset(new_words + bv->_alloc_words, 0,
+		sizeof(uint64_t) * (words - bv->_alloc_words));
+
+	bv->_words = new_words;
+	bv->_alloc_words = words;
+
+	return BITVEC_STATUS_OK;
+}
+
+bitvec_status bitvec_push(bitvec *bv, bool bit) {
+	if (bv == NULL) {
+		return BITVEC_STATUS_NULL;
+	}
+
+	// New to grow bit vector
+	if (bv->count == bv->_alloc_words * BITVEC_WORD_BITS) {
+		if (bv->count > SIZE_MAX / FACTOR) {
+			return BITVEC_STATUS_ALLOC;
+		}
+
+		// clang-format off
+		size_t new_count = (bv->_words == NULL)
+			? BITVEC_WORD_BITS
+			: bv->count * FACTOR;
+		// clang-format on
+		bitvec_status status = bitvec_reserve(bv, new_count);
+		if (status != BITVEC_STATUS_OK) {
+			return status;
+		}
+	}
+
+	if (bit) {
+		bv->_words[bv->count / BITVEC_WORD_BITS] |= bit_mask(bv->count);
+	}
+
+	bv->count++;
+	bv->_indexed = false;
+
+	return BITVEC_STATUS_OK;
+}
+
+bitvec_status bitvec_get(const bitvec *bv, size_t index, bool *bit) {
+	if (bv == NULL || bit == NULL) {
+		return BITVEC_STATUS_NULL;
+	}
+
+	if (index >= bv->count) {
+		return BITVEC_STATUS_BOUNDS;
+	}
+
+	*bit = (bv->_words[index / BITVEC_WORD_BITS] & bit_mask(index)) != 0;
+	return BITVEC_STATUS_OK;
+}
+
+bitvec_status bitvec_set(bitvec *bv, size_t index, bool bit) {
+	if (bv == NULL) {
+		return BITVEC_STATUS_NULL;
+	}
+
+	if (index >= bv->count) {
+		return BITVEC_STATUS_BOUNDS;
+	}
+
+	if (bit) {
+		bv->_words[index / BITVEC_WORD_BITS] |= bit_mask(index);
+	} else {
+		bv->_words[index / BITVEC_WORD_BITS] &= ~bit_mask(index);
+	}
+
+	bv->_indexed = false;
+	return BITVEC_STATUS_OK;
+}
+
+bitvec_status bitvec_and(bitvec *dst, const bitvec *src) {
+	bitvec_status status = check_pair(dst, src);
+	if (status != BITVEC_STATUS_OK) {
+		return status;
+	}
+
+	size_t words = word_count(dst->count);
+	for (size_t i = 0; i < words; i++) {
+		dst->_words[i] &= src->_words[i];
+	}
+
+	dst->_indexed = false;
+	return BITVEC_STATUS_OK;
+}
+
+bitvec_status bitvec_or(bitvec *dst, const bitvec *src) {
+	bitvec_status status = check_pair(dst, src);
+	if (status != BITVEC_STATUS_OK) {
+		return status;
+	}
+
+	size_t words = word_count(dst->count);
+	for (size_t i = 0; i < words; i++) {
+		dst->_words[i] |= src->_words[i];
+	}
+
+	dst->_indexed = false;
+	return BITVEC_STATUS_OK;
+}
+
+bitvec_status bitvec_xor(bitvec *dst, const bitvec *src) {
+	bitvec_status status = check_pair(dst, src);
+	if (status != BITVEC_STATUS_OK) {
+		return status;
+	}
+
+	size_t words = word_count(dst->count);
+	for (size_t i = 0; i < words; i++) {
+		dst->_words[i] ^= src->_words[i];
+	}
+
+	dst->_indexed = false;
+	return BITVEC_STATUS_OK;
+}
+
+bitvec_status bitvec_andnot(bitvec *dst, const bitvec *src) {
+	bitvec_status status = check_pair(dst, src);
+	if (status != BITVEC_STATUS_OK) {
+		return status;
+	}
+
+	size_t words = word_count(dst->count);
+	for (size_t i = 0; i < words; i++) {
+		dst->_words[i] &= ~src->_words[i];
+	}
+
+	dst->_indexed = false;
+	return BITVEC_STATUS_OK;
+}
+
+POPCNT_DISPATCH size_t bitvec_popcount(const bitvec *bv) {
+	if (bv == NULL) {
+		return 0;
+	}
+
+	size_t total = 0;
+	size_t words = word_count(bv->count);
+	for (size_t i = 0; i < words; i++) {
+		total += popcount(bv->_words[i]);
+	}
+
+	return total;
+}
+
+POPCNT_DISPATCH bitvec_status bitvec_build_index(bitvec *bv) {
+	if (bv == NULL) {
+		return BITVEC_STATUS_NULL;
+	}
+
+	size_t words = word_count(bv->count);
+	size_t block_count = (words + BLOCK_WORDS - 1) / BLOCK_WORDS;
+
+	size_t *ranks = realloc(bv->_ranks, sizeof(size_t) * (block_count + 1));
+	if (ranks == NULL) {
+		return BITVEC_STATUS_ALLOC;
+	}
+	bv->_ranks = ranks;
+
+	// Cumulative set bits before each block
+	ranks[0] = 0;
+	for (size_t block = 0; block < block_count; block++) {
+		size_t block_rank = 0;
+		size_t end = (block + 1) * BLOCK_WORDS;
+		for (size_t i = block * BLOCK_WORDS; i < end && i < words; i++) {
+			block_rank += popcount(bv->_words[i]);
+		}
+
+		ranks[block + 1] = ranks[block] + block_rank;
+	}
+
+	size_t total = ranks[block_count];
+	size_t sample_count = (total + SELECT_SAMPLE - 1) / SELECT_SAMPLE;
+
+	size_t *samples
+		= realloc(bv->_samples, sizeof(size_t) * (sample_count + 1));
+	if (samples == NULL) {
+		return BITVEC_STATUS_ALLOC;
+	}
+	bv->_samples = samples;
+
+	// Block holding every SELECT_SAMPLE-th set bit
+	size_t block = 0;
+	for (size_t sample = 0; sample < sample_count; sample++) {
+		while (ranks[block + 1] <= sample * SELECT_SAMPLE) {
+			block++;
+		}
+
+		samples[sample] = block;
+	}
+
+	bv->_sample_count = sample_count;
+	bv->_indexed = true;
+
+	return BITVEC_STATUS_OK;
+}
+
+POPCNT_DISPATCH bitvec_status bitvec_rank(bitvec *bv,
+	size_t index,
+	size_t *rank) {
+	if (bv == NULL || rank == NULL) {
+		return BITVEC_STATUS_NULL;
+	}
+
+	if (index > bv->count) {
+		return BITVEC_STATUS_BOUNDS;
+	}
+
+	if (!bv->_indexed) {
+		bitvec_status status = bitvec_build_index(bv);
+		if (status != BITVEC_STATUS_OK) {
+			return status;
+		}
+	}
+
+	// Block rank, then at most one block of words
+	size_t word = index / BITVEC_WORD_BITS;
+	size_t block = word / BLOCK_WORDS;
+	size_t result = bv->_ranks[block];
+	for (size_t i = block * BLOCK_WORDS; i < word; i++) {
+		result += popcount(bv->_words[i]);
+	}
+
+	if (index % BITVEC_WORD_BITS != 0) {
+		result += popcount(bv->_words[word] & (bit_mask(index) - 1));
+	}
+
+	*rank = result;
+	return BITVEC_STATUS_OK;
+}
+
+POPCNT_DISPATCH bitvec_status bitvec_select(bitvec *bv,
+	size_t rank,
+	size_t *index) {
+	if (bv == NULL || index == NULL) {
+		return BITVEC_STATUS_NULL;
+	}
+
+	if (!bv->_indexed) {
+		bitvec_status status = bitvec_build_index(bv);
+		if (status != BITVEC_STATUS_OK) {
+			return status;
+		}
+	}
+
+	size_t block_count
+		= (word_count(bv->count) + BLOCK_WORDS - 1) / BLOCK_WORDS;
+	if (rank >= bv->_ranks[block_count]) {
+		return BITVEC_STATUS_BOUNDS;
+	}
+
+	// Binary search blocks between neighbouring samples
+	size_t sample = rank / SELECT_SAMPLE;
+	size_t low = bv->_samples[sample];
+	// clang-format off
+	size_t high = (sample + 1 < bv->_sample_count)
+		? bv->_samples[sample + 1]
+		: block_count - 1;
+	// clang-format on
+	while (low < high) {
+		size_t mid = low + (high - low + 1) / 2;
+		if (bv->_ranks[mid] <= rank) {
+			low = mid;
+		} else {
+			high = mid - 1;
+		}
+	}
+
+	// Scan words of the block
+	size_t remaining = rank - bv->_ranks[low];
+	size_t word = low * BLOCK_WORDS;
+	while (popcount(bv->_words[word]) <= remaining) {
+		remaining -= popcount(bv->_words[word]);
+		word++;
+	}
+
+	*index = word * BITVEC_WORD_BITS
+		+ select_in_word(bv->_words[word], remaining);
+	return BITVEC_STATUS_OK;
+}
+
+uint64_t *bitvec_collect(bitvec *bv) {
+	if (bv == NULL) {
+		return NULL;
+	}
+
+	uint64_t *retrieved = bv->_words;
+	free(bv->_ranks);
+	free(bv->_samples);
+	*bv = bitvec_init();
+
+	return retrieved;
+}
+
+/**
+ * @brief Check that two bit vectors can be combined.
+ *
+ * @param[in] dst - Destination bit vector.
+ * @param[in] src - Source bit vector.
+ * @return Status code.
+ */
+static bitvec_status check_pair(const bitvec *dst, const bitvec *src) {
+	if (dst == NULL || src == NULL) {
+		return BITVEC_STATUS_NULL;
+	}
+
+	if (dst->count != src->count) {
+		return BITVEC_STATUS_BOUNDS;
+	}
+
+	return BITVEC_STATUS_OK;
+}
+
+/**
+ * @brief Find position of a set bit inside a word.
+ *
+ * @param[in] word - Word with more than rank set bits.
+ * @param[in] rank - Amount of set bits before the one to find.
+ * @return Bit position.
+ */
+static size_t select_in_word(uint64_t word, size_t rank) {
+	// Drop lower set bits
+	for (size_t i = 0; i < rank; i++) {
+		word &= word - 1;
+	}
+
+	return (size_t)__builtin_ctzll(word);
+}
@@ -0,0 +1,297 @@
+extern "C" {
+#include "../include/bitvec.h"
+}
+
+#include <cstdint>
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+TEST(Bitvec, BitvecInitOk) {
+	bitvec bv = bitvec_init();
+
+	EXPECT_EQ(bv.count, 0);
+	EXPECT_EQ(bv._words, nullptr);
+}
+
+TEST(Bitvec, BitvecNewOk) {
+	bitvec *bv = bitvec_new();
+
+	EXPECT_NE(bv, nullptr);
+	EXPECT_EQ(bv->count, 0);
+	EXPECT_EQ(bv->_words, nullptr);
+
+	free(bv);
+}
+
+TEST(Bitvec, BitvecDeinitNullArg) {
+	bitvec *bv = nullptr;
+
+	EXPECT_EQ(bitvec_deinit(bv), BITVEC_STATUS_NULL);
+}
+
+TEST(Bitvec, BitvecDeleteNullArg) {
+	bitvec *bv = nullptr;
+
+	EXPECT_EQ(bitvec_delete(bv), BITVEC_STATUS_NULL);
+}
+
+TEST(Bitvec, BitvecReserveNull) {
+	bitvec *bv = nullptr;
+
+	EXPECT_EQ(bitvec_reserve(bv, 10), BITVEC_STATUS_NULL);
+}
+
+TEST(Bitvec, BitvecReserveOk) {
+	bitvec bv = bitvec_init();
+
+	EXPECT_EQ(bitvec_reserve(&bv, 65), BITVEC_STATUS_OK);
+	EXPECT_EQ(bv._alloc_words, 2);
+	EXPECT_EQ(bv._words[0], 0);
+	EXPECT_EQ(bv._words[1], 0);
+	EXPECT_EQ(bv.count, 0);
+
+	bitvec_deinit(&bv);
+}
+
+TEST(Bitvec, BitvecReserveAlloc) {
+	bitvec bv = bitvec_init();
+
+	EXPECT_EQ(bitvec_reserve(&bv, SIZE_MAX), BITVEC_STATUS_ALLOC);
+	EXPECT_EQ(bv._words, nullptr);
+}
+
+TEST(Bitvec, BitvecPushNull) {
+	bitvec *bv = nullptr;
+
+	EXPECT_EQ(bitvec_push(bv, true), BITVEC_STATUS_NULL);
+}
+
+TEST(Bitvec, BitvecPushOk) {
+	bitvec bv = bitvec_init();
+
+	for (int i = 0; i < 130; i++) {
+		EXPECT_EQ(bitvec_push(&bv, i % 3 == 0), BITVEC_STATUS_OK);
+	}
+	EXPECT_EQ(bv.count, 130);
+
+	// Packed into words
+	EXPECT_EQ(bv._words[0] & 0xf, 0x9);
+	EXPECT_EQ(bv._words[2], 0x2);
+
+	bitvec_deinit(&bv);
+}
+
+TEST(Bitvec, BitvecGetNull) {
+	bool bit;
+
+	EXPECT_EQ(bitvec_get(nullptr, 0, &bit), BITVEC_STATUS_NULL);
+}
+
+TEST(Bitvec, BitvecGetBounds) {
+	bitvec bv = bitvec_init();
+	bitvec_push(&bv, true);
+
+	bool bit;
+	EXPECT_EQ(bitvec_get(&bv, 1, &bit), BITVEC_STATUS_BOUNDS);
+
+	bitvec_deinit(&bv);
+}
+
+TEST(Bitvec, BitvecSetNull) {
+	bitvec *bv = nullptr;
+
+	EXPECT_EQ(bitvec_set(bv, 0, true), BITVEC_STATUS_NULL);
+}
+
+TEST(Bitvec, BitvecSetBounds) {
+	bitvec bv = bitvec_init();
+	bitvec_reserve(&bv, 64);
+
+	EXPECT_EQ(bitvec_set(&bv, 0, true), BITVEC_STATUS_BOUNDS);
+
+	bitvec_deinit(&bv);
+}
+
+TEST(Bitvec, BitvecSetOk) {
+	bitvec bv = bitvec_init();
+	for (int i = 0; i < 100; i++) {
+		bitvec_push(&bv, false);
+	}
+
+	EXPECT_EQ(bitvec_set(&bv, 70, true), BITVEC_STATUS_OK);
+	EXPECT_EQ(bitvec_set(&bv, 3, true), BITVEC_STATUS_OK);
+	EXPECT_EQ(bitvec_set(&bv, 3, false), BITVEC_STATUS_OK);
+
+	bool bit;
+	EXPECT_EQ(bitvec_get(&bv, 70, &bit), BITVEC_STATUS_OK);
+	EXPECT_TRUE(bit);
+	EXPECT_EQ(bitvec_get(&bv, 3, &bit), BITVEC_STATUS_OK);
+	EXPECT_FALSE(bit);
+	EXPECT_EQ(bitvec_popcount(&bv), 1);
+
+	bitvec_deinit(&bv);
+}
+
+TEST(Bitvec, BitvecOpsNull) {
+	bitvec bv = bitvec_init();
+
+	EXPECT_EQ(bitvec_and(&bv, nullptr), BITVEC_STATUS_NULL);
+	EXPECT_EQ(bitvec_or(nullptr, &bv), BITVEC_STATUS_NULL);
+	EXPECT_EQ(bitvec_xor(&bv, nullptr), BITVEC_STATUS_NULL);
+	EXPECT_EQ(bitvec_andnot(nullptr, &bv), BITVEC_STATUS_NULL);
+}
+
+TEST(Bitvec, BitvecOpsBounds) {
+	bitvec bv0 = bitvec_init();
+	bitvec bv1 = bitvec_init();
+	bitvec_push(&bv0, true);
+
+	EXPECT_EQ(bitvec_and(&bv0, &bv1), BITVEC_STATUS_BOUNDS);
+
+	bitvec_deinit(&bv0);
+}
+
+TEST(Bitvec, BitvecOpsOk) {
+	bitvec a = bitvec_init();
+	bitvec b = bitvec_init();
+	bool bits_a[] = { true, true, false, false };
+	bool bits_b[] = { true, false, true, false };
+	for (int i = 0; i < 4; i++) {
+		bitvec_push(&a, bits_a[i]);
+		bitvec_push(&b, bits_b[i]);
+	}
+
+	bitvec result = bitvec_init();
+	for (int i = 0; i < 4; i++) {
+		bitvec_push(&result, bits_a[i]);
+	}
+
+	EXPECT_EQ(bitvec_and(&result, &b), BITVEC_STATUS_OK);
+	EXPECT_EQ(result._words[0], 0x1);
+	EXPECT_EQ(bitvec_or(&result, &a), BITVEC_STATUS_OK);
+	EXPECT_EQ(result._words[0], 0x3);
+	EXPECT_EQ(bitvec_xor(&result, &b), BITVEC_STATUS_OK);
+	EXPECT_EQ(result._words[0], 0x6);
+	EXPECT_EQ(bitvec_andnot(&result, &a), BITVEC_STATUS_OK);
+	EXPECT_EQ(result._words[0], 0x4);
+
+	bitvec_deinit(&a);
+	bitvec_deinit(&b);
+	bitvec_deinit(&result);
+}
+
+TEST(Bitvec, BitvecPopcountOk) {
+	bitvec bv = bitvec_init();
+
+	EXPECT_EQ(bitvec_popcount(nullptr), 0);
+	EXPECT_EQ(bitvec_popcount(&bv), 0);
+	for (int i = 0; i < 1000; i++) {
+		bitvec_push(&bv, i % 7 == 0);
+	}
+	EXPECT_EQ(bitvec_popcount(&bv), 143);
+
+	bitvec_deinit(&bv);
+}
+
+TEST(Bitvec, BitvecRankNull) {
+	size_t rank;
+
+	EXPECT_EQ(bitvec_rank(nullptr, 0, &rank), BITVEC_STATUS_NULL);
+}
+
+TEST(Bitvec, BitvecRankBounds) {
+	bitvec bv = bitvec_init();
+	bitvec_push(&bv, true);
+
+	size_t rank;
+	EXPECT_EQ(bitvec_rank(&bv, 2, &rank), BITVEC_STATUS_BOUNDS);
+
+	bitvec_deinit(&bv);
+}
+
+TEST(Bitvec, BitvecRankOk) {
+	bitvec bv = bitvec_init();
+	for (int i = 0; i < 2000; i++) {
+		bitvec_push(&bv, i % 3 == 0);
+	}
+
+	size_t rank;
+	EXPECT_EQ(bitvec_rank(&bv, 0, &rank), BITVEC_STATUS_OK);
+	EXPECT_EQ(rank, 0);
+	EXPECT_EQ(bitvec_rank(&bv, 1, &rank), BITVEC_STATUS_OK);
+	EXPECT_EQ(rank, 1);
+	EXPECT_EQ(bitvec_rank(&bv, 1024, &rank), BITVEC_STATUS_OK);
+	EXPECT_EQ(rank, 342);
+	EXPECT_EQ(bitvec_rank(&bv, 2000, &rank), BITVEC_STATUS_OK);
+	EXPECT_EQ(rank, 667);
+
+	// Index is rebuilt after changes
+	bitvec_set(&bv, 1, true);
+	EXPECT_EQ(bitvec_rank(&bv, 2000, &rank), BITVEC_STATUS_OK);
+	EXPECT_EQ(rank, 668);
+
+	bitvec_deinit(&bv);
+}
+
+TEST(Bitvec, BitvecSelectNull) {
+	size_t index;
+
+	EXPECT_EQ(bitvec_select(nullptr, 0, &index), BITVEC_STATUS_NULL);
+}
+
+TEST(Bitvec, BitvecSelectBounds) {
+	bitvec bv = bitvec_init();
+	bitvec_push(&bv, false);
+	bitvec_push(&bv, true);
+
+	size_t index;
+	EXPECT_EQ(bitvec_select(&bv, 1, &index), BITVEC_STATUS_BOUNDS);
+	EXPECT_EQ(bitvec_select(&bv, 0, &index), BITVEC_STATUS_OK);
+	EXPECT_EQ(index, 1);
+
+	bitvec_deinit(&bv);
+}
+
+TEST(Bitvec, BitvecCollectOk) {
+	bitvec bv = bitvec_init();
+	bitvec_push(&bv, true);
+	bitvec_push(&bv, false);
+	bitvec_push(&bv, true);
+
+	uint64_t *words = bitvec_collect(&bv);
+	EXPECT_EQ(words[0], 0x5);
+	EXPECT_EQ(bv.count, 0);
+	EXPECT_EQ(bv._words, nullptr);
+
+	free(words);
+}
+
+TEST(Bitvec, FullTest) {
+	bitvec *bv = bitvec_new();
+
+	// Sparse and dense regions, spanning several select samples
+	for (size_t i = 0; i < 100000; i++) {
+		bool bit = (i < 50000) ? (i % 5 == 0) : (i % 2 == 1);
+		EXPECT_EQ(bitvec_push(bv, bit), BITVEC_STATUS_OK);
+	}
+	EXPECT_EQ(bitvec_build_index(bv), BITVEC_STATUS_OK);
+
+	size_t rank = 0;
+	for (size_t i = 0; i < bv->count; i++) {
+		size_t found_rank;
+		EXPECT_EQ(bitvec_rank(bv, i, &found_rank), BITVEC_STATUS_OK);
+		EXPECT_EQ(found_rank, rank);
+
+		bool bit;
+		bitvec_get(bv, i, &bit);
+		if (bit) {
+			size_t found_index;
+			EXPECT_EQ(bitvec_select(bv, rank, &found_index), BITVEC_STATUS_OK);
+			EXPECT_EQ(found_index, i);
+			rank++;
+		}
+	}
+	EXPECT_EQ(rank, bitvec_popcount(bv));
+
+	EXPECT_EQ(bitvec_delete(bv), BITVEC_STATUS_OK);
+}
@@ -0,0 +1,210 @@
+/**
+ * @file blobvec.h
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Vector of variable-length elements in one arena.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <c-utils/vector.h>
+
+/**
+ * @enum blobvec_offsets
+ * Width of stored element offsets.
+ *
+ * @var blobvec_offsets::BLOBVEC_OFFSETS_32
+ * 32-bit offsets, arena holds up to 4 GiB.
+ *
+ * @var blobvec_offsets::BLOBVEC_OFFSETS_64
+ * 64-bit offsets.
+ */
+typedef enum {
+	BLOBVEC_OFFSETS_32 = 0,
+	BLOBVEC_OFFSETS_64 = 1,
+} blobvec_offsets;
+
+/**
+ * @struct blobvec
+ * Blob vector object. Fields should not be edited.
+ *
+ * Payloads are stored back to back in a single arena, an offsets array
+ * locates each one.
+ *
+ * @var blobvec::count
+ * Current element count.
+ *
+ * @internal
+ *
+ * @var blobvec::_bytes
+ * Arena of payload bytes.
+ * @var blobvec::_ends
+ * End offset of each element in the arena, uint32_t or uint64_t.
+ *
+ * @endinternal
+ */
+typedef struct {
+	size_t count;
+
+	vector _bytes;
+	vector _ends;
+} blobvec;
+
+/**
+ * @enum blobvec_status
+ * Result of blob vector operation.
+ *
+ * @var blobvec_status::BLOBVEC_STATUS_OK
+ * Operation completed successfully.
+ *
+ * @var blobvec_status::BLOBVEC_STATUS_NULL
+ * Blob vector argument is null.
+ *
+ * @var blobvec_status::BLOBVEC_STATUS_BOUNDS
+ * Operation was out of bounds.
+ *
+ * @var blobvec_status::BLOBVEC_STATUS_ALLOC
+ * Memory allocation failed.
+ *
+ * @var blobvec_status::BLOBVEC_STATUS_OVERFLOW
+ * Arena would grow past what offsets can address.
+ */
+typedef enum {
+	BLOBVEC_STATUS_OK = 0,
+	BLOBVEC_STATUS_NULL = 1,
+	BLOBVEC_STATUS_BOUNDS = 2,
+	BLOBVEC_STATUS_ALLOC = 3,
+	BLOBVEC_STATUS_OVERFLOW = 4,
+} blobvec_status;
+
+/**
+ * @brief Create blob vector object on the stack.
+ *
+ * @param[in] offsets - Offset width.
+ * @return Blob vector object.
+ * @note Delete with blobvec_deinit.
+ */
+blobvec blobvec_init(blobvec_offsets offsets);
+
+/**
+ * @brief Create blob vector object on the heap.
+ *
+ * @param[in] offsets - Offset width.
+ * @return Blob vector object, NULL if allocation failed.
+ * @note Delete with blobvec_delete.
+ */
+blobvec *blobvec_new(blobvec_offsets offsets);
+
+/**
+ * @brief Delete blob vector object from the stack.
+ *
+ * @param[in] bv - Blob vector object.
+ * @return Status code.
+ */
+blobvec_status blobvec_deinit(blobvec *bv);
+
+/**
+ * @brief Delete blob vector object from the heap.
+ *
+ * @param[in] bv - Blob vector object.
+ * @return Status code.
+ */
+blobvec_status blobvec_delete(blobvec *bv);
+
+/**
+ * @brief Reserve space for elements and payload bytes.
+ *
+ * @param[in,out] bv - Blob vector object.
+ * @param[in] count - Amount of elements to reserve.
+ * @param[in] bytes - Amount of payload bytes to reserve.
+ * @return Status code.
+ * @note Will only grow the object.
+ */
+blobvec_status blobvec_reserve(blobvec *bv, size_t count, size_t bytes);
+
+/**
+ * @brief Add element to the end.
+ *
+ * @param[in,out] bv - Blob vector object.
+ * @param[in] data - Payload, may be NULL if size is 0.
+ * @param[in] size - Payload size in bytes.
+ * @return Status code.
+ */
+blobvec_status blobvec_push(blobvec *bv, const void *data, size_t size);
+
+/**
+ * @brief Add multiple elements to the end.
+ *
+ * @param[in,out] bv - Blob vector object.
+ * @param[in] data - Payloads stored back to back.
+ * @param[in] sizes - Payload size of each element.
+ * @param[in] count - Count of elements to push.
+ * @return Status code.
+ * @note Payloads are copied with a single memcpy.
+ */
+blobvec_status blobvec_bulk_push(blobvec *bv,
+	const void *data,
+	const size_t *sizes,
+	size_t count);
+
+/**
+ * @brief Remove element at specified location, compacting the arena.
+ *
+ * @param[in,out] bv - Blob vector object.
+ * @param[in] index - Removal index.
+ * @return Status code.
+ */
+blobvec_status blobvec_erase(blobvec *bv, size_t index);
+
+/**
+ * @brief Keep only elements matching a predicate, compacting the arena.
+ *
+ * Kept payloads are moved in runs in a single pass and keep their order.
+ *
+ * @param[in,out] bv - Blob vector object.
+ * @param[in] pred - Called once per element in order, returns true to keep.
+ * @param[in] ctx - User context, passed to every call.
+ * @return Status code.
+ */
+blobvec_status blobvec_retain(blobvec *bv,
+	bool (*pred)(const void *data, size_t size, void *ctx),
+	void *ctx);
+
+/**
+ * @brief Access element at specified location (const).
+ *
+ * @param[in] bv - Blob vector object.
+ * @param[in] index - Access index.
+ * @param[out] size - If not NULL, payload size placed here.
+ * @return Pointer to payload in the arena (const), NULL if out of bounds.
+ * @note Pointer is invalidated by any modification of the object.
+ */
+const void *blobvec_at(const blobvec *bv, size_t index, size_t *size);
+
+/**
+ * @brief Access element at specified location (mutable).
+ *
+ * @param[in,out] bv - Blob vector object.
+ * @param[in] index - Access index.
+ * @param[out] size - If not NULL, payload size placed here.
+ * @return Pointer to payload in the arena (mutable), NULL if out of bounds.
+ * @note Pointer is invalidated by any modification of the object.
+ */
+void *blobvec_at_mut(blobvec *bv, size_t index, size_t *size);
+
+/**
+ * @brief Access the whole arena.
+ *
+ * Payloads are stored in element order without gaps, so a scan over every
+ * element reads contiguous memory.
+ *
+ * @param[in] bv - Blob vector object.
+ * @param[out] size - If not NULL, arena size in bytes placed here.
+ * @return Pointer to the first payload byte (const).
+ */
+const void *blobvec_arena(const blobvec *bv, size_t *size);
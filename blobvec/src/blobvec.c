@@ -0,0 +1,322 @@
+/**
+ * @file blobvec.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Vector of variable-length elements in one arena.
+ */
+#include "blobvec.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <c-utils/vector.h>
+
+// Arena pointer arithmetic
+#define arena_at(bv, offset) ((uint8_t *)(bv)->_bytes.data + (offset))
+
+// Address of empty payloads while the arena is not allocated
+static uint8_t empty_payload;
+
+static size_t get_end(const blobvec *bv, size_t index);
+static void set_end(blobvec *bv, size_t index, size_t end);
+static size_t max_bytes(const blobvec *bv);
+static uint8_t *payload_at(const blobvec *bv, size_t offset);
+static uint8_t *find_payload(const blobvec *bv, size_t index, size_t *size);
+
+blobvec blobvec_init(blobvec_offsets offsets) {
+	// clang-format off
+	size_t offset_size = (offsets == BLOBVEC_OFFSETS_32)
+		? sizeof(uint32_t)
+		: sizeof(uint64_t);
+	// clang-format on
+
+	blobvec bv = {
+		.count = 0,
+		._bytes = vec_init(sizeof(uint8_t)),
+		._ends = vec_init(offset_size),
+	};
+
+	return bv;
+}
+
+blobvec *blobvec_new(blobvec_offsets offsets) {
+	blobvec *bv = malloc(sizeof(blobvec));
+	if (bv == NULL) {
+		return NULL;
+	}
+
+	*bv = blobvec_init(offsets);
+	return bv;
+}
+
+blobvec_status blobvec_deinit(blobvec *bv) {
+	if (bv == NULL) {
+		return BLOBVEC_STATUS_NULL;
+	}
+
+	vec_deinit(&bv->_bytes);
+	vec_deinit(&bv->_ends);
+
+	return BLOBVEC_STATUS_OK;
+}
+
+blobvec_status blobvec_delete(blobvec *bv) {
+	if (blobvec_deinit(bv) == BLOBVEC_STATUS_NULL) {
+		return BLOBVEC_STATUS_NULL;
+	}
+
+	free(bv);
+	return BLOBVEC_STATUS_OK;
+}
+
+blobvec_status blobvec_reserve(blobvec *bv, size_t count, size_t bytes) {
+	if (bv == NULL) {
+		return BLOBVEC_STATUS_NULL;
+	}
+
+	if (bytes > max_bytes(bv)) {
+		return BLOBVEC_STATUS_OVERFLOW;
+	}
+
+	if (vec_reserve(&bv->_ends, count) != VECTOR_STATUS_OK
+		|| vec_reserve(&bv->_bytes, bytes) != VECTOR_STATUS_OK) {
+		return BLOBVEC_STATUS_ALLOC;
+	}
+
+	return BLOBVEC_STATUS_OK;
+}
+
+blobvec_status blobvec_push(blobvec *bv, const void *data, size_t size) {
+	if (bv == NULL) {
+		return BLOBVEC_STATUS_NULL;
+	}
+
+	return blobvec_bulk_push(bv, data, &size, 1);
+}
+
+blobvec_status blobvec_bulk_push(blobvec *bv,
+	const void *data,
+	const size_t *sizes,
+	size_t count) {
+	if (bv == NULL || sizes == NULL) {
+		return BLOBVEC_STATUS_NULL;
+	}
+
+	// Total payload, within what offsets can address
+	size_t used = bv->_bytes.count;
+	size_t limit = max_bytes(bv);
+	size_t total = 0;
+	for (size_t i = 0; i < count; i++) {
+		if (sizes[i] > limit - used - total) {
+			return BLOBVEC_STATUS_OVERFLOW;
+		}
+		total += sizes[i];
+	}
+
+	if (total > 0 && data == NULL) {
+		return BLOBVEC_STATUS_NULL;
+	}
+
+	// Both grow before anything is written, so failure changes nothing
+	if (vec_grow(&bv->_bytes, total) != VECTOR_STATUS_OK
+		|| vec_grow(&bv->_ends, count) != VECTOR_STATUS_OK) {
+		return BLOBVEC_STATUS_ALLOC;
+	}
+
+	if (total > 0) {
+		memcpy(arena_at(bv, used), data, total);
+	}
+
+	size_t end = used;
+	for (size_t i = 0; i < count; i++) {
+		end += sizes[i];
+		set_end(bv, bv->count + i, end);
+	}
+
+	bv->_bytes.count += total;
+	bv->_ends.count += count;
+	bv->count += count;
+	return BLOBVEC_STATUS_OK;
+}
+
+blobvec_status blobvec_erase(blobvec *bv, size_t index) {
+	if (bv == NULL) {
+		return BLOBVEC_STATUS_NULL;
+	}
+
+	if (index >= bv->count) {
+		return BLOBVEC_STATUS_BOUNDS;
+	}
+
+	size_t start = (index == 0) ? 0 : get_end(bv, index - 1);
+	size_t end = get_end(bv, index);
+	size_t size = end - start;
+
+	// Close the gap in the arena
+	if (size > 0) {
+		memmove(arena_at(bv, start), arena_at(bv, end),
+			bv->_bytes.count - end);
+		bv->_bytes.count -= size;
+	}
+
+	// Later elements move back by one slot and size bytes
+	for (size_t i = index + 1; i < bv->count; i++) {
+		set_end(bv, i - 1, get_end(bv, i) - size);
+	}
+
+	bv->_ends.count--;
+	bv->count--;
+	return BLOBVEC_STATUS_OK;
+}
+
+blobvec_status blobvec_retain(blobvec *bv,
+	bool (*pred)(const void *data, size_t size, void *ctx),
+	void *ctx) {
+	if (bv == NULL || pred == NULL) {
+		return BLOBVEC_STATUS_NULL;
+	}
+
+	size_t kept = 0;
+	size_t write = 0;
+	size_t start = 0;
+
+	// Pending run of kept payloads, moved once it ends
+	size_t run_from = 0;
+	size_t run_size = 0;
+
+	for (size_t i = 0; i < bv->count; i++) {
+		size_t end = get_end(bv, i);
+		if (pred(payload_at(bv, start), end - start, ctx)) {
+			if (run_size == 0) {
+				run_from = start;
+			}
+			run_size += end - start;
+			set_end(bv, kept, write + run_size);
+			kept++;
+		} else if (run_size > 0) {
+			if (run_from != write) {
+				memmove(arena_at(bv, write), arena_at(bv, run_from), run_size);
+			}
+			write += run_size;
+			run_size = 0;
+		}
+
+		start = end;
+	}
+
+	if (run_size > 0 && run_from != write) {
+		memmove(arena_at(bv, write), arena_at(bv, run_from), run_size);
+	}
+
+	bv->_bytes.count = write + run_size;
+	bv->_ends.count = kept;
+	bv->count = kept;
+	return BLOBVEC_STATUS_OK;
+}
+
+const void *blobvec_at(const blobvec *bv, size_t index, size_t *size) {
+	return find_payload(bv, index, size);
+}
+
+void *blobvec_at_mut(blobvec *bv, size_t index, size_t *size) {
+	return find_payload(bv, index, size);
+}
+
+const void *blobvec_arena(const blobvec *bv, size_t *size) {
+	if (bv == NULL) {
+		return NULL;
+	}
+
+	if (size != NULL) {
+		*size = bv->_bytes.count;
+	}
+
+	return bv->_bytes.data;
+}
+
+/**
+ * @brief Get end offset of an element.
+ *
+ * @param[in] bv - Blob vector object.
+ * @param[in] index - Element index.
+ * @return Offset one past the last payload byte.
+ */
+static size_t get_end(const blobvec *bv, size_t index) {
+	if (bv->_ends._type_size == sizeof(uint32_t)) {
+		return ((const uint32_t *)bv->_ends.data)[index];
+	}
+
+	return ((const uint64_t *)bv->_ends.data)[index];
+}
+
+/**
+ * @brief Set end offset of an element.
+ *
+ * @param[in,out] bv - Blob vector object.
+ * @param[in] index - Element index, within capacity.
+ * @param[in] end - Offset one past the last payload byte.
+ */
+static void set_end(blobvec *bv, size_t index, size_t end) {
+	if (bv->_ends._type_size == sizeof(uint32_t)) {
+		((uint32_t *)bv->_ends.data)[index] = (uint32_t)end;
+	} else {
+		((uint64_t *)bv->_ends.data)[index] = end;
+	}
+}
+
+/**
+ * @brief Get largest arena size offsets can address.
+ *
+ * @param[in] bv - Blob vector object.
+ * @return Size in bytes.
+ */
+static size_t max_bytes(const blobvec *bv) {
+	if (bv->_ends._type_size == sizeof(uint32_t) && SIZE_MAX > UINT32_MAX) {
+		return UINT32_MAX;
+	}
+
+	return SIZE_MAX;
+}
+
+/**
+ * @brief Get payload pointer for an arena offset.
+ *
+ * @param[in] bv - Blob vector object.
+ * @param[in] offset - Offset in the arena.
+ * @return Pointer into the arena, a static empty payload if the arena is not
+ * allocated.
+ */
+static uint8_t *payload_at(const blobvec *bv, size_t offset) {
+	// Only empty payloads so far, nothing allocated
+	if (bv->_bytes.data == NULL) {
+		return &empty_payload;
+	}
+
+	return arena_at(bv, offset);
+}
+
+/**
+ * @brief Find payload of an element.
+ *
+ * @param[in] bv - Blob vector object.
+ * @param[in] index - Access index.
+ * @param[out] size - If not NULL, payload size placed here.
+ * @return Pointer to payload, NULL if out of bounds.
+ */
+static uint8_t *find_payload(const blobvec *bv, size_t index, size_t *size) {
+	if (bv == NULL || index >= bv->count) {
+		return NULL;
+	}
+
+	size_t start = (index == 0) ? 0 : get_end(bv, index - 1);
+	if (size != NULL) {
+		*size = get_end(bv, index) - start;
+	}
+
+	return payload_at(bv, start);
+}
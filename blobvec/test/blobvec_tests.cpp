@@ -0,0 +1,247 @@
+extern "C" {
+#include <c-utils/vector.h>
+
+#include "../include/blobvec.h"
+}
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+static const char *string0 = "first";
+static const char *string1 = "";
+static const char *string2 = "third element";
+
+static std::string blob_string(const blobvec *bv, size_t index) {
+	size_t size;
+	const char *data = (const char *)blobvec_at(bv, index, &size);
+	return std::string(data, size);
+}
+
+static bool keep_short(const void *data, size_t size, void *ctx) {
+	(void)data;
+	return size <= *(size_t *)ctx;
+}
+
+static bool keep_valid(const void *data, size_t size, void *ctx) {
+	(void)size;
+	(void)ctx;
+	return data != nullptr;
+}
+
+TEST(Blobvec, BlobvecInitOk) {
+	blobvec bv = blobvec_init(BLOBVEC_OFFSETS_32);
+	blobvec wide_bv = blobvec_init(BLOBVEC_OFFSETS_64);
+
+	EXPECT_EQ(bv.count, 0);
+	EXPECT_EQ(bv._bytes._type_size, 1);
+	EXPECT_EQ(bv._ends._type_size, sizeof(uint32_t));
+	EXPECT_EQ(wide_bv._ends._type_size, sizeof(uint64_t));
+}
+
+TEST(Blobvec, BlobvecNewOk) {
+	blobvec *bv = blobvec_new(BLOBVEC_OFFSETS_64);
+
+	EXPECT_NE(bv, nullptr);
+	EXPECT_EQ(bv->count, 0);
+
+	EXPECT_EQ(blobvec_delete(bv), BLOBVEC_STATUS_OK);
+}
+
+TEST(Blobvec, BlobvecDeinitNull) {
+	EXPECT_EQ(blobvec_deinit(nullptr), BLOBVEC_STATUS_NULL);
+	EXPECT_EQ(blobvec_delete(nullptr), BLOBVEC_STATUS_NULL);
+}
+
+TEST(Blobvec, BlobvecReserveOk) {
+	blobvec bv = blobvec_init(BLOBVEC_OFFSETS_32);
+
+	EXPECT_EQ(blobvec_reserve(nullptr, 1, 1), BLOBVEC_STATUS_NULL);
+	EXPECT_EQ(blobvec_reserve(&bv, 10, 100), BLOBVEC_STATUS_OK);
+	EXPECT_GE(bv._ends._alloc_count, 10);
+	EXPECT_GE(bv._bytes._alloc_count, 100);
+
+	// Past 32-bit offsets
+	if (SIZE_MAX > UINT32_MAX) {
+		EXPECT_EQ(blobvec_reserve(&bv, 1, (size_t)UINT32_MAX + 1),
+			BLOBVEC_STATUS_OVERFLOW);
+	}
+
+	blobvec_deinit(&bv);
+}
+
+TEST(Blobvec, BlobvecPushNull) {
+	blobvec bv = blobvec_init(BLOBVEC_OFFSETS_32);
+
+	EXPECT_EQ(blobvec_push(nullptr, string0, 5), BLOBVEC_STATUS_NULL);
+	EXPECT_EQ(blobvec_push(&bv, nullptr, 5), BLOBVEC_STATUS_NULL);
+	EXPECT_EQ(bv.count, 0);
+}
+
+TEST(Blobvec, BlobvecPushOk) {
+	blobvec bv = blobvec_init(BLOBVEC_OFFSETS_32);
+
+	// Empty payload before anything is allocated
+	EXPECT_EQ(blobvec_push(&bv, nullptr, 0), BLOBVEC_STATUS_OK);
+	EXPECT_NE(blobvec_at(&bv, 0, nullptr), nullptr);
+
+	EXPECT_EQ(blobvec_push(&bv, string0, strlen(string0)), BLOBVEC_STATUS_OK);
+	EXPECT_EQ(blobvec_push(&bv, string1, strlen(string1)), BLOBVEC_STATUS_OK);
+	EXPECT_EQ(blobvec_push(&bv, string2, strlen(string2)), BLOBVEC_STATUS_OK);
+
+	EXPECT_EQ(bv.count, 4);
+	EXPECT_EQ(blob_string(&bv, 0), "");
+	EXPECT_EQ(blob_string(&bv, 1), string0);
+	EXPECT_EQ(blob_string(&bv, 2), string1);
+	EXPECT_EQ(blob_string(&bv, 3), string2);
+
+	// Payloads are contiguous
+	size_t arena_size;
+	const char *arena = (const char *)blobvec_arena(&bv, &arena_size);
+	EXPECT_EQ(std::string(arena, arena_size), "firstthird element");
+
+	blobvec_deinit(&bv);
+}
+
+TEST(Blobvec, BlobvecBulkPushOk) {
+	blobvec bv = blobvec_init(BLOBVEC_OFFSETS_64);
+	const char data[] = "abcdefghij";
+	size_t sizes[] = { 3, 0, 5, 2 };
+
+	EXPECT_EQ(blobvec_bulk_push(&bv, data, nullptr, 4), BLOBVEC_STATUS_NULL);
+	EXPECT_EQ(blobvec_bulk_push(&bv, data, sizes, 4), BLOBVEC_STATUS_OK);
+	EXPECT_EQ(blobvec_bulk_push(&bv, data, sizes, 1), BLOBVEC_STATUS_OK);
+
+	EXPECT_EQ(bv.count, 5);
+	EXPECT_EQ(blob_string(&bv, 0), "abc");
+	EXPECT_EQ(blob_string(&bv, 1), "");
+	EXPECT_EQ(blob_string(&bv, 2), "defgh");
+	EXPECT_EQ(blob_string(&bv, 3), "ij");
+	EXPECT_EQ(blob_string(&bv, 4), "abc");
+
+	blobvec_deinit(&bv);
+}
+
+TEST(Blobvec, BlobvecEraseNull) {
+	EXPECT_EQ(blobvec_erase(nullptr, 0), BLOBVEC_STATUS_NULL);
+}
+
+TEST(Blobvec, BlobvecEraseBounds) {
+	blobvec bv = blobvec_init(BLOBVEC_OFFSETS_32);
+
+	EXPECT_EQ(blobvec_erase(&bv, 0), BLOBVEC_STATUS_BOUNDS);
+	blobvec_push(&bv, string0, strlen(string0));
+	EXPECT_EQ(blobvec_erase(&bv, 1), BLOBVEC_STATUS_BOUNDS);
+
+	blobvec_deinit(&bv);
+}
+
+TEST(Blobvec, BlobvecEraseOk) {
+	blobvec bv = blobvec_init(BLOBVEC_OFFSETS_32);
+	blobvec_push(&bv, string0, strlen(string0));
+	blobvec_push(&bv, string1, strlen(string1));
+	blobvec_push(&bv, string2, strlen(string2));
+
+	EXPECT_EQ(blobvec_erase(&bv, 1), BLOBVEC_STATUS_OK);
+	EXPECT_EQ(blobvec_erase(&bv, 0), BLOBVEC_STATUS_OK);
+	EXPECT_EQ(bv.count, 1);
+	EXPECT_EQ(bv._bytes.count, strlen(string2));
+	EXPECT_EQ(blob_string(&bv, 0), string2);
+
+	EXPECT_EQ(blobvec_erase(&bv, 0), BLOBVEC_STATUS_OK);
+	EXPECT_EQ(bv.count, 0);
+	EXPECT_EQ(bv._bytes.count, 0);
+
+	blobvec_deinit(&bv);
+}
+
+TEST(Blobvec, BlobvecRetainOk) {
+	blobvec bv = blobvec_init(BLOBVEC_OFFSETS_32);
+	size_t limit = 5;
+
+	EXPECT_EQ(blobvec_retain(nullptr, keep_short, &limit), BLOBVEC_STATUS_NULL);
+	EXPECT_EQ(blobvec_retain(&bv, nullptr, &limit), BLOBVEC_STATUS_NULL);
+
+	// Strings of 0..9 characters, twice
+	std::string letters = "0123456789";
+	for (int round = 0; round < 2; round++) {
+		for (size_t i = 0; i < 10; i++) {
+			blobvec_push(&bv, letters.data(), i);
+		}
+	}
+
+	EXPECT_EQ(blobvec_retain(&bv, keep_short, &limit), BLOBVEC_STATUS_OK);
+	EXPECT_EQ(bv.count, 12);
+	EXPECT_EQ(bv._bytes.count, 30);
+	for (size_t i = 0; i < 12; i++) {
+		EXPECT_EQ(blob_string(&bv, i), letters.substr(0, i % 6));
+	}
+
+	blobvec_deinit(&bv);
+}
+
+TEST(Blobvec, BlobvecRetainEmpty) {
+	blobvec bv = blobvec_init(BLOBVEC_OFFSETS_32);
+
+	// Nothing allocated for the arena, predicate still gets a pointer
+	for (int i = 0; i < 3; i++) {
+		blobvec_push(&bv, nullptr, 0);
+	}
+	EXPECT_EQ(bv._bytes.data, nullptr);
+
+	EXPECT_EQ(blobvec_retain(&bv, keep_valid, nullptr), BLOBVEC_STATUS_OK);
+	EXPECT_EQ(bv.count, 3);
+
+	blobvec_deinit(&bv);
+}
+
+TEST(Blobvec, BlobvecAtNull) {
+	blobvec bv = blobvec_init(BLOBVEC_OFFSETS_32);
+
+	EXPECT_EQ(blobvec_at(nullptr, 0, nullptr), nullptr);
+	EXPECT_EQ(blobvec_at(&bv, 0, nullptr), nullptr);
+	EXPECT_EQ(blobvec_arena(nullptr, nullptr), nullptr);
+}
+
+TEST(Blobvec, BlobvecAtMutOk) {
+	blobvec bv = blobvec_init(BLOBVEC_OFFSETS_32);
+	blobvec_push(&bv, string0, strlen(string0));
+
+	size_t size;
+	char *data = (char *)blobvec_at_mut(&bv, 0, &size);
+	EXPECT_EQ(size, strlen(string0));
+	data[0] = 'F';
+	EXPECT_EQ(blob_string(&bv, 0), "First");
+
+	blobvec_deinit(&bv);
+}
+
+TEST(Blobvec, FullTest) {
+	blobvec bv = blobvec_init(BLOBVEC_OFFSETS_32);
+	std::vector<std::string> expected;
+
+	for (int i = 0; i < 10000; i++) {
+		std::string value = std::to_string(i * 7919);
+		EXPECT_EQ(blobvec_push(&bv, value.data(), value.size()),
+			BLOBVEC_STATUS_OK);
+		expected.push_back(value);
+	}
+
+	// Erase every third element from the back
+	for (size_t i = expected.size(); i > 0; i--) {
+		if ((i - 1) % 3 == 0) {
+			EXPECT_EQ(blobvec_erase(&bv, i - 1), BLOBVEC_STATUS_OK);
+			expected.erase(expected.begin() + (i - 1));
+		}
+	}
+
+	EXPECT_EQ(bv.count, expected.size());
+	for (size_t i = 0; i < expected.size(); i++) {
+		EXPECT_EQ(blob_string(&bv, i), expected[i]);
+	}
+
+	EXPECT_EQ(blobvec_deinit(&bv), BLOBVEC_STATUS_OK);
+}
@@ -0,0 +1,179 @@
+/**
+ * @file concvec.h
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Concurrent append-only vector.
+ */
+#pragma once
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <c-utils/vector.h>
+
+/**
+ * @def CONCVEC_BASE_SHIFT
+ * First chunk holds 2^CONCVEC_BASE_SHIFT elements, each next chunk doubles.
+ */
+#define CONCVEC_BASE_SHIFT 6
+
+/**
+ * @def CONCVEC_MAX_CHUNKS
+ * Size of the chunk directory, enough to address any size_t index.
+ */
+#define CONCVEC_MAX_CHUNKS (sizeof(size_t) * CHAR_BIT - CONCVEC_BASE_SHIFT)
+
+/**
+ * @struct concvec
+ * Concurrent append-only vector object. Fields should not be edited.
+ *
+ * @internal
+ *
+ * @var concvec::_reserved
+ * Amount of slots handed out to writers.
+ * @var concvec::_watermark
+ * Length of the published prefix, as last seen by a reader.
+ * @var concvec::_failed
+ * Amount of slots whose push failed, they are never published.
+ * @var concvec::_chunks
+ * Chunk directory, chunk k holds 2^(CONCVEC_BASE_SHIFT + k) elements
+ * followed by one publish flag per element.
+ * @var concvec::_type_size
+ * Size of contained type.
+ *
+ * @endinternal
+ */
+typedef struct {
+	size_t _reserved;
+	size_t _watermark;
+	size_t _failed;
+	void *_chunks[CONCVEC_MAX_CHUNKS];
+	size_t _type_size;
+} concvec;
+
+/**
+ * @enum concvec_status
+ * Result of concurrent vector operation.
+ *
+ * @var concvec_status::CONCVEC_STATUS_OK
+ * Operation completed successfully.
+ *
+ * @var concvec_status::CONCVEC_STATUS_NULL
+ * Concurrent vector argument is null.
+ *
+ * @var concvec_status::CONCVEC_STATUS_ALLOC
+ * Memory allocation failed.
+ *
+ * @var concvec_status::CONCVEC_STATUS_BUSY
+ * Some reserved slots are not published yet.
+ */
+typedef enum {
+	CONCVEC_STATUS_OK = 0,
+	CONCVEC_STATUS_NULL = 1,
+	CONCVEC_STATUS_ALLOC = 2,
+	CONCVEC_STATUS_BUSY = 3,
+} concvec_status;
+
+/**
+ * @brief Create concurrent vector object on the stack.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @return Concurrent vector object.
+ * @note Delete with concvec_deinit.
+ */
+concvec concvec_init(size_t type_size);
+
+/**
+ * @brief Create concurrent vector object on the heap.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @return Concurrent vector object.
+ * @note Delete with concvec_delete.
+ */
+concvec *concvec_new(size_t type_size);
+
+/**
+ * @brief Delete concurrent vector object from the stack.
+ *
+ * @param[in] cv - Concurrent vector object.
+ * @return Status code.
+ * @note Not thread-safe, all readers and writers must be done.
+ */
+concvec_status concvec_deinit(concvec *cv);
+
+/**
+ * @brief Delete concurrent vector object from the heap.
+ *
+ * @param[in] cv - Concurrent vector object.
+ * @return Status code.
+ * @note Not thread-safe, all readers and writers must be done.
+ */
+concvec_status concvec_delete(concvec *cv);
+
+/**
+ * @brief Allocate chunks for elements ahead of time.
+ *
+ * @param[in,out] cv - Concurrent vector object.
+ * @param[in] count - Amount of elements to reserve.
+ * @return Status code.
+ * @note Thread-safe.
+ */
+concvec_status concvec_reserve(concvec *cv, size_t count);
+
+/**
+ * @brief Add element to the end.
+ *
+ * The slot is claimed with a single atomic increment, the element is copied
+ * and then published to readers.
+ *
+ * @param[in,out] cv - Concurrent vector object.
+ * @param[in] value - New element.
+ * @param[out] index - If not NULL, index of the new element placed here.
+ * @return Status code.
+ * @note Thread-safe and lock-free, except for the first push into a chunk
+ * which allocates it. Elements are never moved.
+ * @note If a chunk cannot be allocated, the claimed slot is never published
+ * and the watermark stops before it. concvec_to_vector skips such slots.
+ * Use concvec_reserve to rule this out.
+ */
+concvec_status concvec_push(concvec *cv, const void *value, size_t *index);
+
+/**
+ * @brief Get length of the published prefix.
+ *
+ * Every element below the watermark is published and may be read with
+ * concvec_at. The watermark only increases.
+ *
+ * @param[in,out] cv - Concurrent vector object.
+ * @return Watermark, 0 if cv is NULL.
+ * @note Thread-safe.
+ */
+size_t concvec_watermark(concvec *cv);
+
+/**
+ * @brief Access published element at specified location.
+ *
+ * @param[in] cv - Concurrent vector object.
+ * @param[in] index - Access index.
+ * @return Pointer to element (const), NULL if not published or index is
+ * beyond any chunk.
+ * @note Thread-safe, the pointer stays valid until the object is deleted.
+ */
+const void *concvec_at(const concvec *cv, size_t index);
+
+/**
+ * @brief Move elements into a regular vector, resetting the object.
+ *
+ * @param[in,out] cv - Concurrent vector object.
+ * @param[out] vec - Vector object, created by this function.
+ * @return Status code, CONCVEC_STATUS_BUSY if a reserved slot is not
+ * published and its push did not fail.
+ * @note Slots of failed pushes are left out, so elements after them move to
+ * lower indices.
+ * @note Not thread-safe, all writers must be done.
+ * @note Delete vec with vec_deinit.
+ */
+concvec_status concvec_to_vector(concvec *cv, vector *vec);
@@ -0,0 +1,301 @@
+/**
+ * @file concvec.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Concurrent append-only vector.
+ */
+#include "concvec.h"
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <c-utils/vector.h>
+
+// Elements in the first chunk
+#define BASE ((size_t)1 << CONCVEC_BASE_SHIFT)
+
+// Elements in chunk k
+#define chunk_size(k) (BASE << (k))
+
+// Elements in chunks 0 through k - 1
+#define chunks_capacity(k) (BASE * (((size_t)1 << (k)) - 1))
+
+// Publish flags follow the elements of a chunk
+#define chunk_flags(cv, chunk, k)                                              \
+	((unsigned char *)(chunk) + (cv)->_type_size * chunk_size(k))
+
+static void *get_chunk(concvec *cv, size_t k);
+static size_t locate(size_t index, size_t *offset);
+static void copy_chunks(const concvec *cv, void *out, size_t count);
+static void copy_published(const concvec *cv, void *out, size_t count);
+
+concvec concvec_init(size_t type_size) {
+	concvec cv = {
+		._reserved = 0,
+		._watermark = 0,
+		._failed = 0,
+		._chunks = { NULL },
+		._type_size = type_size,
+	};
+
+	return cv;
+}
+
+concvec *concvec_new(size_t type_size) {
+	concvec *cv = malloc(sizeof(concvec));
+	if (cv == NULL) {
+		return NULL;
+	}
+
+	*cv = concvec_init(type_size);
+	return cv;
+}
+
+concvec_status concvec_deinit(concvec *cv) {
+	if (cv == NULL) {
+		return CONCVEC_STATUS_NULL;
+	}
+
+	for (size_t k = 0; k < CONCVEC_MAX_CHUNKS; k++) {
+		free(cv->_chunks[k]);
+		cv->_chunks[k] = NULL;
+	}
+
+	cv->_reserved = 0;
+	cv->_watermark = 0;
+	cv->_failed = 0;
+	return CONCVEC_STATUS_OK;
+}
+
+concvec_status concvec_delete(concvec *cv) {
+	if (concvec_deinit(cv) == CONCVEC_STATUS_NULL) {
+		return CONCVEC_STATUS_NULL;
+	}
+
+	free(cv);
+	return CONCVEC_STATUS_OK;
+}
+
+concvec_status concvec_reserve(concvec *cv, size_t count) {
+	if (cv == NULL) {
+		return CONCVEC_STATUS_NULL;
+	}
+
+	for (size_t k = 0;
+		 k < CONCVEC_MAX_CHUNKS && chunks_capacity(k) < count; k++) {
+		if (get_chunk(cv, k) == NULL) {
+			return CONCVEC_STATUS_ALLOC;
+		}
+	}
+
+	return CONCVEC_STATUS_OK;
+}
+
+concvec_status concvec_push(concvec *cv, const void *value, size_t *index) {
+	if (cv == NULL) {
+		return CONCVEC_STATUS_NULL;
+	}
+
+	// Claim a slot, the only point where writers meet
+	size_t slot = __atomic_fetch_add(&cv->_reserved, 1, __ATOMIC_RELAXED);
+
+	size_t offset;
+	size_t k = locate(slot, &offset);
+	void *chunk = get_chunk(cv, k);
+	if (chunk == NULL) {
+		// Slot stays unpublished, let concvec_to_vector skip it
+		__atomic_fetch_add(&cv->_failed, 1, __ATOMIC_RELEASE);
+		return CONCVEC_STATUS_ALLOC;
+	}
+
+	// Copy element, then publish it
+	memcpy((unsigned char *)chunk + cv->_type_size * offset, value,
+		cv->_type_size);
+	__atomic_store_n(&chunk_flags(cv, chunk, k)[offset], 1, __ATOMIC_RELEASE);
+
+	if (index != NULL) {
+		*index = slot;
+	}
+
+	return CONCVEC_STATUS_OK;
+}
+
+size_t concvec_watermark(concvec *cv) {
+	if (cv == NULL) {
+		return 0;
+	}
+
+	size_t seen = __atomic_load_n(&cv->_watermark, __ATOMIC_ACQUIRE);
+	size_t reserved = __atomic_load_n(&cv->_reserved, __ATOMIC_RELAXED);
+
+	// Extend over published slots
+	size_t mark = seen;
+	while (mark < reserved && concvec_at(cv, mark) != NULL) {
+		mark++;
+	}
+
+	// Share progress with other readers, keeping the largest value
+	while (seen < mark
+		&& !__atomic_compare_exchange_n(&cv->_watermark, &seen, mark, true,
+			__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+	}
+
+	return (seen > mark) ? seen : mark;
+}
+
+const void *concvec_at(const concvec *cv, size_t index) {
+	// Biased index would wrap around
+	if (cv == NULL || index > SIZE_MAX - BASE) {
+		return NULL;
+	}
+
+	size_t offset;
+	size_t k = locate(index, &offset);
+	if (k >= CONCVEC_MAX_CHUNKS) {
+		return NULL;
+	}
+
+	void *chunk = __atomic_load_n(&cv->_chunks[k], __ATOMIC_ACQUIRE);
+	if (chunk == NULL
+		|| !__atomic_load_n(&chunk_flags(cv, chunk, k)[offset],
+			__ATOMIC_ACQUIRE)) {
+		return NULL;
+	}
+
+	return (unsigned char *)chunk + cv->_type_size * offset;
+}
+
+concvec_status concvec_to_vector(concvec *cv, vector *vec) {
+	if (cv == NULL || vec == NULL) {
+		return CONCVEC_STATUS_NULL;
+	}
+
+	size_t count = cv->_reserved;
+	size_t failed = __atomic_load_n(&cv->_failed, __ATOMIC_ACQUIRE);
+	size_t published = concvec_watermark(cv);
+	if (published != count) {
+		// Count the rest, only failed pushes may be missing
+		for (size_t i = published; i < count; i++) {
+			published += (concvec_at(cv, i) != NULL);
+		}
+
+		if (count - published != failed) {
+			return CONCVEC_STATUS_BUSY;
+		}
+	}
+
+	*vec = vec_init(cv->_type_size);
+	if (vec_reserve(vec, published) != VECTOR_STATUS_OK) {
+		return CONCVEC_STATUS_ALLOC;
+	}
+
+	if (published == count) {
+		copy_chunks(cv, vec->data, count);
+	} else {
+		copy_published(cv, vec->data, count);
+	}
+
+	vec->count = published;
+	concvec_deinit(cv);
+	return CONCVEC_STATUS_OK;
+}
+
+/**
+ * @brief Get chunk, allocating it if needed.
+ *
+ * Racing writers may each allocate the chunk, the first to install it wins
+ * and the others free theirs.
+ *
+ * @param[in,out] cv - Concurrent vector object.
+ * @param[in] k - Chunk index.
+ * @return Chunk, NULL if allocation failed.
+ */
+static void *get_chunk(concvec *cv, size_t k) {
+	void *chunk = __atomic_load_n(&cv->_chunks[k], __ATOMIC_ACQUIRE);
+	if (chunk != NULL) {
+		return chunk;
+	}
+
+	size_t count = chunk_size(k);
+	if (count > SIZE_MAX / (cv->_type_size + 1)) {
+		return NULL;
+	}
+
+	// Zeroed, so every slot starts unpublished
+	void *created = calloc(count, cv->_type_size + 1);
+	if (created == NULL) {
+		return NULL;
+	}
+
+	if (!__atomic_compare_exchange_n(&cv->_chunks[k], &chunk, created, false,
+			__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+		free(created);
+		return chunk;
+	}
+
+	return created;
+}
+
+/**
+ * @brief Copy elements when every slot is published.
+ *
+ * Whole chunks are contiguous, so each is a single copy.
+ *
+ * @param[in] cv - Concurrent vector object.
+ * @param[out] out - Storage for count elements.
+ * @param[in] count - Amount of slots.
+ */
+static void copy_chunks(const concvec *cv, void *out, size_t count) {
+	size_t copied = 0;
+	for (size_t k = 0; copied < count; k++) {
+		size_t chunk_count = chunk_size(k);
+		if (chunk_count > count - copied) {
+			chunk_count = count - copied;
+		}
+
+		memcpy((unsigned char *)out + cv->_type_size * copied, cv->_chunks[k],
+			cv->_type_size * chunk_count);
+		copied += chunk_count;
+	}
+}
+
+/**
+ * @brief Copy published elements, skipping slots of failed pushes.
+ *
+ * @param[in] cv - Concurrent vector object.
+ * @param[out] out - Storage for the published elements.
+ * @param[in] count - Amount of slots.
+ */
+static void copy_published(const concvec *cv, void *out, size_t count) {
+	unsigned char *dst = out;
+	for (size_t i = 0; i < count; i++) {
+		const void *elem = concvec_at(cv, i);
+		if (elem != NULL) {
+			memcpy(dst, elem, cv->_type_size);
+			dst += cv->_type_size;
+		}
+	}
+}
+
+/**
+ * @brief Find chunk and offset of an element.
+ *
+ * Biasing the index by the first chunk size makes the position of its
+ * highest set bit select the chunk, and the remaining bits the offset.
+ *
+ * @param[in] index - Element index.
+ * @param[out] offset - Element offset in the chunk.
+ * @return Chunk index.
+ */
+static size_t locate(size_t index, size_t *offset) {
+	unsigned long long biased = (unsigned long long)index + BASE;
+	size_t top_bit = sizeof(biased) * CHAR_BIT - 1 - __builtin_clzll(biased);
+
+	*offset = biased - ((unsigned long long)1 << top_bit);
+	return top_bit - CONCVEC_BASE_SHIFT;
+}
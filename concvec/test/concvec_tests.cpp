@@ -0,0 +1,267 @@
+extern "C" {
+#include <c-utils/vector.h>
+
+#include "../include/concvec.h"
+}
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+static int int_element0 = 123;
+static int int_element1 = 456;
+static int int_element2 = 789;
+
+TEST(Concvec, ConcvecInitOk) {
+	concvec cv = concvec_init(sizeof(int));
+
+	EXPECT_EQ(cv._reserved, 0);
+	EXPECT_EQ(cv._watermark, 0);
+	EXPECT_EQ(cv._failed, 0);
+	EXPECT_EQ(cv._chunks[0], nullptr);
+	EXPECT_EQ(cv._type_size, sizeof(int));
+}
+
+TEST(Concvec, ConcvecNewOk) {
+	concvec *cv = concvec_new(sizeof(int));
+
+	EXPECT_NE(cv, nullptr);
+	EXPECT_EQ(cv->_reserved, 0);
+	EXPECT_EQ(cv->_type_size, sizeof(int));
+
+	EXPECT_EQ(concvec_delete(cv), CONCVEC_STATUS_OK);
+}
+
+TEST(Concvec, ConcvecDeinitNull) {
+	EXPECT_EQ(concvec_deinit(nullptr), CONCVEC_STATUS_NULL);
+	EXPECT_EQ(concvec_delete(nullptr), CONCVEC_STATUS_NULL);
+}
+
+TEST(Concvec, ConcvecReserveOk) {
+	concvec cv = concvec_init(sizeof(int));
+
+	EXPECT_EQ(concvec_reserve(nullptr, 10), CONCVEC_STATUS_NULL);
+
+	// First two chunks hold 64 + 128 elements
+	EXPECT_EQ(concvec_reserve(&cv, 100), CONCVEC_STATUS_OK);
+	EXPECT_NE(cv._chunks[0], nullptr);
+	EXPECT_NE(cv._chunks[1], nullptr);
+	EXPECT_EQ(cv._chunks[2], nullptr);
+	EXPECT_EQ(cv._reserved, 0);
+
+	concvec_deinit(&cv);
+}
+
+TEST(Concvec, ConcvecPushNull) {
+	EXPECT_EQ(concvec_push(nullptr, &int_element0, nullptr),
+		CONCVEC_STATUS_NULL);
+}
+
+TEST(Concvec, ConcvecPushOk) {
+	concvec cv = concvec_init(sizeof(int));
+
+	size_t index;
+	EXPECT_EQ(concvec_push(&cv, &int_element0, &index), CONCVEC_STATUS_OK);
+	EXPECT_EQ(index, 0);
+	EXPECT_EQ(concvec_push(&cv, &int_element1, &index), CONCVEC_STATUS_OK);
+	EXPECT_EQ(index, 1);
+	EXPECT_EQ(concvec_push(&cv, &int_element2, nullptr), CONCVEC_STATUS_OK);
+
+	EXPECT_EQ(*(int *)concvec_at(&cv, 0), int_element0);
+	EXPECT_EQ(*(int *)concvec_at(&cv, 1), int_element1);
+	EXPECT_EQ(*(int *)concvec_at(&cv, 2), int_element2);
+	EXPECT_EQ(concvec_at(&cv, 3), nullptr);
+
+	// Across chunks, addresses stay the same
+	const void *first = concvec_at(&cv, 0);
+	for (int i = 3; i < 1000; i++) {
+		EXPECT_EQ(concvec_push(&cv, &i, nullptr), CONCVEC_STATUS_OK);
+	}
+	EXPECT_EQ(concvec_at(&cv, 0), first);
+	EXPECT_EQ(*(int *)concvec_at(&cv, 999), 999);
+
+	concvec_deinit(&cv);
+}
+
+TEST(Concvec, ConcvecAtNull) {
+	EXPECT_EQ(concvec_at(nullptr, 0), nullptr);
+	EXPECT_EQ(concvec_watermark(nullptr), 0);
+}
+
+TEST(Concvec, ConcvecAtBounds) {
+	concvec cv = concvec_init(sizeof(int));
+
+	concvec_push(&cv, &int_element0, nullptr);
+	EXPECT_EQ(concvec_at(&cv, 1), nullptr);
+	EXPECT_EQ(concvec_at(&cv, SIZE_MAX), nullptr);
+	EXPECT_EQ(concvec_at(&cv, SIZE_MAX - 64), nullptr);
+
+	concvec_deinit(&cv);
+}
+
+TEST(Concvec, ConcvecWatermarkOk) {
+	concvec cv = concvec_init(sizeof(int));
+
+	EXPECT_EQ(concvec_watermark(&cv), 0);
+	concvec_push(&cv, &int_element0, nullptr);
+	concvec_push(&cv, &int_element1, nullptr);
+	EXPECT_EQ(concvec_watermark(&cv), 2);
+
+	// Claimed by a writer, not published yet
+	cv._reserved++;
+	concvec_push(&cv, &int_element2, nullptr);
+	EXPECT_EQ(concvec_at(&cv, 2), nullptr);
+	EXPECT_EQ(*(int *)concvec_at(&cv, 3), int_element2);
+	EXPECT_EQ(concvec_watermark(&cv), 2);
+
+	// Publishing the gap exposes the rest
+	int *slot = (int *)cv._chunks[0] + 2;
+	*slot = int_element0;
+	((unsigned char *)cv._chunks[0] + sizeof(int) * 64)[2] = 1;
+	EXPECT_EQ(concvec_watermark(&cv), 4);
+
+	concvec_deinit(&cv);
+}
+
+TEST(Concvec, ConcvecToVectorNull) {
+	concvec cv = concvec_init(sizeof(int));
+	vector vec;
+
+	EXPECT_EQ(concvec_to_vector(nullptr, &vec), CONCVEC_STATUS_NULL);
+	EXPECT_EQ(concvec_to_vector(&cv, nullptr), CONCVEC_STATUS_NULL);
+}
+
+TEST(Concvec, ConcvecToVectorBusy) {
+	concvec cv = concvec_init(sizeof(int));
+	vector vec;
+
+	concvec_push(&cv, &int_element0, nullptr);
+	cv._reserved++;
+
+	EXPECT_EQ(concvec_to_vector(&cv, &vec), CONCVEC_STATUS_BUSY);
+	EXPECT_EQ(*(int *)concvec_at(&cv, 0), int_element0);
+
+	concvec_deinit(&cv);
+}
+
+TEST(Concvec, ConcvecPushAlloc) {
+	// Chunk size overflows, so no chunk can be allocated
+	concvec cv = concvec_init(SIZE_MAX / 2);
+	size_t index = 0;
+
+	EXPECT_EQ(concvec_push(&cv, &int_element0, &index), CONCVEC_STATUS_ALLOC);
+	EXPECT_EQ(cv._reserved, 1);
+	EXPECT_EQ(cv._failed, 1);
+	EXPECT_EQ(concvec_watermark(&cv), 0);
+
+	concvec_deinit(&cv);
+}
+
+TEST(Concvec, ConcvecToVectorFailed) {
+	concvec cv = concvec_init(sizeof(int));
+	vector vec;
+
+	// Slot 1 claimed by a push that failed
+	concvec_push(&cv, &int_element0, nullptr);
+	cv._reserved++;
+	cv._failed++;
+	concvec_push(&cv, &int_element1, nullptr);
+	concvec_push(&cv, &int_element2, nullptr);
+	EXPECT_EQ(concvec_watermark(&cv), 1);
+
+	EXPECT_EQ(concvec_to_vector(&cv, &vec), CONCVEC_STATUS_OK);
+	EXPECT_EQ(vec.count, 3);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element0);
+	EXPECT_EQ(*(int *)vec_at(&vec, 1), int_element1);
+	EXPECT_EQ(*(int *)vec_at(&vec, 2), int_element2);
+	EXPECT_EQ(cv._reserved, 0);
+
+	vec_deinit(&vec);
+}
+
+TEST(Concvec, ConcvecToVectorOk) {
+	concvec cv = concvec_init(sizeof(int));
+	vector vec;
+
+	for (int i = 0; i < 500; i++) {
+		concvec_push(&cv, &i, nullptr);
+	}
+
+	EXPECT_EQ(concvec_to_vector(&cv, &vec), CONCVEC_STATUS_OK);
+	EXPECT_EQ(vec.count, 500);
+	for (int i = 0; i < 500; i++) {
+		EXPECT_EQ(*(int *)vec_at(&vec, i), i);
+	}
+
+	// Object is reset and reusable
+	EXPECT_EQ(cv._reserved, 0);
+	EXPECT_EQ(cv._chunks[0], nullptr);
+	EXPECT_EQ(concvec_push(&cv, &int_element0, nullptr), CONCVEC_STATUS_OK);
+
+	vec_deinit(&vec);
+	concvec_deinit(&cv);
+}
+
+TEST(Concvec, FullTest) {
+	const int thread_count = 8;
+	const uint64_t per_thread = 20000;
+	concvec cv = concvec_init(sizeof(uint64_t));
+
+	// Reader checks the published prefix while writers run
+	std::atomic<bool> done(false);
+	std::atomic<bool> reader_ok(true);
+	std::thread reader([&]() {
+		size_t last = 0;
+		while (!done.load()) {
+			size_t mark = concvec_watermark(&cv);
+			if (mark < last) {
+				reader_ok = false;
+			}
+			for (size_t i = last; i < mark; i++) {
+				const uint64_t *value = (const uint64_t *)concvec_at(&cv, i);
+				if (value == nullptr || *value == 0) {
+					reader_ok = false;
+				}
+			}
+			last = mark;
+		}
+	});
+
+	std::vector<std::thread> writers;
+	for (int t = 0; t < thread_count; t++) {
+		writers.emplace_back([&cv, t, per_thread]() {
+			for (uint64_t i = 0; i < per_thread; i++) {
+				uint64_t value = ((uint64_t)(t + 1) << 32) | i;
+				concvec_push(&cv, &value, nullptr);
+			}
+		});
+	}
+
+	for (std::thread &writer : writers) {
+		writer.join();
+	}
+	done = true;
+	reader.join();
+	EXPECT_TRUE(reader_ok.load());
+
+	vector vec;
+	EXPECT_EQ(concvec_to_vector(&cv, &vec), CONCVEC_STATUS_OK);
+	EXPECT_EQ(vec.count, thread_count * per_thread);
+
+	// Every value exactly once, each writer's values in order
+	std::vector<uint64_t> values((uint64_t *)vec.data,
+		(uint64_t *)vec.data + vec.count);
+	std::vector<uint64_t> next(thread_count, 0);
+	for (uint64_t value : values) {
+		int t = (int)(value >> 32) - 1;
+		EXPECT_EQ(value & 0xffffffff, next[t]);
+		next[t]++;
+	}
+
+	vec_deinit(&vec);
+	concvec_deinit(&cv);
+}
@@ -0,0 +1,182 @@
+/**
+ * @file deque.h
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Double-ended queue on a ring buffer.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @struct deque
+ * Deque object. Fields should not be edited.
+ *
+ * @var deque::count
+ * Current element count.
+ *
+ * @internal
+ *
+ * @var deque::_data
+ * Raw ring buffer.
+ * @var deque::_type_size
+ * Size of contained type.
+ * @var deque::_alloc_count
+ * How many elements can fit in data.
+ * @var deque::_head
+ * Slot of the first element.
+ *
+ * @endinternal
+ */
+typedef struct {
+	size_t count;
+
+	void *_data;
+	size_t _type_size;
+	size_t _alloc_count;
+	size_t _head;
+} deque;
+
+/**
+ * @enum deque_status
+ * Result of deque operation.
+ *
+ * @var deque_status::DEQUE_STATUS_OK
+ * Operation completed successfully.
+ *
+ * @var deque_status::DEQUE_STATUS_NULL
+ * Deque argument is null.
+ *
+ * @var deque_status::DEQUE_STATUS_EMPTY
+ * Not enough elements in the deque.
+ *
+ * @var deque_status::DEQUE_STATUS_ALLOC
+ * Memory allocation failed.
+ */
+typedef enum {
+	DEQUE_STATUS_OK = 0,
+	DEQUE_STATUS_NULL = 1,
+	DEQUE_STATUS_EMPTY = 2,
+	DEQUE_STATUS_ALLOC = 3,
+} deque_status;
+
+/**
+ * @brief Create deque object on the stack.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @return Deque object.
+ * @note Delete with deque_deinit.
+ */
+deque deque_init(size_t type_size);
+
+/**
+ * @brief Create deque object on the heap.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @return Deque object.
+ * @note Delete with deque_delete.
+ */
+deque *deque_new(size_t type_size);
+
+/**
+ * @brief Delete deque object from the stack.
+ *
+ * @param[in] dq - Deque object.
+ * @return Status code.
+ */
+deque_status deque_deinit(deque *dq);
+
+/**
+ * @brief Delete deque object from the heap.
+ *
+ * @param[in] dq - Deque object.
+ * @return Status code.
+ */
+deque_status deque_delete(deque *dq);
+
+/**
+ * @brief Reserve space for elements.
+ *
+ * @param[in,out] dq - Deque object.
+ * @param[in] count - Amount of elements to reserve.
+ * @return Status code, DEQUE_STATUS_ALLOC for a zero type size.
+ * @note Will only grow the object.
+ */
+deque_status deque_reserve(deque *dq, size_t count);
+
+/**
+ * @brief Add element to the back.
+ *
+ * @param[in,out] dq - Deque object.
+ * @param[in] value - New element.
+ * @return Status code.
+ */
+deque_status deque_push_back(deque *dq, const void *value);
+
+/**
+ * @brief Add element to the front.
+ *
+ * @param[in,out] dq - Deque object.
+ * @param[in] value - New element.
+ * @return Status code.
+ */
+deque_status deque_push_front(deque *dq, const void *value);
+
+/**
+ * @brief Remove element from the back.
+ *
+ * @param[in,out] dq - Deque object.
+ * @param[out] buffer - If not NULL, removed element is copied here.
+ * @return Status code.
+ */
+deque_status deque_pop_back(deque *dq, void *buffer);
+
+/**
+ * @brief Remove element from the front.
+ *
+ * @param[in,out] dq - Deque object.
+ * @param[out] buffer - If not NULL, removed element is copied here.
+ * @return Status code.
+ */
+deque_status deque_pop_front(deque *dq, void *buffer);
+
+/**
+ * @brief Add multiple elements to the back.
+ *
+ * @param[in,out] dq - Deque object.
+ * @param[in] items - Array of new elements.
+ * @param[in] count - Count of elements to push.
+ * @return Status code.
+ */
+deque_status deque_bulk_push_back(deque *dq, const void *items, size_t count);
+
+/**
+ * @brief Remove multiple elements from the front.
+ *
+ * @param[in,out] dq - Deque object.
+ * @param[out] buffer - If not NULL, removed elements placed here (as array).
+ * @param[in] count - Count of elements to remove.
+ * @return Status code.
+ */
+deque_status deque_bulk_pop_front(deque *dq, void *buffer, size_t count);
+
+/**
+ * @brief Access element at specified location (const).
+ *
+ * @param[in] dq - Deque object.
+ * @param[in] index - Access index, 0 is the front.
+ * @return Pointer to element (const).
+ */
+const void *deque_at(const deque *dq, size_t index);
+
+/**
+ * @brief Access element at specified location (mutable).
+ *
+ * @param[in] dq - Deque object.
+ * @param[in] index - Access index, 0 is the front.
+ * @return Pointer to element (mutable).
+ */
+void *deque_at_mut(const deque *dq, size_t index);
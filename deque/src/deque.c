@@ -0,0 +1,265 @@
+/**
+ * @file deque.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Double-ended queue on a ring buffer.
+ */
+#include "deque.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Growth factor
+#define FACTOR 2
+
+// Pointer arithmetic for slots
+#define ptr_at(dq, slot) (dq->_data + dq->_type_size * (slot))
+
+static size_t slot_of(const deque *dq, size_t index);
+static deque_status grow(deque *dq, size_t more_count);
+
+deque deque_init(size_t type_size) {
+	deque dq = {
+		.count = 0,
+		._data = NULL,
+		._type_size = type_size,
+		._alloc_count = 0,
+		._head = 0,
+	};
+
+	return dq;
+}
+
+deque *deque_new(size_t type_size) {
+	deque *dq = malloc(sizeof(deque));
+	if (dq == NULL) {
+		return NULL;
+	}
+
+	*dq = deque_init(type_size);
+	return dq;
+}
+
+deque_status deque_deinit(deque *dq) {
+	if (dq == NULL) {
+		return DEQUE_STATUS_NULL;
+	}
+
+	if (dq->_data != NULL) {
+		free(dq->_data);
+	}
+
+	return DEQUE_STATUS_OK;
+}
+
+deque_status deque_delete(deque *dq) {
+	if (deque_deinit(dq) == DEQUE_STATUS_NULL) {
+		return DEQUE_STATUS_NULL;
+	}
+
+	free(dq);
+	return DEQUE_STATUS_OK;
+}
+
+deque_status deque_reserve(deque *dq, size_t count) {
+	if (dq == NULL) {
+		return DEQUE_STATUS_NULL;
+	}
+
+	if (count <= dq->_alloc_count) {
+		return DEQUE_STATUS_OK;
+	}
+
+	// Capacity math divides by the type size
+	if (dq->_type_size == 0) {
+		return DEQUE_STATUS_ALLOC;
+	}
+
+	if (count > SIZE_MAX / dq->_type_size) {
+		return DEQUE_STATUS_ALLOC;
+	}
+
+	void *data = malloc(dq->_type_size * count);
+	if (data == NULL) {
+		return DEQUE_STATUS_ALLOC;
+	}
+
+	// Linearize elements into the new buffer
+	size_t element_count = dq->count;
+	if (element_count > 0) {
+		deque_bulk_pop_front(dq, data, element_count);
+	}
+
+	free(dq->_data);
+	dq->_data = data;
+	dq->_alloc_count = count;
+	dq->_head = 0;
+	dq->count = element_count;
+
+	return DEQUE_STATUS_OK;
+}
+
+deque_status deque_push_back(deque *dq, const void *value) {
+	return deque_bulk_push_back(dq, value, 1);
+}
+
+deque_status deque_push_front(deque *dq, const void *value) {
+	if (dq == NULL) {
+		return DEQUE_STATUS_NULL;
+	}
+
+	deque_status status = grow(dq, 1);
+	if (status != DEQUE_STATUS_OK) {
+		return status;
+	}
+
+	// Step head back, wrapping around
+	dq->_head = (dq->_head == 0) ? dq->_alloc_count - 1 : dq->_head - 1;
+	memcpy(ptr_at(dq, dq->_head), value, dq->_type_size);
+	dq->count++;
+
+	return DEQUE_STATUS_OK;
+}
+
+deque_status deque_pop_back(deque *dq, void *buffer) {
+	if (dq == NULL) {
+		return DEQUE_STATUS_NULL;
+	}
+
+	if (dq->count == 0) {
+		return DEQUE_STATUS_EMPTY;
+	}
+
+	// Copy element if needed
+	if (buffer != NULL) {
+		memcpy(buffer, ptr_at(dq, slot_of(dq, dq->count - 1)),
+			dq->_type_size);
+	}
+
+	dq->count--;
+	return DEQUE_STATUS_OK;
+}
+
+deque_status deque_pop_front(deque *dq, void *buffer) {
+	return deque_bulk_pop_front(dq, buffer, 1);
+}
+
+deque_status deque_bulk_push_back(deque *dq, const void *items, size_t count) {
+	if (dq == NULL) {
+		return DEQUE_STATUS_NULL;
+	}
+
+	if (count == 0) {
+		return DEQUE_STATUS_OK;
+	}
+
+	deque_status status = grow(dq, count);
+	if (status != DEQUE_STATUS_OK) {
+		return status;
+	}
+
+	// Copy up to the end of the buffer, then wrap around
+	size_t tail = slot_of(dq, dq->count);
+	size_t first_count = dq->_alloc_count - tail;
+	if (first_count > count) {
+		first_count = count;
+	}
+
+	memcpy(ptr_at(dq, tail), items, dq->_type_size * first_count);
+	memcpy(ptr_at(dq, 0), (const char *)items + dq->_type_size * first_count,
+		dq->_type_size * (count - first_count));
+	dq->count += count;
+
+	return DEQUE_STATUS_OK;
+}
+
+deque_status deque_bulk_pop_front(deque *dq, void *buffer, size_t count) {
+	if (dq == NULL) {
+		return DEQUE_STATUS_NULL;
+	}
+
+	if (count > dq->count) {
+		return DEQUE_STATUS_EMPTY;
+	}
+
+	if (count == 0) {
+		return DEQUE_STATUS_OK;
+	}
+
+	// Copy up to the end of the buffer, then wrap around
+	size_t first_count = dq->_alloc_count - dq->_head;
+	if (first_count > count) {
+		first_count = count;
+	}
+
+	if (buffer != NULL) {
+		memcpy(buffer, ptr_at(dq, dq->_head), dq->_type_size * first_count);
+		memcpy((char *)buffer + dq->_type_size * first_count, ptr_at(dq, 0),
+			dq->_type_size * (count - first_count));
+	}
+
+	dq->_head = slot_of(dq, count);
+	dq->count -= count;
+	if (dq->count == 0) {
+		dq->_head = 0;
+	}
+
+	return DEQUE_STATUS_OK;
+}
+
+const void *deque_at(const deque *dq, size_t index) {
+	return deque_at_mut(dq, index);
+}
+
+void *deque_at_mut(const deque *dq, size_t index) {
+	if (dq == NULL || index >= dq->count) {
+		return NULL;
+	}
+
+	return ptr_at(dq, slot_of(dq, index));
+}
+
+/**
+ * @brief Find ring buffer slot of an element.
+ *
+ * @param[in] dq - Deque object.
+ * @param[in] index - Element index, up to allocation count.
+ * @return Slot index.
+ */
+static size_t slot_of(const deque *dq, size_t index) {
+	size_t slot = dq->_head + index;
+	if (slot >= dq->_alloc_count) {
+		slot -= dq->_alloc_count;
+	}
+
+	return slot;
+}
+
+/**
+ * @brief Grow storage to fit more elements, using the growth factor.
+ *
+ * @param[in,out] dq - Deque object.
+ * @param[in] more_count - How many more elements should fit.
+ * @return Status code.
+ */
+static deque_status grow(deque *dq, size_t more_count) {
+	if (more_count > SIZE_MAX - dq->count) {
+		return DEQUE_STATUS_ALLOC;
+	}
+
+	size_t new_count = dq->_alloc_count;
+	while (dq->count + more_count > new_count) {
+		if (new_count > SIZE_MAX / FACTOR) {
+			new_count = dq->count + more_count;
+			break;
+		}
+
+		new_count = (new_count == 0) ? FACTOR : new_count * FACTOR;
+	}
+
+	return deque_reserve(dq, new_count);
+}
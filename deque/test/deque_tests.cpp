@@ -0,0 +1,233 @@
+extern "C" {
+#include "../include/deque.h"
+}
+
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+static char element0 = '0';
+static char element1 = '1';
+static char element2 = '2';
+
+static int int_elements[] = { 10, 11, 12, 13, 14, 15 };
+
+TEST(Deque, DequeInitOk) {
+	deque dq = deque_init(sizeof(char));
+
+	EXPECT_EQ(dq.count, 0);
+	EXPECT_EQ(dq._data, nullptr);
+}
+
+TEST(Deque, DequeNewOk) {
+	deque *dq = deque_new(sizeof(char));
+
+	EXPECT_NE(dq, nullptr);
+	EXPECT_EQ(dq->count, 0);
+	EXPECT_EQ(dq->_data, nullptr);
+
+	free(dq);
+}
+
+TEST(Deque, DequeDeinitNullArg) {
+	deque *dq = nullptr;
+
+	EXPECT_EQ(deque_deinit(dq), DEQUE_STATUS_NULL);
+}
+
+TEST(Deque, DequeDeleteNullArg) {
+	deque *dq = nullptr;
+
+	EXPECT_EQ(deque_delete(dq), DEQUE_STATUS_NULL);
+}
+
+TEST(Deque, DequeReserveNull) {
+	deque *dq = nullptr;
+
+	EXPECT_EQ(deque_reserve(dq, 10), DEQUE_STATUS_NULL);
+}
+
+TEST(Deque, DequeReserveOk) {
+	deque dq = deque_init(sizeof(char));
+
+	// Wrap elements around the end of the buffer
+	EXPECT_EQ(deque_reserve(&dq, 4), DEQUE_STATUS_OK);
+	deque_push_back(&dq, &element1);
+	deque_push_back(&dq, &element2);
+	deque_push_front(&dq, &element0);
+	EXPECT_EQ(dq._head, 3);
+
+	// Elements are linearized
+	EXPECT_EQ(deque_reserve(&dq, 8), DEQUE_STATUS_OK);
+	EXPECT_GE(dq._alloc_count, 8);
+	EXPECT_EQ(dq._head, 0);
+	EXPECT_EQ(dq.count, 3);
+	EXPECT_EQ(*(char *)deque_at(&dq, 0), element0);
+	EXPECT_EQ(*(char *)deque_at(&dq, 1), element1);
+	EXPECT_EQ(*(char *)deque_at(&dq, 2), element2);
+
+	deque_deinit(&dq);
+}
+
+TEST(Deque, DequeReserveZeroSize) {
+	deque dq = deque_init(0);
+
+	EXPECT_EQ(deque_reserve(&dq, 8), DEQUE_STATUS_ALLOC);
+	EXPECT_EQ(deque_push_back(&dq, &element0), DEQUE_STATUS_ALLOC);
+	EXPECT_EQ(dq.count, 0);
+
+	deque_deinit(&dq);
+}
+
+TEST(Deque, DequePushNull) {
+	deque *dq = nullptr;
+
+	EXPECT_EQ(deque_push_back(dq, nullptr), DEQUE_STATUS_NULL);
+	EXPECT_EQ(deque_push_front(dq, nullptr), DEQUE_STATUS_NULL);
+}
+
+TEST(Deque, DequePushOk) {
+	deque dq = deque_init(sizeof(char));
+
+	EXPECT_EQ(deque_push_back(&dq, &element1), DEQUE_STATUS_OK);
+	EXPECT_EQ(deque_push_front(&dq, &element0), DEQUE_STATUS_OK);
+	EXPECT_EQ(deque_push_back(&dq, &element2), DEQUE_STATUS_OK);
+	EXPECT_EQ(dq.count, 3);
+
+	EXPECT_EQ(*(char *)deque_at(&dq, 0), element0);
+	EXPECT_EQ(*(char *)deque_at(&dq, 1), element1);
+	EXPECT_EQ(*(char *)deque_at(&dq, 2), element2);
+
+	deque_deinit(&dq);
+}
+
+TEST(Deque, DequePopNull) {
+	deque *dq = nullptr;
+
+	EXPECT_EQ(deque_pop_back(dq, nullptr), DEQUE_STATUS_NULL);
+	EXPECT_EQ(deque_pop_front(dq, nullptr), DEQUE_STATUS_NULL);
+}
+
+TEST(Deque, DequePopEmpty) {
+	deque dq = deque_init(sizeof(char));
+
+	EXPECT_EQ(deque_pop_back(&dq, nullptr), DEQUE_STATUS_EMPTY);
+	EXPECT_EQ(deque_pop_front(&dq, nullptr), DEQUE_STATUS_EMPTY);
+}
+
+TEST(Deque, DequePopOk) {
+	deque dq = deque_init(sizeof(char));
+	deque_push_back(&dq, &element0);
+	deque_push_back(&dq, &element1);
+	deque_push_back(&dq, &element2);
+
+	char buffer = 123;
+	EXPECT_EQ(deque_pop_front(&dq, &buffer), DEQUE_STATUS_OK);
+	EXPECT_EQ(buffer, element0);
+	EXPECT_EQ(deque_pop_back(&dq, &buffer), DEQUE_STATUS_OK);
+	EXPECT_EQ(buffer, element2);
+	EXPECT_EQ(dq.count, 1);
+	EXPECT_EQ(*(char *)deque_at(&dq, 0), element1);
+
+	deque_deinit(&dq);
+}
+
+TEST(Deque, DequeBulkPushNull) {
+	deque *dq = nullptr;
+
+	EXPECT_EQ(deque_bulk_push_back(dq, nullptr, 1), DEQUE_STATUS_NULL);
+}
+
+TEST(Deque, DequeBulkPushWrap) {
+	deque dq = deque_init(sizeof(int));
+	deque_reserve(&dq, 8);
+
+	// Move head towards the end of the buffer
+	deque_bulk_push_back(&dq, int_elements, 6);
+	EXPECT_EQ(deque_bulk_pop_front(&dq, nullptr, 5), DEQUE_STATUS_OK);
+
+	// Wraps around without growing
+	EXPECT_EQ(deque_bulk_push_back(&dq, int_elements, 6), DEQUE_STATUS_OK);
+	EXPECT_EQ(dq._alloc_count, 8);
+	EXPECT_EQ(dq.count, 7);
+	EXPECT_EQ(*(int *)deque_at(&dq, 0), int_elements[5]);
+	for (int i = 0; i < 6; i++) {
+		EXPECT_EQ(*(int *)deque_at(&dq, i + 1), int_elements[i]);
+	}
+
+	deque_deinit(&dq);
+}
+
+TEST(Deque, DequeBulkPopNull) {
+	deque *dq = nullptr;
+
+	EXPECT_EQ(deque_bulk_pop_front(dq, nullptr, 1), DEQUE_STATUS_NULL);
+}
+
+TEST(Deque, DequeBulkPopEmpty) {
+	deque dq = deque_init(sizeof(int));
+	deque_bulk_push_back(&dq, int_elements, 2);
+
+	EXPECT_EQ(deque_bulk_pop_front(&dq, nullptr, 3), DEQUE_STATUS_EMPTY);
+	EXPECT_EQ(dq.count, 2);
+
+	deque_deinit(&dq);
+}
+
+TEST(Deque, DequeBulkPopWrap) {
+	deque dq = deque_init(sizeof(int));
+	deque_reserve(&dq, 8);
+
+	deque_bulk_push_back(&dq, int_elements, 6);
+	deque_bulk_pop_front(&dq, nullptr, 4);
+	deque_bulk_push_back(&dq, int_elements, 6);
+
+	// Wraps around the end of the buffer
+	int buffer[8];
+	EXPECT_EQ(deque_bulk_pop_front(&dq, buffer, 8), DEQUE_STATUS_OK);
+	EXPECT_EQ(buffer[0], int_elements[4]);
+	EXPECT_EQ(buffer[1], int_elements[5]);
+	for (int i = 0; i < 6; i++) {
+		EXPECT_EQ(buffer[i + 2], int_elements[i]);
+	}
+	EXPECT_EQ(dq.count, 0);
+
+	deque_deinit(&dq);
+}
+
+TEST(Deque, DequeAtNull) {
+	deque *dq = nullptr;
+
+	EXPECT_EQ(deque_at(dq, 0), nullptr);
+}
+
+TEST(Deque, DequeAtBounds) {
+	deque dq = deque_init(sizeof(char));
+	deque_push_back(&dq, &element0);
+
+	EXPECT_EQ(deque_at(&dq, 1), nullptr);
+	EXPECT_EQ(deque_at(&dq, 2), nullptr);
+
+	deque_deinit(&dq);
+}
+
+TEST(Deque, FullTest) {
+	deque *dq = deque_new(sizeof(int));
+
+	// Use as a FIFO with a growing backlog
+	int next_out = 0;
+	for (int i = 0; i < 1000; i++) {
+		EXPECT_EQ(deque_push_back(dq, &i), DEQUE_STATUS_OK);
+		if (i % 3 == 0) {
+			int buffer;
+			EXPECT_EQ(deque_pop_front(dq, &buffer), DEQUE_STATUS_OK);
+			EXPECT_EQ(buffer, next_out++);
+		}
+	}
+
+	EXPECT_EQ(dq->count, 1000 - next_out);
+	for (size_t i = 0; i < dq->count; i++) {
+		EXPECT_EQ(*(int *)deque_at(dq, i), next_out + (int)i);
+	}
+
+	EXPECT_EQ(deque_delete(dq), DEQUE_STATUS_OK);
+}
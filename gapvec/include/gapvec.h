@@ -0,0 +1,173 @@
+/**
+ * @file gapvec.h
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Gap buffer vector.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <c-utils/vector.h>
+
+/**
+ * @struct gapvec
+ * Gap vector object. Fields should not be edited.
+ *
+ * @var gapvec::count
+ * Current element count.
+ *
+ * @internal
+ *
+ * @var gapvec::_data
+ * Raw data array, elements are split around the gap.
+ * @var gapvec::_type_size
+ * Size of contained type.
+ * @var gapvec::_alloc_count
+ * How many elements can fit in data, including the gap.
+ * @var gapvec::_gap_start
+ * Index of the first gap slot.
+ * @var gapvec::_gap_end
+ * Index of the first slot after the gap.
+ *
+ * @endinternal
+ */
+typedef struct {
+	size_t count;
+
+	void *_data;
+	size_t _type_size;
+	size_t _alloc_count;
+	size_t _gap_start;
+	size_t _gap_end;
+} gapvec;
+
+/**
+ * @enum gapvec_status
+ * Result of gap vector operation.
+ *
+ * @var gapvec_status::GAPVEC_STATUS_OK
+ * Operation completed successfully.
+ *
+ * @var gapvec_status::GAPVEC_STATUS_NULL
+ * Gap vector argument is null.
+ *
+ * @var gapvec_status::GAPVEC_STATUS_BOUNDS
+ * Operation was out of bounds.
+ *
+ * @var gapvec_status::GAPVEC_STATUS_ALLOC
+ * Memory allocation failed.
+ */
+typedef enum {
+	GAPVEC_STATUS_OK = 0,
+	GAPVEC_STATUS_NULL = 1,
+	GAPVEC_STATUS_BOUNDS = 2,
+	GAPVEC_STATUS_ALLOC = 3,
+} gapvec_status;
+
+/**
+ * @brief Create gap vector object on the stack.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @return Gap vector object.
+ * @note Delete with gapvec_deinit.
+ */
+gapvec gapvec_init(size_t type_size);
+
+/**
+ * @brief Create gap vector object on the heap.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @return Gap vector object.
+ * @note Delete with gapvec_delete.
+ */
+gapvec *gapvec_new(size_t type_size);
+
+/**
+ * @brief Delete gap vector object from the stack.
+ *
+ * @param[in] gv - Gap vector object.
+ * @return Status code.
+ */
+gapvec_status gapvec_deinit(gapvec *gv);
+
+/**
+ * @brief Delete gap vector object from the heap.
+ *
+ * @param[in] gv - Gap vector object.
+ * @return Status code.
+ */
+gapvec_status gapvec_delete(gapvec *gv);
+
+/**
+ * @brief Reserve space for elements.
+ *
+ * @param[in,out] gv - Gap vector object.
+ * @param[in] count - Amount of elements to reserve.
+ * @return Status code, GAPVEC_STATUS_BOUNDS for a zero type size.
+ * @note Will only grow the object.
+ */
+gapvec_status gapvec_reserve(gapvec *gv, size_t count);
+
+/**
+ * @brief Add element to the end.
+ *
+ * @param[in,out] gv - Gap vector object.
+ * @param[in] value - New element.
+ * @return Status code.
+ */
+gapvec_status gapvec_push(gapvec *gv, const void *value);
+
+/**
+ * @brief Add element at specified location.
+ *
+ * @param[in,out] gv - Gap vector object.
+ * @param[in] index - Insert index.
+ * @param[in] value - New element.
+ * @return Status code.
+ * @note Moves the gap to index, cost is proportional to the distance.
+ */
+gapvec_status gapvec_insert(gapvec *gv, size_t index, const void *value);
+
+/**
+ * @brief Remove element at specified location.
+ *
+ * @param[in,out] gv - Gap vector object.
+ * @param[in] index - Removal index.
+ * @param[out] buffer - If not NULL, erased value placed here.
+ * @return Status code.
+ * @note Moves the gap to index, cost is proportional to the distance.
+ */
+gapvec_status gapvec_erase(gapvec *gv, size_t index, void *buffer);
+
+/**
+ * @brief Access element at specified location (const).
+ *
+ * @param[in] gv - Gap vector object.
+ * @param[in] index - Access index.
+ * @return Pointer to element (const).
+ * @note Pointer is invalidated by any modification.
+ */
+const void *gapvec_at(const gapvec *gv, size_t index);
+
+/**
+ * @brief Access element at specified location (mutable).
+ *
+ * @param[in] gv - Gap vector object.
+ * @param[in] index - Access index.
+ * @return Pointer to element (mutable).
+ * @note Pointer is invalidated by any modification.
+ */
+void *gapvec_at_mut(const gapvec *gv, size_t index);
+
+/**
+ * @brief Convert to a contiguous vector, resetting the gap vector.
+ *
+ * @param[in,out] gv - Gap vector object.
+ * @return Vector containing all elements in order.
+ * @note The storage is handed over to the vector without copying.
+ */
+vector gapvec_flatten(gapvec *gv);
@@ -0,0 +1,236 @@
+/**
+ * @file gapvec.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Gap buffer vector.
+ */
+#include "gapvec.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <c-utils/vector.h>
+
+// Growth factor
+#define FACTOR 2
+
+// Pointer arithmetic for storage slots
+#define slot_at(gv, slot) (gv->_data + gv->_type_size * (slot))
+
+// Gap length in slots
+#define gap_size(gv) (gv->_gap_end - gv->_gap_start)
+
+// Storage slot of an element
+#define slot_of(gv, index)                                                     \
+	((index) < gv->_gap_start ? (index) : (index) + gap_size(gv))
+
+static void move_gap(gapvec *gv, size_t index);
+
+gapvec gapvec_init(size_t type_size) {
+	gapvec gv = {
+		.count = 0,
+		._data = NULL,
+		._type_size = type_size,
+		._alloc_count = 0,
+		._gap_start = 0,
+		._gap_end = 0,
+	};
+
+	return gv;
+}
+
+gapvec *gapvec_new(size_t type_size) {
+	gapvec *gv = malloc(sizeof(gapvec));
+	if (gv == NULL) {
+		return NULL;
+	}
+
+	*gv = gapvec_init(type_size);
+	return gv;
+}
+
+gapvec_status gapvec_deinit(gapvec *gv) {
+	if (gv == NULL) {
+		return GAPVEC_STATUS_NULL;
+	}
+
+	if (gv->_data != NULL) {
+		free(gv->_data);
+	}
+
+	return GAPVEC_STATUS_OK;
+}
+
+gapvec_status gapvec_delete(gapvec *gv) {
+	if (gapvec_deinit(gv) == GAPVEC_STATUS_NULL) {
+		return GAPVEC_STATUS_NULL;
+	}
+
+	free(gv);
+	return GAPVEC_STATUS_OK;
+}
+
+gapvec_status gapvec_reserve(gapvec *gv, size_t count) {
+	if (gv == NULL) {
+		return GAPVEC_STATUS_NULL;
+	}
+
+	if (count <= gv->_alloc_count) {
+		return GAPVEC_STATUS_OK;
+	}
+
+	// Capacity math divides by the type size
+	if (gv->_type_size == 0) {
+		return GAPVEC_STATUS_BOUNDS;
+	}
+
+	if (count > SIZE_MAX / gv->_type_size) {
+		return GAPVEC_STATUS_ALLOC;
+	}
+
+	void *data = realloc(gv->_data, gv->_type_size * count);
+	if (data == NULL) {
+		return GAPVEC_STATUS_ALLOC;
+	}
+
+	// Keep elements after the gap at the end
+	size_t tail_count = gv->_alloc_count - gv->_gap_end;
+	size_t new_gap_end = count - tail_count;
+
+	gv->_data = data;
+	memmove(slot_at(gv, new_gap_end), slot_at(gv, gv->_gap_end),
+		gv->_type_size * tail_count);
+
+	gv->_gap_end = new_gap_end;
+	gv->_alloc_count = count;
+
+	return GAPVEC_STATUS_OK;
+}
+
+gapvec_status gapvec_push(gapvec *gv, const void *value) {
+	if (gv == NULL) {
+		return GAPVEC_STATUS_NULL;
+	}
+
+	return gapvec_insert(gv, gv->count, value);
+}
+
+gapvec_status gapvec_insert(gapvec *gv, size_t index, const void *value) {
+	if (gv == NULL) {
+		return GAPVEC_STATUS_NULL;
+	}
+
+	// Up to last index + 1
+	if (index > gv->count) {
+		return GAPVEC_STATUS_BOUNDS;
+	}
+
+	// New to grow storage
+	if (gap_size(gv) == 0) {
+		if (gv->_alloc_count > SIZE_MAX / FACTOR) {
+			return GAPVEC_STATUS_ALLOC;
+		}
+
+		// clang-format off
+		size_t new_count = (gv->_data == NULL)
+			? FACTOR
+			: gv->_alloc_count * FACTOR;
+		// clang-format on
+		gapvec_status status = gapvec_reserve(gv, new_count);
+		if (status != GAPVEC_STATUS_OK) {
+			return status;
+		}
+	}
+
+	// Place element at the start of the gap
+	move_gap(gv, index);
+	memcpy(slot_at(gv, gv->_gap_start), value, gv->_type_size);
+	gv->_gap_start++;
+	gv->count++;
+
+	return GAPVEC_STATUS_OK;
+}
+
+gapvec_status gapvec_erase(gapvec *gv, size_t index, void *buffer) {
+	if (gv == NULL) {
+		return GAPVEC_STATUS_NULL;
+	}
+
+	if (index >= gv->count) {
+		return GAPVEC_STATUS_BOUNDS;
+	}
+
+	// Element is right after the gap
+	move_gap(gv, index);
+	if (buffer != NULL) {
+		memcpy(buffer, slot_at(gv, gv->_gap_end), gv->_type_size);
+	}
+
+	gv->_gap_end++;
+	gv->count--;
+
+	return GAPVEC_STATUS_OK;
+}
+
+const void *gapvec_at(const gapvec *gv, size_t index) {
+	return gapvec_at_mut(gv, index);
+}
+
+void *gapvec_at_mut(const gapvec *gv, size_t index) {
+	if (gv == NULL || index >= gv->count) {
+		return NULL;
+	}
+
+	return slot_at(gv, slot_of(gv, index));
+}
+
+vector gapvec_flatten(gapvec *gv) {
+	if (gv == NULL) {
+		return vec_init(0);
+	}
+
+	vector vec = vec_init(gv->_type_size);
+	if (gv->_data == NULL) {
+		return vec;
+	}
+
+	// Close the gap, then hand over storage
+	move_gap(gv, gv->count);
+	vec.data = gv->_data;
+	vec.count = gv->count;
+	vec._alloc_count = gv->_alloc_count;
+	vec_stats_adopt(&vec);
+
+	*gv = gapvec_init(gv->_type_size);
+	return vec;
+}
+
+/**
+ * @brief Move the gap so that it starts at an element index.
+ *
+ * @param[in,out] gv - Gap vector object.
+ * @param[in] index - New gap start, up to count.
+ */
+static void move_gap(gapvec *gv, size_t index) {
+	if (index < gv->_gap_start) {
+		// Shift elements before the gap to its end
+		size_t move_count = gv->_gap_start - index;
+		memmove(slot_at(gv, gv->_gap_end - move_count), slot_at(gv, index),
+			gv->_type_size * move_count);
+
+		gv->_gap_start -= move_count;
+		gv->_gap_end -= move_count;
+	} else if (index > gv->_gap_start) {
+		// Shift elements after the gap to its start
+		size_t move_count = index - gv->_gap_start;
+		memmove(slot_at(gv, gv->_gap_start), slot_at(gv, gv->_gap_end),
+			gv->_type_size * move_count);
+
+		gv->_gap_start += move_count;
+		gv->_gap_end += move_count;
+	}
+}
@@ -0,0 +1,283 @@
+extern "C" {
+#include <c-utils/vector.h>
+
+#include "../include/gapvec.h"
+}
+
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+static char element0 = '0';
+static char element1 = '1';
+static char element2 = '2';
+
+static int int_element0 = 123;
+static int int_element1 = 456;
+static int int_element2 = 789;
+
+TEST(Gapvec, GapvecInitOk) {
+	gapvec gv = gapvec_init(sizeof(char));
+
+	EXPECT_EQ(gv.count, 0);
+	EXPECT_EQ(gv._data, nullptr);
+}
+
+TEST(Gapvec, GapvecNewOk) {
+	gapvec *gv = gapvec_new(sizeof(char));
+
+	EXPECT_NE(gv, nullptr);
+	EXPECT_EQ(gv->count, 0);
+	EXPECT_EQ(gv->_data, nullptr);
+
+	free(gv);
+}
+
+TEST(Gapvec, GapvecDeinitNullArg) {
+	gapvec *gv = nullptr;
+
+	EXPECT_EQ(gapvec_deinit(gv), GAPVEC_STATUS_NULL);
+}
+
+TEST(Gapvec, GapvecDeleteNullArg) {
+	gapvec *gv = nullptr;
+
+	EXPECT_EQ(gapvec_delete(gv), GAPVEC_STATUS_NULL);
+}
+
+TEST(Gapvec, GapvecDeleteOk) {
+	gapvec *gv = gapvec_new(sizeof(char));
+	gapvec_push(gv, &element0);
+
+	EXPECT_EQ(gapvec_delete(gv), GAPVEC_STATUS_OK);
+}
+
+TEST(Gapvec, GapvecReserveNull) {
+	gapvec *gv = nullptr;
+
+	EXPECT_EQ(gapvec_reserve(gv, 10), GAPVEC_STATUS_NULL);
+}
+
+TEST(Gapvec, GapvecReserveOk) {
+	gapvec gv = gapvec_init(sizeof(char));
+
+	gapvec_push(&gv, &element0);
+	gapvec_push(&gv, &element1);
+	gapvec_insert(&gv, 0, &element2);
+
+	// Elements keep their order
+	EXPECT_EQ(gapvec_reserve(&gv, 16), GAPVEC_STATUS_OK);
+	EXPECT_GE(gv._alloc_count, 16);
+	EXPECT_EQ(*(char *)gapvec_at(&gv, 0), element2);
+	EXPECT_EQ(*(char *)gapvec_at(&gv, 1), element0);
+	EXPECT_EQ(*(char *)gapvec_at(&gv, 2), element1);
+
+	gapvec_deinit(&gv);
+}
+
+TEST(Gapvec, GapvecReserveZeroSize) {
+	gapvec gv = gapvec_init(0);
+
+	EXPECT_EQ(gapvec_reserve(&gv, 8), GAPVEC_STATUS_BOUNDS);
+	EXPECT_EQ(gapvec_push(&gv, &element0), GAPVEC_STATUS_BOUNDS);
+	EXPECT_EQ(gv._data, nullptr);
+
+	gapvec_deinit(&gv);
+}
+
+TEST(Gapvec, GapvecPushNull) {
+	gapvec *gv = nullptr;
+
+	EXPECT_EQ(gapvec_push(gv, nullptr), GAPVEC_STATUS_NULL);
+}
+
+TEST(Gapvec, GapvecPushOk) {
+	gapvec gv = gapvec_init(sizeof(char));
+
+	EXPECT_EQ(gapvec_push(&gv, &element0), GAPVEC_STATUS_OK);
+	EXPECT_EQ(gapvec_push(&gv, &element1), GAPVEC_STATUS_OK);
+	EXPECT_EQ(gapvec_push(&gv, &element2), GAPVEC_STATUS_OK);
+	EXPECT_EQ(gv.count, 3);
+
+	EXPECT_EQ(*(char *)gapvec_at(&gv, 0), element0);
+	EXPECT_EQ(*(char *)gapvec_at(&gv, 1), element1);
+	EXPECT_EQ(*(char *)gapvec_at(&gv, 2), element2);
+
+	gapvec_deinit(&gv);
+}
+
+TEST(Gapvec, GapvecInsertNull) {
+	gapvec *gv = nullptr;
+
+	EXPECT_EQ(gapvec_insert(gv, 0, nullptr), GAPVEC_STATUS_NULL);
+}
+
+TEST(Gapvec, GapvecInsertBounds) {
+	gapvec gv = gapvec_init(sizeof(char));
+
+	EXPECT_EQ(gapvec_insert(&gv, 1, &element0), GAPVEC_STATUS_BOUNDS);
+	EXPECT_EQ(gv._data, nullptr);
+	EXPECT_EQ(gv.count, 0);
+}
+
+TEST(Gapvec, GapvecInsertOkMultibyte) {
+	gapvec gv = gapvec_init(sizeof(int));
+
+	EXPECT_EQ(gapvec_insert(&gv, 0, &int_element0), GAPVEC_STATUS_OK);
+	EXPECT_EQ(gapvec_insert(&gv, 1, &int_element1), GAPVEC_STATUS_OK);
+	EXPECT_EQ(gapvec_insert(&gv, 0, &int_element2), GAPVEC_STATUS_OK);
+	EXPECT_EQ(gapvec_insert(&gv, 1, &int_element1), GAPVEC_STATUS_OK);
+	EXPECT_EQ(gv.count, 4);
+
+	EXPECT_EQ(*(int *)gapvec_at(&gv, 0), int_element2);
+	EXPECT_EQ(*(int *)gapvec_at(&gv, 1), int_element1);
+	EXPECT_EQ(*(int *)gapvec_at(&gv, 2), int_element0);
+	EXPECT_EQ(*(int *)gapvec_at(&gv, 3), int_element1);
+
+	gapvec_deinit(&gv);
+}
+
+TEST(Gapvec, GapvecInsertOverflow) {
+	gapvec gv = gapvec_init(sizeof(char));
+
+	// Full storage that cannot double
+	char storage = element0;
+	gv._data = &storage;
+	gv.count = SIZE_MAX / 2 + 1;
+	gv._alloc_count = gv.count;
+	gv._gap_start = gv.count;
+	gv._gap_end = gv.count;
+
+	EXPECT_EQ(gapvec_push(&gv, &element1), GAPVEC_STATUS_ALLOC);
+	EXPECT_EQ(gv.count, SIZE_MAX / 2 + 1);
+	EXPECT_EQ(gv._data, &storage);
+}
+
+TEST(Gapvec, GapvecEraseNull) {
+	gapvec *gv = nullptr;
+
+	EXPECT_EQ(gapvec_erase(gv, 0, nullptr), GAPVEC_STATUS_NULL);
+}
+
+TEST(Gapvec, GapvecEraseBounds) {
+	gapvec gv = gapvec_init(sizeof(char));
+	gapvec_push(&gv, &element0);
+
+	EXPECT_EQ(gapvec_erase(&gv, 1, nullptr), GAPVEC_STATUS_BOUNDS);
+	EXPECT_EQ(gv.count, 1);
+
+	gapvec_deinit(&gv);
+}
+
+TEST(Gapvec, GapvecEraseOk) {
+	gapvec gv = gapvec_init(sizeof(char));
+	gapvec_push(&gv, &element0);
+	gapvec_push(&gv, &element1);
+	gapvec_push(&gv, &element2);
+
+	char buffer = 123;
+	EXPECT_EQ(gapvec_erase(&gv, 0, &buffer), GAPVEC_STATUS_OK);
+	EXPECT_EQ(buffer, element0);
+	EXPECT_EQ(gv.count, 2);
+	EXPECT_EQ(*(char *)gapvec_at(&gv, 0), element1);
+	EXPECT_EQ(*(char *)gapvec_at(&gv, 1), element2);
+
+	EXPECT_EQ(gapvec_erase(&gv, 1, &buffer), GAPVEC_STATUS_OK);
+	EXPECT_EQ(buffer, element2);
+	EXPECT_EQ(gv.count, 1);
+	EXPECT_EQ(*(char *)gapvec_at(&gv, 0), element1);
+
+	gapvec_deinit(&gv);
+}
+
+TEST(Gapvec, GapvecAtNull) {
+	gapvec *gv = nullptr;
+
+	EXPECT_EQ(gapvec_at(gv, 0), nullptr);
+}
+
+TEST(Gapvec, GapvecAtBounds) {
+	gapvec gv = gapvec_init(sizeof(char));
+	gapvec_push(&gv, &element0);
+	gapvec_push(&gv, &element1);
+
+	EXPECT_EQ(gapvec_at(&gv, 2), nullptr);
+	EXPECT_EQ(gapvec_at(&gv, 3), nullptr);
+
+	gapvec_deinit(&gv);
+}
+
+TEST(Gapvec, GapvecFlattenOk) {
+	gapvec gv = gapvec_init(sizeof(int));
+
+	// Leave the gap in the middle
+	gapvec_push(&gv, &int_element0);
+	gapvec_push(&gv, &int_element2);
+	gapvec_reserve(&gv, 8);
+	gapvec_insert(&gv, 1, &int_element1);
+
+	vector vec = gapvec_flatten(&gv);
+	EXPECT_EQ(vec.count, 3);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element0);
+	EXPECT_EQ(*(int *)vec_at(&vec, 1), int_element1);
+	EXPECT_EQ(*(int *)vec_at(&vec, 2), int_element2);
+
+	// Gap vector is reset
+	EXPECT_EQ(gv.count, 0);
+	EXPECT_EQ(gv._data, nullptr);
+
+	// Vector is usable
+	EXPECT_EQ(vec_push(&vec, &int_element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(*(int *)vec_at(&vec, 3), int_element0);
+
+	vec_deinit(&vec);
+}
+
+#ifdef VECTOR_STATS
+TEST(Gapvec, GapvecFlattenStats) {
+	vector_stats before = vec_stats_total();
+
+	gapvec gv = gapvec_init(sizeof(int));
+	gapvec_push(&gv, &int_element0);
+
+	// Adopted storage is counted, so releasing it does not wrap the total
+	vector vec = gapvec_flatten(&gv);
+	size_t bytes = vec._alloc_count * sizeof(int);
+	EXPECT_EQ(vec._stats.live_bytes, bytes);
+	EXPECT_EQ(vec_stats_total().live_bytes, before.live_bytes + bytes);
+
+	vec_deinit(&vec);
+	EXPECT_EQ(vec_stats_total().live_bytes, before.live_bytes);
+}
+#endif
+
+TEST(Gapvec, FullTest) {
+	gapvec *gv = gapvec_new(sizeof(int));
+
+	// Cursor-local editing
+	for (int i = 0; i < 100; i++) {
+		EXPECT_EQ(gapvec_push(gv, &i), GAPVEC_STATUS_OK);
+	}
+	for (int i = 0; i < 10; i++) {
+		EXPECT_EQ(gapvec_insert(gv, 50 + i, &int_element0), GAPVEC_STATUS_OK);
+	}
+	for (int i = 0; i < 5; i++) {
+		EXPECT_EQ(gapvec_erase(gv, 55, nullptr), GAPVEC_STATUS_OK);
+	}
+	EXPECT_EQ(gapvec_erase(gv, 0, nullptr), GAPVEC_STATUS_OK);
+
+	EXPECT_EQ(gv->count, 104);
+	EXPECT_EQ(*(int *)gapvec_at(gv, 0), 1);
+	EXPECT_EQ(*(int *)gapvec_at(gv, 48), 49);
+	EXPECT_EQ(*(int *)gapvec_at(gv, 49), int_element0);
+	EXPECT_EQ(*(int *)gapvec_at(gv, 53), int_element0);
+	EXPECT_EQ(*(int *)gapvec_at(gv, 54), 50);
+	EXPECT_EQ(*(int *)gapvec_at(gv, 103), 99);
+
+	vector vec = gapvec_flatten(gv);
+	for (size_t i = 54; i < vec.count; i++) {
+		EXPECT_EQ(*(int *)vec_at(&vec, i), (int)i - 4);
+	}
+
+	vec_deinit(&vec);
+	EXPECT_EQ(gapvec_delete(gv), GAPVEC_STATUS_OK);
+}
@@ -0,0 +1,18 @@
+#!/bin/sh
+# usage: genconfig.sh out [define_list]
+out=$1
+shift
+
+tmp=$out.tmp
+echo "/* Generated from build.conf, do not edit */" > $tmp
+echo "#pragma once" >> $tmp
+for define in $@; do
+	echo "#define $define" >> $tmp
+done
+
+# Keep the old file if nothing changed, so objects are not rebuilt
+if cmp -s $tmp $out; then
+	rm -f $tmp
+else
+	mv $tmp $out
+fi
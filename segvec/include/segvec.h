@@ -0,0 +1,158 @@
+/**
+ * @file segvec.h
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Segmented vector with stable element addresses.
+ */
+#pragma once
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @def SEGVEC_BASE_SHIFT
+ * First chunk holds 2^SEGVEC_BASE_SHIFT elements, each next chunk doubles.
+ */
+#define SEGVEC_BASE_SHIFT 3
+
+/**
+ * @def SEGVEC_MAX_CHUNKS
+ * Size of the chunk directory, enough to address any size_t index.
+ */
+#define SEGVEC_MAX_CHUNKS (sizeof(size_t) * CHAR_BIT - SEGVEC_BASE_SHIFT)
+
+/**
+ * @struct segvec
+ * Segmented vector object. Fields should not be edited.
+ *
+ * @var segvec::count
+ * Current element count.
+ *
+ * @internal
+ *
+ * @var segvec::_chunks
+ * Chunk directory, chunk k holds 2^(SEGVEC_BASE_SHIFT + k) elements.
+ * @var segvec::_type_size
+ * Size of contained type.
+ * @var segvec::_chunk_count
+ * How many chunks are allocated.
+ *
+ * @endinternal
+ */
+typedef struct {
+	size_t count;
+
+	void *_chunks[SEGVEC_MAX_CHUNKS];
+	size_t _type_size;
+	size_t _chunk_count;
+} segvec;
+
+/**
+ * @enum segvec_status
+ * Result of segmented vector operation.
+ *
+ * @var segvec_status::SEGVEC_STATUS_OK
+ * Operation completed successfully.
+ *
+ * @var segvec_status::SEGVEC_STATUS_NULL
+ * Segmented vector argument is null.
+ *
+ * @var segvec_status::SEGVEC_STATUS_EMPTY
+ * Segmented vector is empty.
+ *
+ * @var segvec_status::SEGVEC_STATUS_ALLOC
+ * Memory allocation failed.
+ */
+typedef enum {
+	SEGVEC_STATUS_OK = 0,
+	SEGVEC_STATUS_NULL = 1,
+	SEGVEC_STATUS_EMPTY = 2,
+	SEGVEC_STATUS_ALLOC = 3,
+} segvec_status;
+
+/**
+ * @brief Create segmented vector object on the stack.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @return Segmented vector object.
+ * @note Delete with segvec_deinit.
+ */
+segvec segvec_init(size_t type_size);
+
+/**
+ * @brief Create segmented vector object on the heap.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @return Segmented vector object.
+ * @note Delete with segvec_delete.
+ */
+segvec *segvec_new(size_t type_size);
+
+/**
+ * @brief Delete segmented vector object from the stack.
+ *
+ * @param[in] sv - Segmented vector object.
+ * @return Status code.
+ */
+segvec_status segvec_deinit(segvec *sv);
+
+/**
+ * @brief Delete segmented vector object from the heap.
+ *
+ * @param[in] sv - Segmented vector object.
+ * @return Status code.
+ */
+segvec_status segvec_delete(segvec *sv);
+
+/**
+ * @brief Reserve space for elements.
+ *
+ * @param[in,out] sv - Segmented vector object.
+ * @param[in] count - Amount of elements to reserve.
+ * @return Status code, SEGVEC_STATUS_ALLOC for a zero type size.
+ * @note Will only grow the object, existing elements are never moved.
+ */
+segvec_status segvec_reserve(segvec *sv, size_t count);
+
+/**
+ * @brief Add element to the end.
+ *
+ * @param[in,out] sv - Segmented vector object.
+ * @param[in] value - New element.
+ * @return Status code.
+ * @note Existing elements are never moved.
+ */
+segvec_status segvec_push(segvec *sv, const void *value);
+
+/**
+ * @brief Remove element from the end.
+ *
+ * @param[in,out] sv - Segmented vector object.
+ * @param[out] buffer - If not NULL, removed element is copied here.
+ * @return Status code.
+ * @note Chunks are kept allocated.
+ */
+segvec_status segvec_pop(segvec *sv, void *buffer);
+
+/**
+ * @brief Access element at specified location (const).
+ *
+ * @param[in] sv - Segmented vector object.
+ * @param[in] index - Access index.
+ * @return Pointer to element (const).
+ * @note Pointer stays valid until the object is deleted.
+ */
+const void *segvec_at(const segvec *sv, size_t index);
+
+/**
+ * @brief Access element at specified location (mutable).
+ *
+ * @param[in] sv - Segmented vector object.
+ * @param[in] index - Access index.
+ * @return Pointer to element (mutable).
+ * @note Pointer stays valid until the object is deleted.
+ */
+void *segvec_at_mut(const segvec *sv, size_t index);
@@ -0,0 +1,172 @@
+/**
+ * @file segvec.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Segmented vector with stable element addresses.
+ */
+#include "segvec.h"
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Elements in the first chunk
+#define BASE ((size_t)1 << SEGVEC_BASE_SHIFT)
+
+// Elements in chunk k
+#define chunk_size(k) (BASE << (k))
+
+// Elements in chunks 0 through k - 1
+#define chunks_capacity(k) (BASE * (((size_t)1 << (k)) - 1))
+
+static size_t locate(size_t index, size_t *offset);
+
+segvec segvec_init(size_t type_size) {
+	segvec sv = {
+		.count = 0,
+		._chunks = { NULL },
+		._type_size = type_size,
+		._chunk_count = 0,
+	};
+
+	return sv;
+}
+
+segvec *segvec_new(size_t type_size) {
+	segvec *sv = malloc(sizeof(segvec));
+	if (sv == NULL) {
+		return NULL;
+	}
+
+	*sv = segvec_init(type_size);
+	return sv;
+}
+
+segvec_status segvec_deinit(segvec *sv) {
+	if (sv == NULL) {
+		return SEGVEC_STATUS_NULL;
+	}
+
+	for (size_t k = 0; k < sv->_chunk_count; k++) {
+		free(sv->_chunks[k]);
+	}
+
+	return SEGVEC_STATUS_OK;
+}
+
+segvec_status segvec_delete(segvec *sv) {
+	if (segvec_deinit(sv) == SEGVEC_STATUS_NULL) {
+		return SEGVEC_STATUS_NULL;
+	}
+
+	free(sv);
+	return SEGVEC_STATUS_OK;
+}
+
+segvec_status segvec_reserve(segvec *sv, size_t count) {
+	if (sv == NULL) {
+		return SEGVEC_STATUS_NULL;
+	}
+
+	while (sv->_chunk_count < SEGVEC_MAX_CHUNKS
+		&& chunks_capacity(sv->_chunk_count) < count) {
+		// Capacity math divides by the type size
+		if (sv->_type_size == 0) {
+			return SEGVEC_STATUS_ALLOC;
+		}
+
+		size_t k = sv->_chunk_count;
+		if (chunk_size(k) > SIZE_MAX / sv->_type_size) {
+			return SEGVEC_STATUS_ALLOC;
+		}
+
+		void *chunk = malloc(sv->_type_size * chunk_size(k));
+		if (chunk == NULL) {
+			return SEGVEC_STATUS_ALLOC;
+		}
+
+		sv->_chunks[k] = chunk;
+		sv->_chunk_count++;
+	}
+
+	return SEGVEC_STATUS_OK;
+}
+
+segvec_status segvec_push(segvec *sv, const void *value) {
+	if (sv == NULL) {
+		return SEGVEC_STATUS_NULL;
+	}
+
+	size_t offset;
+	size_t k = locate(sv->count, &offset);
+
+	// Need a new chunk
+	if (k == sv->_chunk_count) {
+		segvec_status status = segvec_reserve(sv, sv->count + 1);
+		if (status != SEGVEC_STATUS_OK) {
+			return status;
+		}
+	}
+
+	// Copy element
+	void *push_ptr = sv->_chunks[k] + sv->_type_size * offset;
+	memcpy(push_ptr, value, sv->_type_size);
+
+	sv->count++;
+	return SEGVEC_STATUS_OK;
+}
+
+segvec_status segvec_pop(segvec *sv, void *buffer) {
+	if (sv == NULL) {
+		return SEGVEC_STATUS_NULL;
+	}
+
+	if (sv->count == 0) {
+		return SEGVEC_STATUS_EMPTY;
+	}
+
+	// Copy element if needed
+	if (buffer != NULL) {
+		memcpy(buffer, segvec_at(sv, sv->count - 1), sv->_type_size);
+	}
+
+	sv->count--;
+	return SEGVEC_STATUS_OK;
+}
+
+const void *segvec_at(const segvec *sv, size_t index) {
+	return segvec_at_mut(sv, index);
+}
+
+void *segvec_at_mut(const segvec *sv, size_t index) {
+	if (sv == NULL || index >= sv->count) {
+		return NULL;
+	}
+
+	size_t offset;
+	size_t k = locate(index, &offset);
+
+	return sv->_chunks[k] + sv->_type_size * offset;
+}
+
+/**
+ * @brief Find chunk and offset of an element.
+ *
+ * Biasing the index by the first chunk size makes the position of its
+ * highest set bit select the chunk, and the remaining bits the offset.
+ *
+ * @param[in] index - Element index.
+ * @param[out] offset - Element offset in the chunk.
+ * @return Chunk index.
+ */
+static size_t locate(size_t index, size_t *offset) {
+	unsigned long long biased = (unsigned long long)index + BASE;
+	size_t top_bit = sizeof(biased) * CHAR_BIT - 1 - __builtin_clzll(biased);
+
+	*offset = biased - ((unsigned long long)1 << top_bit);
+	return top_bit - SEGVEC_BASE_SHIFT;
+}
@@ -0,0 +1,178 @@
+extern "C" {
+#include "../include/segvec.h"
+}
+
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+static char element0 = '0';
+static char element1 = '1';
+static char element2 = '2';
+
+TEST(Segvec, SegvecInitOk) {
+	segvec sv = segvec_init(sizeof(char));
+
+	EXPECT_EQ(sv.count, 0);
+	EXPECT_EQ(sv._chunk_count, 0);
+	EXPECT_EQ(sv._chunks[0], nullptr);
+}
+
+TEST(Segvec, SegvecNewOk) {
+	segvec *sv = segvec_new(sizeof(char));
+
+	EXPECT_NE(sv, nullptr);
+	EXPECT_EQ(sv->count, 0);
+	EXPECT_EQ(sv->_chunk_count, 0);
+
+	free(sv);
+}
+
+TEST(Segvec, SegvecDeinitNullArg) {
+	segvec *sv = nullptr;
+
+	EXPECT_EQ(segvec_deinit(sv), SEGVEC_STATUS_NULL);
+}
+
+TEST(Segvec, SegvecDeleteNullArg) {
+	segvec *sv = nullptr;
+
+	EXPECT_EQ(segvec_delete(sv), SEGVEC_STATUS_NULL);
+}
+
+TEST(Segvec, SegvecReserveNull) {
+	segvec *sv = nullptr;
+
+	EXPECT_EQ(segvec_reserve(sv, 10), SEGVEC_STATUS_NULL);
+}
+
+TEST(Segvec, SegvecReserveOk) {
+	segvec sv = segvec_init(sizeof(char));
+
+	// Chunks of 8, 16 and 32 elements
+	EXPECT_EQ(segvec_reserve(&sv, 8), SEGVEC_STATUS_OK);
+	EXPECT_EQ(sv._chunk_count, 1);
+	EXPECT_EQ(segvec_reserve(&sv, 9), SEGVEC_STATUS_OK);
+	EXPECT_EQ(sv._chunk_count, 2);
+	EXPECT_EQ(segvec_reserve(&sv, 50), SEGVEC_STATUS_OK);
+	EXPECT_EQ(sv._chunk_count, 3);
+
+	// Less than allocated
+	EXPECT_EQ(segvec_reserve(&sv, 4), SEGVEC_STATUS_OK);
+	EXPECT_EQ(sv._chunk_count, 3);
+
+	segvec_deinit(&sv);
+}
+
+TEST(Segvec, SegvecReserveZeroSize) {
+	segvec sv = segvec_init(0);
+
+	EXPECT_EQ(segvec_reserve(&sv, 8), SEGVEC_STATUS_ALLOC);
+	EXPECT_EQ(segvec_push(&sv, &element0), SEGVEC_STATUS_ALLOC);
+	EXPECT_EQ(sv._chunk_count, 0);
+
+	segvec_deinit(&sv);
+}
+
+TEST(Segvec, SegvecPushNull) {
+	segvec *sv = nullptr;
+
+	EXPECT_EQ(segvec_push(sv, nullptr), SEGVEC_STATUS_NULL);
+}
+
+TEST(Segvec, SegvecPushOk) {
+	segvec sv = segvec_init(sizeof(char));
+
+	EXPECT_EQ(segvec_push(&sv, &element0), SEGVEC_STATUS_OK);
+	EXPECT_EQ(segvec_push(&sv, &element1), SEGVEC_STATUS_OK);
+	EXPECT_EQ(segvec_push(&sv, &element2), SEGVEC_STATUS_OK);
+	EXPECT_EQ(sv.count, 3);
+
+	EXPECT_EQ(*(char *)segvec_at(&sv, 0), element0);
+	EXPECT_EQ(*(char *)segvec_at(&sv, 1), element1);
+	EXPECT_EQ(*(char *)segvec_at(&sv, 2), element2);
+
+	segvec_deinit(&sv);
+}
+
+TEST(Segvec, SegvecPushStable) {
+	segvec sv = segvec_init(sizeof(int));
+
+	int first = 0;
+	EXPECT_EQ(segvec_push(&sv, &first), SEGVEC_STATUS_OK);
+	const int *first_ptr = (const int *)segvec_at(&sv, 0);
+
+	// Elements never move across chunk allocations
+	for (int i = 1; i < 10000; i++) {
+		EXPECT_EQ(segvec_push(&sv, &i), SEGVEC_STATUS_OK);
+	}
+	EXPECT_EQ(segvec_at(&sv, 0), first_ptr);
+
+	for (int i = 0; i < 10000; i++) {
+		EXPECT_EQ(*(int *)segvec_at(&sv, i), i);
+	}
+
+	segvec_deinit(&sv);
+}
+
+TEST(Segvec, SegvecPopNull) {
+	segvec *sv = nullptr;
+
+	EXPECT_EQ(segvec_pop(sv, nullptr), SEGVEC_STATUS_NULL);
+}
+
+TEST(Segvec, SegvecPopEmpty) {
+	segvec sv = segvec_init(sizeof(char));
+
+	EXPECT_EQ(segvec_pop(&sv, nullptr), SEGVEC_STATUS_EMPTY);
+}
+
+TEST(Segvec, SegvecPopOk) {
+	segvec sv = segvec_init(sizeof(char));
+	segvec_push(&sv, &element0);
+	segvec_push(&sv, &element1);
+
+	char buffer = 123;
+	EXPECT_EQ(segvec_pop(&sv, &buffer), SEGVEC_STATUS_OK);
+	EXPECT_EQ(buffer, element1);
+	EXPECT_EQ(sv.count, 1);
+
+	EXPECT_EQ(segvec_pop(&sv, &buffer), SEGVEC_STATUS_OK);
+	EXPECT_EQ(buffer, element0);
+	EXPECT_EQ(sv.count, 0);
+
+	segvec_deinit(&sv);
+}
+
+TEST(Segvec, SegvecAtNull) {
+	segvec *sv = nullptr;
+
+	EXPECT_EQ(segvec_at(sv, 0), nullptr);
+}
+
+TEST(Segvec, SegvecAtBounds) {
+	segvec sv = segvec_init(sizeof(char));
+	segvec_push(&sv, &element0);
+
+	EXPECT_EQ(segvec_at(&sv, 1), nullptr);
+	EXPECT_EQ(segvec_at(&sv, 2), nullptr);
+
+	segvec_deinit(&sv);
+}
+
+TEST(Segvec, FullTest) {
+	segvec *sv = segvec_new(sizeof(char));
+
+	EXPECT_EQ(segvec_push(sv, &element0), SEGVEC_STATUS_OK);
+	EXPECT_EQ(segvec_push(sv, &element1), SEGVEC_STATUS_OK);
+	EXPECT_EQ(segvec_push(sv, &element2), SEGVEC_STATUS_OK);
+
+	char buffer = 123;
+	EXPECT_EQ(segvec_pop(sv, &buffer), SEGVEC_STATUS_OK);
+	EXPECT_EQ(buffer, element2);
+
+	*(char *)segvec_at_mut(sv, 0) = element2;
+	EXPECT_EQ(*(char *)segvec_at(sv, 0), element2);
+	EXPECT_EQ(*(char *)segvec_at(sv, 1), element1);
+
+	EXPECT_EQ(segvec_delete(sv), SEGVEC_STATUS_OK);
+}
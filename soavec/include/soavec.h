@@ -0,0 +1,202 @@
+/**
+ * @file soavec.h
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Struct-of-arrays vector.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <c-utils/vector.h>
+
+/**
+ * @def SOAVEC_MAX_FIELDS
+ * Maximum amount of fields per element.
+ */
+#define SOAVEC_MAX_FIELDS 16
+
+/**
+ * @def SOAVEC_COLUMN(soa, field, T)
+ * Typed pointer to the first element of a column.
+ *
+ * @param soa - Struct-of-arrays vector object.
+ * @param field - Field index.
+ * @param T - Field type.
+ */
+#define SOAVEC_COLUMN(soa, field, T) ((T *)soavec_column_mut(soa, field))
+
+/**
+ * @struct soavec
+ * Struct-of-arrays vector object. Fields should not be edited.
+ *
+ * Each field of an element is stored in its own column, so scanning a single
+ * field reads contiguous memory.
+ *
+ * @var soavec::count
+ * Current element count.
+ *
+ * @internal
+ *
+ * @var soavec::_columns
+ * One vector per field, all holding count elements.
+ * @var soavec::_field_count
+ * Amount of fields per element.
+ *
+ * @endinternal
+ */
+typedef struct {
+	size_t count;
+
+	vector _columns[SOAVEC_MAX_FIELDS];
+	size_t _field_count;
+} soavec;
+
+/**
+ * @enum soavec_status
+ * Result of struct-of-arrays vector operation.
+ *
+ * @var soavec_status::SOAVEC_STATUS_OK
+ * Operation completed successfully.
+ *
+ * @var soavec_status::SOAVEC_STATUS_NULL
+ * Struct-of-arrays vector argument is null.
+ *
+ * @var soavec_status::SOAVEC_STATUS_BOUNDS
+ * Operation was out of bounds.
+ *
+ * @var soavec_status::SOAVEC_STATUS_ALLOC
+ * Memory allocation failed.
+ */
+typedef enum {
+	SOAVEC_STATUS_OK = 0,
+	SOAVEC_STATUS_NULL = 1,
+	SOAVEC_STATUS_BOUNDS = 2,
+	SOAVEC_STATUS_ALLOC = 3,
+} soavec_status;
+
+/**
+ * @brief Create struct-of-arrays vector object on the stack.
+ *
+ * @param[out] soa - Struct-of-arrays vector object.
+ * @param[in] field_sizes - sizeof result of each field type.
+ * @param[in] field_count - Amount of fields, up to SOAVEC_MAX_FIELDS.
+ * @return Status code.
+ * @note Delete with soavec_deinit.
+ */
+soavec_status soavec_init(soavec *soa,
+	const size_t *field_sizes,
+	size_t field_count);
+
+/**
+ * @brief Create struct-of-arrays vector object on the heap.
+ *
+ * @param[in] field_sizes - sizeof result of each field type.
+ * @param[in] field_count - Amount of fields, up to SOAVEC_MAX_FIELDS.
+ * @return Struct-of-arrays vector object, NULL on failure.
+ * @note Delete with soavec_delete.
+ */
+soavec *soavec_new(const size_t *field_sizes, size_t field_count);
+
+/**
+ * @brief Delete struct-of-arrays vector object from the stack.
+ *
+ * @param[in] soa - Struct-of-arrays vector object.
+ * @return Status code.
+ */
+soavec_status soavec_deinit(soavec *soa);
+
+/**
+ * @brief Delete struct-of-arrays vector object from the heap.
+ *
+ * @param[in] soa - Struct-of-arrays vector object.
+ * @return Status code.
+ */
+soavec_status soavec_delete(soavec *soa);
+
+/**
+ * @brief Reserve space for elements in every column.
+ *
+ * @param[in,out] soa - Struct-of-arrays vector object.
+ * @param[in] count - Amount of elements to reserve.
+ * @return Status code.
+ * @note Will only grow the object.
+ */
+soavec_status soavec_reserve(soavec *soa, size_t count);
+
+/**
+ * @brief Add element to the end.
+ *
+ * @param[in,out] soa - Struct-of-arrays vector object.
+ * @param[in] values - One pointer per field to the new field value.
+ * @return Status code.
+ * @note No column is changed if growth fails.
+ */
+soavec_status soavec_push(soavec *soa, const void *const *values);
+
+/**
+ * @brief Add element at specified location.
+ *
+ * @param[in,out] soa - Struct-of-arrays vector object.
+ * @param[in] index - Insert index.
+ * @param[in] values - One pointer per field to the new field value.
+ * @return Status code.
+ * @note No column is changed if growth fails.
+ */
+soavec_status soavec_insert(soavec *soa,
+	size_t index,
+	const void *const *values);
+
+/**
+ * @brief Remove element at specified location.
+ *
+ * @param[in,out] soa - Struct-of-arrays vector object.
+ * @param[in] index - Removal index.
+ * @param[out] buffers - If not NULL, one pointer per field where the erased
+ * field value is placed. Individual pointers may be NULL.
+ * @return Status code.
+ */
+soavec_status soavec_erase(soavec *soa, size_t index, void *const *buffers);
+
+/**
+ * @brief Access column of a field (const).
+ *
+ * @param[in] soa - Struct-of-arrays vector object.
+ * @param[in] field - Field index.
+ * @return Pointer to the first element of the column (const).
+ * @note Pointer is invalidated when the object grows.
+ */
+const void *soavec_column(const soavec *soa, size_t field);
+
+/**
+ * @brief Access column of a field (mutable).
+ *
+ * @param[in] soa - Struct-of-arrays vector object.
+ * @param[in] field - Field index.
+ * @return Pointer to the first element of the column (mutable).
+ * @note Pointer is invalidated when the object grows.
+ */
+void *soavec_column_mut(const soavec *soa, size_t field);
+
+/**
+ * @brief Access field of an element at specified location (const).
+ *
+ * @param[in] soa - Struct-of-arrays vector object.
+ * @param[in] field - Field index.
+ * @param[in] index - Access index.
+ * @return Pointer to field value (const).
+ */
+const void *soavec_at(const soavec *soa, size_t field, size_t index);
+
+/**
+ * @brief Access field of an element at specified location (mutable).
+ *
+ * @param[in] soa - Struct-of-arrays vector object.
+ * @param[in] field - Field index.
+ * @param[in] index - Access index.
+ * @return Pointer to field value (mutable).
+ */
+void *soavec_at_mut(const soavec *soa, size_t field, size_t index);
@@ -0,0 +1,181 @@
+/**
+ * @file soavec.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Struct-of-arrays vector.
+ */
+#include "soavec.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <c-utils/vector.h>
+
+static soavec_status grow(soavec *soa);
+
+soavec_status soavec_init(soavec *soa,
+	const size_t *field_sizes,
+	size_t field_count) {
+	if (soa == NULL || field_sizes == NULL) {
+		return SOAVEC_STATUS_NULL;
+	}
+
+	if (field_count == 0 || field_count > SOAVEC_MAX_FIELDS) {
+		return SOAVEC_STATUS_BOUNDS;
+	}
+
+	soa->count = 0;
+	soa->_field_count = field_count;
+	for (size_t i = 0; i < field_count; i++) {
+		soa->_columns[i] = vec_init(field_sizes[i]);
+	}
+
+	return SOAVEC_STATUS_OK;
+}
+
+soavec *soavec_new(const size_t *field_sizes, size_t field_count) {
+	soavec *soa = malloc(sizeof(soavec));
+	if (soa == NULL) {
+		return NULL;
+	}
+
+	if (soavec_init(soa, field_sizes, field_count) != SOAVEC_STATUS_OK) {
+		free(soa);
+		return NULL;
+	}
+
+	return soa;
+}
+
+soavec_status soavec_deinit(soavec *soa) {
+	if (soa == NULL) {
+		return SOAVEC_STATUS_NULL;
+	}
+
+	for (size_t i = 0; i < soa->_field_count; i++) {
+		vec_deinit(&soa->_columns[i]);
+	}
+
+	return SOAVEC_STATUS_OK;
+}
+
+soavec_status soavec_delete(soavec *soa) {
+	if (soavec_deinit(soa) == SOAVEC_STATUS_NULL) {
+		return SOAVEC_STATUS_NULL;
+	}
+
+	free(soa);
+	return SOAVEC_STATUS_OK;
+}
+
+soavec_status soavec_reserve(soavec *soa, size_t count) {
+	if (soa == NULL) {
+		return SOAVEC_STATUS_NULL;
+	}
+
+	for (size_t i = 0; i < soa->_field_count; i++) {
+		if (vec_reserve(&soa->_columns[i], count) != VECTOR_STATUS_OK) {
+			return SOAVEC_STATUS_ALLOC;
+		}
+	}
+
+	return SOAVEC_STATUS_OK;
+}
+
+soavec_status soavec_push(soavec *soa, const void *const *values) {
+	if (soa == NULL) {
+		return SOAVEC_STATUS_NULL;
+	}
+
+	return soavec_insert(soa, soa->count, values);
+}
+
+soavec_status soavec_insert(soavec *soa,
+	size_t index,
+	const void *const *values) {
+	if (soa == NULL || values == NULL) {
+		return SOAVEC_STATUS_NULL;
+	}
+
+	// Up to last index + 1
+	if (index > soa->count) {
+		return SOAVEC_STATUS_BOUNDS;
+	}
+
+	soavec_status status = grow(soa);
+	if (status != SOAVEC_STATUS_OK) {
+		return status;
+	}
+
+	// Capacity is in place, so columns can not fail individually
+	for (size_t i = 0; i < soa->_field_count; i++) {
+		vec_insert(&soa->_columns[i], index, values[i]);
+	}
+
+	soa->count++;
+	return SOAVEC_STATUS_OK;
+}
+
+soavec_status soavec_erase(soavec *soa, size_t index, void *const *buffers) {
+	if (soa == NULL) {
+		return SOAVEC_STATUS_NULL;
+	}
+
+	if (index >= soa->count) {
+		return SOAVEC_STATUS_BOUNDS;
+	}
+
+	for (size_t i = 0; i < soa->_field_count; i++) {
+		void *buffer = (buffers == NULL) ? NULL : buffers[i];
+		vec_erase(&soa->_columns[i], index, buffer);
+	}
+
+	soa->count--;
+	return SOAVEC_STATUS_OK;
+}
+
+const void *soavec_column(const soavec *soa, size_t field) {
+	return soavec_column_mut(soa, field);
+}
+
+void *soavec_column_mut(const soavec *soa, size_t field) {
+	if (soa == NULL || field >= soa->_field_count) {
+		return NULL;
+	}
+
+	return soa->_columns[field].data;
+}
+
+const void *soavec_at(const soavec *soa, size_t field, size_t index) {
+	return soavec_at_mut(soa, field, index);
+}
+
+void *soavec_at_mut(const soavec *soa, size_t field, size_t index) {
+	if (soa == NULL || field >= soa->_field_count) {
+		return NULL;
+	}
+
+	// Columns are never shared, so no copy-on-write is needed
+	return (void *)vec_at(&soa->_columns[field], index);
+}
+
+/**
+ * @brief Make room for one more element in every column.
+ *
+ * Columns share the vector growth policy, so they grow in step.
+ *
+ * @param[in,out] soa - Struct-of-arrays vector object.
+ * @return Status code.
+ */
+static soavec_status grow(soavec *soa) {
+	for (size_t i = 0; i < soa->_field_count; i++) {
+		if (vec_grow(&soa->_columns[i], 1) != VECTOR_STATUS_OK) {
+			return SOAVEC_STATUS_ALLOC;
+		}
+	}
+
+	return SOAVEC_STATUS_OK;
+}
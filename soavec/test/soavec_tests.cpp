@@ -0,0 +1,235 @@
+extern "C" {
+#include <c-utils/vector.h>
+
+#include "../include/soavec.h"
+}
+
+#include <cstdint>
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+static const size_t field_sizes[] = { sizeof(int), sizeof(char) };
+
+static int int_element0 = 123;
+static int int_element1 = 456;
+static int int_element2 = 789;
+
+static char element0 = '0';
+static char element1 = '1';
+static char element2 = '2';
+
+TEST(Soavec, SoavecInitNull) {
+	soavec soa;
+
+	EXPECT_EQ(soavec_init(nullptr, field_sizes, 2), SOAVEC_STATUS_NULL);
+	EXPECT_EQ(soavec_init(&soa, nullptr, 2), SOAVEC_STATUS_NULL);
+}
+
+TEST(Soavec, SoavecInitBounds) {
+	soavec soa;
+	size_t sizes[SOAVEC_MAX_FIELDS + 1] = { 0 };
+
+	EXPECT_EQ(soavec_init(&soa, field_sizes, 0), SOAVEC_STATUS_BOUNDS);
+	EXPECT_EQ(soavec_init(&soa, sizes, SOAVEC_MAX_FIELDS + 1),
+		SOAVEC_STATUS_BOUNDS);
+}
+
+TEST(Soavec, SoavecInitOk) {
+	soavec soa;
+
+	EXPECT_EQ(soavec_init(&soa, field_sizes, 2), SOAVEC_STATUS_OK);
+	EXPECT_EQ(soa.count, 0);
+	EXPECT_EQ(soa._field_count, 2);
+	EXPECT_EQ(soa._columns[0]._type_size, sizeof(int));
+	EXPECT_EQ(soa._columns[1]._type_size, sizeof(char));
+}
+
+TEST(Soavec, SoavecNewOk) {
+	soavec *soa = soavec_new(field_sizes, 2);
+
+	EXPECT_NE(soa, nullptr);
+	EXPECT_EQ(soa->count, 0);
+	EXPECT_EQ(soavec_new(field_sizes, 0), nullptr);
+
+	free(soa);
+}
+
+TEST(Soavec, SoavecDeinitNullArg) {
+	soavec *soa = nullptr;
+
+	EXPECT_EQ(soavec_deinit(soa), SOAVEC_STATUS_NULL);
+}
+
+TEST(Soavec, SoavecDeleteNullArg) {
+	soavec *soa = nullptr;
+
+	EXPECT_EQ(soavec_delete(soa), SOAVEC_STATUS_NULL);
+}
+
+TEST(Soavec, SoavecReserveNull) {
+	soavec *soa = nullptr;
+
+	EXPECT_EQ(soavec_reserve(soa, 10), SOAVEC_STATUS_NULL);
+}
+
+TEST(Soavec, SoavecReserveOk) {
+	soavec soa;
+	soavec_init(&soa, field_sizes, 2);
+
+	EXPECT_EQ(soavec_reserve(&soa, 10), SOAVEC_STATUS_OK);
+	EXPECT_GE(soa._columns[0]._alloc_count, 10);
+	EXPECT_GE(soa._columns[1]._alloc_count, 10);
+
+	soavec_deinit(&soa);
+}
+
+TEST(Soavec, SoavecReserveAlloc) {
+	soavec soa;
+	soavec_init(&soa, field_sizes, 2);
+
+	EXPECT_EQ(soavec_reserve(&soa, SIZE_MAX), SOAVEC_STATUS_ALLOC);
+	EXPECT_EQ(soa.count, 0);
+
+	soavec_deinit(&soa);
+}
+
+TEST(Soavec, SoavecPushNull) {
+	soavec *soa = nullptr;
+
+	EXPECT_EQ(soavec_push(soa, nullptr), SOAVEC_STATUS_NULL);
+}
+
+TEST(Soavec, SoavecPushOk) {
+	soavec soa;
+	soavec_init(&soa, field_sizes, 2);
+
+	const void *values0[] = { &int_element0, &element0 };
+	const void *values1[] = { &int_element1, &element1 };
+	EXPECT_EQ(soavec_push(&soa, values0), SOAVEC_STATUS_OK);
+	EXPECT_EQ(soavec_push(&soa, values1), SOAVEC_STATUS_OK);
+	EXPECT_EQ(soa.count, 2);
+
+	// Columns are contiguous
+	const int *ints = SOAVEC_COLUMN(&soa, 0, int);
+	const char *chars = SOAVEC_COLUMN(&soa, 1, char);
+	EXPECT_EQ(ints[0], int_element0);
+	EXPECT_EQ(ints[1], int_element1);
+	EXPECT_EQ(chars[0], element0);
+	EXPECT_EQ(chars[1], element1);
+
+	soavec_deinit(&soa);
+}
+
+TEST(Soavec, SoavecInsertNull) {
+	soavec *soa = nullptr;
+
+	EXPECT_EQ(soavec_insert(soa, 0, nullptr), SOAVEC_STATUS_NULL);
+}
+
+TEST(Soavec, SoavecInsertBounds) {
+	soavec soa;
+	soavec_init(&soa, field_sizes, 2);
+
+	const void *values[] = { &int_element0, &element0 };
+	EXPECT_EQ(soavec_insert(&soa, 1, values), SOAVEC_STATUS_BOUNDS);
+	EXPECT_EQ(soa.count, 0);
+	EXPECT_EQ(soavec_column(&soa, 0), nullptr);
+
+	soavec_deinit(&soa);
+}
+
+TEST(Soavec, SoavecInsertOk) {
+	soavec soa;
+	soavec_init(&soa, field_sizes, 2);
+
+	const void *values0[] = { &int_element0, &element0 };
+	const void *values1[] = { &int_element1, &element1 };
+	const void *values2[] = { &int_element2, &element2 };
+	EXPECT_EQ(soavec_insert(&soa, 0, values0), SOAVEC_STATUS_OK);
+	EXPECT_EQ(soavec_insert(&soa, 0, values1), SOAVEC_STATUS_OK);
+	EXPECT_EQ(soavec_insert(&soa, 1, values2), SOAVEC_STATUS_OK);
+	EXPECT_EQ(soa.count, 3);
+
+	EXPECT_EQ(*(int *)soavec_at(&soa, 0, 0), int_element1);
+	EXPECT_EQ(*(int *)soavec_at(&soa, 0, 1), int_element2);
+	EXPECT_EQ(*(int *)soavec_at(&soa, 0, 2), int_element0);
+	EXPECT_EQ(*(char *)soavec_at(&soa, 1, 0), element1);
+	EXPECT_EQ(*(char *)soavec_at(&soa, 1, 1), element2);
+	EXPECT_EQ(*(char *)soavec_at(&soa, 1, 2), element0);
+
+	soavec_deinit(&soa);
+}
+
+TEST(Soavec, SoavecEraseNull) {
+	soavec *soa = nullptr;
+
+	EXPECT_EQ(soavec_erase(soa, 0, nullptr), SOAVEC_STATUS_NULL);
+}
+
+TEST(Soavec, SoavecEraseBounds) {
+	soavec soa;
+	soavec_init(&soa, field_sizes, 2);
+
+	EXPECT_EQ(soavec_erase(&soa, 0, nullptr), SOAVEC_STATUS_BOUNDS);
+
+	soavec_deinit(&soa);
+}
+
+TEST(Soavec, SoavecEraseOk) {
+	soavec soa;
+	soavec_init(&soa, field_sizes, 2);
+
+	const void *values0[] = { &int_element0, &element0 };
+	const void *values1[] = { &int_element1, &element1 };
+	soavec_push(&soa, values0);
+	soavec_push(&soa, values1);
+
+	// Only copy out selected fields
+	int int_buffer = 0;
+	void *buffers[] = { &int_buffer, nullptr };
+	EXPECT_EQ(soavec_erase(&soa, 0, buffers), SOAVEC_STATUS_OK);
+	EXPECT_EQ(int_buffer, int_element0);
+	EXPECT_EQ(soa.count, 1);
+	EXPECT_EQ(*(int *)soavec_at(&soa, 0, 0), int_element1);
+	EXPECT_EQ(*(char *)soavec_at(&soa, 1, 0), element1);
+
+	EXPECT_EQ(soavec_erase(&soa, 0, nullptr), SOAVEC_STATUS_OK);
+	EXPECT_EQ(soa.count, 0);
+
+	soavec_deinit(&soa);
+}
+
+TEST(Soavec, SoavecColumnBounds) {
+	soavec soa;
+	soavec_init(&soa, field_sizes, 2);
+
+	EXPECT_EQ(soavec_column(nullptr, 0), nullptr);
+	EXPECT_EQ(soavec_column(&soa, 2), nullptr);
+	EXPECT_EQ(soavec_at(&soa, 2, 0), nullptr);
+	EXPECT_EQ(soavec_at(&soa, 0, 0), nullptr);
+
+	soavec_deinit(&soa);
+}
+
+TEST(Soavec, FullTest) {
+	soavec *soa = soavec_new(field_sizes, 2);
+
+	for (int i = 0; i < 1000; i++) {
+		char tag = (char)(i % 128);
+		const void *values[] = { &i, &tag };
+		EXPECT_EQ(soavec_push(soa, values), SOAVEC_STATUS_OK);
+	}
+
+	// Scan a single column
+	const int *ints = SOAVEC_COLUMN(soa, 0, int);
+	long sum = 0;
+	for (size_t i = 0; i < soa->count; i++) {
+		sum += ints[i];
+	}
+	EXPECT_EQ(sum, 999 * 1000 / 2);
+
+	const char *tags = SOAVEC_COLUMN(soa, 1, char);
+	EXPECT_EQ(tags[999], (char)(999 % 128));
+
+	EXPECT_EQ(soavec_delete(soa), SOAVEC_STATUS_OK);
+}
@@ -11,6 +11,27 @@
 #include <stddef.h>
 #include <stdint.h>
 
+/**
+ * @struct stack_allocator
+ * Custom memory allocator for stack storage.
+ *
+ * @var stack_allocator::alloc
+ * Allocate size bytes, returns NULL on failure.
+ * @var stack_allocator::resize
+ * Resize allocation at ptr from old_size to new_size bytes, preserving
+ * contents. Returns NULL on failure, leaving the allocation intact.
+ * @var stack_allocator::release
+ * Free allocation at ptr of size bytes.
+ * @var stack_allocator::ctx
+ * User context, passed to every call.
+ */
+typedef struct {
+	void *(*alloc)(void *ctx, size_t size);
+	void *(*resize)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+	void (*release)(void *ctx, void *ptr, size_t size);
+	void *ctx;
+} stack_allocator;
+
 /**
  * @struct stack
  * Stack object. Fields should not be edited.
@@ -26,6 +47,8 @@
  * Size of contained type.
  * @var stack::_alloc_count
  * How many elements can fit in data.
+ * @var stack::_allocator
+ * Custom allocator, libc is used if NULL.
  *
  * @endinternal
  */
@@ -35,6 +58,7 @@ typedef struct {
 	void *_data;
 	size_t _type_size;
 	uint32_t _alloc_count;
+	const stack_allocator *_allocator;
 } stack;
 
 /**
@@ -49,11 +73,15 @@ typedef struct {
  *
  * @var stack_status::STACK_STATUS_EMPTY
  * Stack is empty.
+ *
+ * @var stack_status::STACK_STATUS_ALLOC
+ * Memory allocation failed.
  */
 typedef enum {
 	STACK_STATUS_OK = 0,
 	STACK_STATUS_NULL = 1,
-	STACK_STATUS_EMPTY = 2
+	STACK_STATUS_EMPTY = 2,
+	STACK_STATUS_ALLOC = 3
 } stack_status;
 
 /**
@@ -74,6 +102,27 @@ stack stack_init(size_t type_size);
  */
 stack *stack_new(size_t type_size);
 
+/**
+ * @brief Create stack object on the stack with a custom allocator.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @param[in] allocator - Memory allocator, must outlive the stack.
+ * @return Stack object.
+ * @note Delete with stack_deinit.
+ */
+stack stack_init_alloc(size_t type_size, const stack_allocator *allocator);
+
+/**
+ * @brief Create stack object on the heap with a custom allocator.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @param[in] allocator - Memory allocator, must outlive the stack.
+ * @return Stack object, NULL if allocation failed.
+ * @note The object itself is also allocated with allocator.
+ * @note Delete with stack_delete.
+ */
+stack *stack_new_alloc(size_t type_size, const stack_allocator *allocator);
+
 /**
  * @brief Delete stack object from the stack.
  *
@@ -18,24 +18,44 @@
 // Pointer arithmetic for elements
 #define ptr_at(st, index) (st->_data + st->_type_size * (index))
 
+static void *mem_alloc(const stack_allocator *allocator, size_t size);
+static void *mem_resize(const stack_allocator *allocator,
+	void *ptr,
+	size_t old_size,
+	size_t new_size);
+static void mem_free(const stack_allocator *allocator, void *ptr, size_t size);
+
 stack stack_init(size_t type_size) {
+	return stack_init_alloc(type_size, NULL);
+}
+
+stack *stack_new(size_t type_size) {
+	return stack_new_alloc(type_size, NULL);
+}
+
+stack stack_init_alloc(size_t type_size, const stack_allocator *allocator) {
 	stack st = {
 		._data = NULL,
 		._type_size = type_size,
 		.count = 0,
 		._alloc_count = 0,
+		._allocator = allocator,
 	};
 
 	return st;
 }
 
-stack *stack_new(size_t type_size) {
-	stack *st = malloc(sizeof(stack));
+stack *stack_new_alloc(size_t type_size, const stack_allocator *allocator) {
+	stack *st = mem_alloc(allocator, sizeof(stack));
+	if (st == NULL) {
+		return NULL;
+	}
 
 	st->_data = NULL;
 	st->_type_size = type_size;
 	st->count = 0;
 	st->_alloc_count = 0;
+	st->_allocator = allocator;
 
 	return st;
 }
@@ -46,7 +66,7 @@ stack_status stack_deinit(stack *st) {
 	}
 
 	if (st->_data != NULL) {
-		free(st->_data);
+		mem_free(st->_allocator, st->_data, st->_type_size * st->_alloc_count);
 	}
 
 	return STACK_STATUS_OK;
@@ -57,7 +77,7 @@ stack_status stack_delete(stack *st) {
 		return STACK_STATUS_NULL;
 	}
 
-	free(st);
+	mem_free(st->_allocator, st, sizeof(stack));
 	return STACK_STATUS_OK;
 }
 
@@ -67,7 +87,13 @@ stack_status stack_reserve(stack *st, uint32_t count) {
 	}
 
 	if (count > st->_alloc_count) {
-		st->_data = realloc(st->_data, st->_type_size * count);
+		void *data = mem_resize(st->_allocator, st->_data,
+			st->_type_size * st->_alloc_count, st->_type_size * count);
+		if (data == NULL) {
+			return STACK_STATUS_ALLOC;
+		}
+
+		st->_data = data;
 		st->_alloc_count = count;
 	}
 
@@ -86,7 +112,9 @@ stack_status stack_push(stack *st, const void *value) {
 			? FACTOR
 			: st->_alloc_count * FACTOR;
 		// clang-format on
-		stack_reserve(st, new_count);
+		if (stack_reserve(st, new_count) != STACK_STATUS_OK) {
+			return STACK_STATUS_ALLOC;
+		}
 	}
 
 	// Copy element
@@ -122,3 +150,58 @@ const void *stack_peek(const stack *st) {
 
 	return ptr_at(st, st->count - 1);
 }
+
+/**
+ * @brief Allocate memory.
+ *
+ * @param[in] allocator - Custom allocator or NULL for libc.
+ * @param[in] size - Size in bytes.
+ * @return Allocated memory or NULL on failure.
+ */
+static void *mem_alloc(const stack_allocator *allocator, size_t size) {
+	if (allocator == NULL) {
+		return malloc(size);
+	}
+
+	return allocator->alloc(allocator->ctx, size);
+}
+
+/**
+ * @brief Resize memory, preserving contents.
+ *
+ * @param[in] allocator - Custom allocator or NULL for libc.
+ * @param[in] ptr - Existing allocation, may be NULL.
+ * @param[in] old_size - Current size in bytes.
+ * @param[in] new_size - Requested size in bytes.
+ * @return Resized memory or NULL on failure.
+ */
+static void *mem_resize(const stack_allocator *allocator,
+	void *ptr,
+	size_t old_size,
+	size_t new_size) {
+	if (allocator == NULL) {
+		return realloc(ptr, new_size);
+	}
+
+	if (ptr == NULL) {
+		return allocator->alloc(allocator->ctx, new_size);
+	}
+
+	return allocator->resize(allocator->ctx, ptr, old_size, new_size);
+}
+
+/**
+ * @brief Free memory.
+ *
+ * @param[in] allocator - Custom allocator or NULL for libc.
+ * @param[in] ptr - Allocation to free.
+ * @param[in] size - Size in bytes.
+ */
+static void mem_free(const stack_allocator *allocator, void *ptr, size_t size) {
+	if (allocator == NULL) {
+		free(ptr);
+		return;
+	}
+
+	allocator->release(allocator->ctx, ptr, size);
+}
@@ -9,6 +9,40 @@ static char element0 = '0';
 static char element1 = '1';
 static char element2 = '2';
 
+struct counting_ctx {
+	int allocs;
+	int frees;
+	bool fail;
+};
+
+static void *counting_alloc(void *ctx, size_t size) {
+	counting_ctx *counter = (counting_ctx *)ctx;
+	if (counter->fail) {
+		return nullptr;
+	}
+
+	counter->allocs++;
+	return malloc(size);
+}
+
+static void *counting_resize(
+	void *ctx, void *ptr, size_t old_size, size_t new_size) {
+	(void)old_size;
+	counting_ctx *counter = (counting_ctx *)ctx;
+	if (counter->fail) {
+		return nullptr;
+	}
+
+	return realloc(ptr, new_size);
+}
+
+static void counting_release(void *ctx, void *ptr, size_t size) {
+	(void)size;
+	counting_ctx *counter = (counting_ctx *)ctx;
+	counter->frees++;
+	free(ptr);
+}
+
 TEST(Stack, StackInitOk) {
 	stack st = stack_init(sizeof(char));
 
@@ -38,6 +72,7 @@ TEST(Stack, StackDeinitNullData) {
 		._data = nullptr,
 		._type_size = 1,
 		._alloc_count = 0,
+		._allocator = nullptr,
 	};
 
 	EXPECT_EQ(stack_deinit(&st), STACK_STATUS_OK);
@@ -49,6 +84,7 @@ TEST(Stack, StackDeinitOk) {
 		._data = malloc(8),
 		._type_size = 1,
 		._alloc_count = 8,
+		._allocator = nullptr,
 	};
 
 	EXPECT_EQ(stack_deinit(&st), STACK_STATUS_OK);
@@ -63,6 +99,7 @@ TEST(Stack, StackDeleteNullArg) {
 TEST(Stack, StackDeleteNullData) {
 	stack *st = (stack *)malloc(sizeof(stack));
 	st->_data = nullptr;
+	st->_allocator = nullptr;
 
 	EXPECT_EQ(stack_delete(st), STACK_STATUS_OK);
 }
@@ -70,6 +107,7 @@ TEST(Stack, StackDeleteNullData) {
 TEST(Stack, StackDeleteOk) {
 	stack *st = (stack *)malloc(sizeof(stack));
 	st->_data = malloc(8);
+	st->_allocator = nullptr;
 
 	EXPECT_EQ(stack_delete(st), STACK_STATUS_OK);
 }
@@ -86,6 +124,7 @@ TEST(Stack, StackReserveEmpty) {
 		._data = nullptr,
 		._type_size = 1,
 		._alloc_count = 0,
+		._allocator = nullptr,
 	};
 
 	EXPECT_EQ(stack_reserve(&st, 6), STACK_STATUS_OK);
@@ -101,6 +140,7 @@ TEST(Stack, StackReserveOk) {
 		._data = malloc(8),
 		._type_size = 1,
 		._alloc_count = 8,
+		._allocator = nullptr,
 	};
 
 	// Less than allocated
@@ -130,6 +170,7 @@ TEST(Stack, StackPushOk) {
 		._data = nullptr,
 		._type_size = sizeof(char),
 		._alloc_count = 0,
+		._allocator = nullptr,
 	};
 
 	EXPECT_EQ(stack_push(&st, &element0), STACK_STATUS_OK);
@@ -164,6 +205,7 @@ TEST(Stack, StackPopEmpty) {
 		._data = nullptr,
 		._type_size = sizeof(char),
 		._alloc_count = 0,
+		._allocator = nullptr,
 	};
 
 	EXPECT_EQ(stack_pop(&st, nullptr), STACK_STATUS_EMPTY);
@@ -175,6 +217,7 @@ TEST(Stack, StackPopNullBuffer) {
 		._data = malloc(sizeof(char) * 1),
 		._type_size = sizeof(char),
 		._alloc_count = 1,
+		._allocator = nullptr,
 	};
 
 	*((char *)st._data) = element0;
@@ -191,6 +234,7 @@ TEST(Stack, StackPopOk) {
 		._data = malloc(sizeof(char) * 3),
 		._type_size = sizeof(char),
 		._alloc_count = 3,
+		._allocator = nullptr,
 	};
 
 	*((char *)st._data) = element0;
@@ -222,6 +266,7 @@ TEST(Stack, StackPopOkMultibyte) {
 		._data = malloc(sizeof(int) * 3),
 		._type_size = sizeof(int),
 		._alloc_count = 3,
+		._allocator = nullptr,
 	};
 
 	*((int *)st._data) = element0;
@@ -259,6 +304,7 @@ TEST(Stack, StackPeekEmpty) {
 		._data = nullptr,
 		._type_size = sizeof(char),
 		._alloc_count = 0,
+		._allocator = nullptr,
 	};
 
 	EXPECT_EQ(stack_peek(&st), nullptr);
@@ -270,6 +316,7 @@ TEST(Stack, StackPeekOk) {
 		._data = malloc(sizeof(char) * 2),
 		._type_size = sizeof(char),
 		._alloc_count = 2,
+		._allocator = nullptr,
 	};
 
 	*((char *)st._data) = element0;
@@ -283,6 +330,72 @@ TEST(Stack, StackPeekOk) {
 	free(st._data);
 }
 
+TEST(Stack, StackInitAllocOk) {
+	counting_ctx counter = { 0, 0, false };
+	stack_allocator allocator = {
+		.alloc = counting_alloc,
+		.resize = counting_resize,
+		.release = counting_release,
+		.ctx = &counter,
+	};
+
+	stack st = stack_init_alloc(sizeof(char), &allocator);
+	EXPECT_EQ(st._data, nullptr);
+	EXPECT_EQ(st._allocator, &allocator);
+
+	EXPECT_EQ(stack_push(&st, &element0), STACK_STATUS_OK);
+	EXPECT_EQ(stack_push(&st, &element1), STACK_STATUS_OK);
+	EXPECT_EQ(stack_push(&st, &element2), STACK_STATUS_OK);
+	EXPECT_EQ(counter.allocs, 1);
+
+	EXPECT_EQ(stack_deinit(&st), STACK_STATUS_OK);
+	EXPECT_EQ(counter.frees, 1);
+}
+
+TEST(Stack, StackNewAllocOk) {
+	counting_ctx counter = { 0, 0, false };
+	stack_allocator allocator = {
+		.alloc = counting_alloc,
+		.resize = counting_resize,
+		.release = counting_release,
+		.ctx = &counter,
+	};
+
+	stack *st = stack_new_alloc(sizeof(char), &allocator);
+	EXPECT_NE(st, nullptr);
+	EXPECT_EQ(counter.allocs, 1);
+
+	EXPECT_EQ(stack_push(st, &element0), STACK_STATUS_OK);
+	EXPECT_EQ(counter.allocs, 2);
+
+	EXPECT_EQ(stack_delete(st), STACK_STATUS_OK);
+	EXPECT_EQ(counter.frees, 2);
+}
+
+TEST(Stack, StackAllocFail) {
+	counting_ctx counter = { 0, 0, false };
+	stack_allocator allocator = {
+		.alloc = counting_alloc,
+		.resize = counting_resize,
+		.release = counting_release,
+		.ctx = &counter,
+	};
+
+	stack st = stack_init_alloc(sizeof(char), &allocator);
+	EXPECT_EQ(stack_push(&st, &element0), STACK_STATUS_OK);
+	EXPECT_EQ(stack_push(&st, &element1), STACK_STATUS_OK);
+
+	// Existing data is kept on failure
+	counter.fail = true;
+	EXPECT_EQ(stack_push(&st, &element2), STACK_STATUS_ALLOC);
+	EXPECT_EQ(st.count, 2);
+	EXPECT_EQ(*((char *)st._data), element0);
+	EXPECT_EQ(*((char *)st._data + 1), element1);
+
+	EXPECT_EQ(stack_deinit(&st), STACK_STATUS_OK);
+	EXPECT_EQ(counter.frees, 1);
+}
+
 TEST(Stack, FullTest) {
 	stack *st = stack_new(sizeof(char));
 
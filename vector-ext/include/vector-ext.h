@@ -8,6 +8,8 @@
  */
 #pragma once
 
+#include <stdbool.h>
+
 #include <c-utils/vector.h>
 
 /**
@@ -18,7 +20,7 @@
  * @param[in] count - Count of elements to push.
  * @return Status code.
  */
-vector_status vec_bulk_push(vector *vec, const void *items, uint32_t count);
+vector_status vec_bulk_push(vector *vec, const void *items, size_t count);
 
 /**
  * @brief Add multiple elements at specified location.
@@ -30,7 +32,7 @@ vector_status vec_bulk_push(vector *vec, const void *items, uint32_t count);
  * @return Status code.
  */
 vector_status vec_bulk_insert(
-	vector *vec, uint32_t index, const void *items, uint32_t count);
+	vector *vec, size_t index, const void *items, size_t count);
 
 /**
  * @brief Remove multiple elements at specified location.
@@ -42,4 +44,243 @@ vector_status vec_bulk_insert(
  * @return Status code.
  */
 vector_status vec_bulk_erase(
-	vector *vec, uint32_t index, void *buffer, uint32_t count);
+	vector *vec, size_t index, void *buffer, size_t count);
+
+/**
+ * @brief Sort elements using a comparison function.
+ *
+ * Introsort: quicksort with median-of-three pivots, heapsort once recursion
+ * gets too deep and insertion sort for short ranges. Not stable.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] cmp - Comparison function, as used by qsort.
+ * @return Status code.
+ */
+vector_status vec_sort(
+	vector *vec, int (*cmp)(const void *lhs, const void *rhs));
+
+/**
+ * @brief Sort a vector of uint32_t with radix sort.
+ *
+ * @param[in,out] vec - Vector object.
+ * @return Status code.
+ * @note Element size must be sizeof(uint32_t).
+ */
+vector_status vec_sort_u32(vector *vec);
+
+/**
+ * @brief Sort a vector of uint64_t with radix sort.
+ *
+ * @param[in,out] vec - Vector object.
+ * @return Status code.
+ * @note Element size must be sizeof(uint64_t).
+ */
+vector_status vec_sort_u64(vector *vec);
+
+/**
+ * @brief Sort elements by a uint32_t key field with radix sort.
+ *
+ * Stable LSD radix sort, one pass per key byte. Passes where every key has
+ * the same byte are skipped.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] key_offset - Offset of the key inside an element.
+ * @return Status code.
+ * @note Needs a temporary buffer of the vector's size.
+ */
+vector_status vec_sort_key_u32(vector *vec, size_t key_offset);
+
+/**
+ * @brief Sort elements by a uint64_t key field with radix sort.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] key_offset - Offset of the key inside an element.
+ * @return Status code.
+ * @note See vec_sort_key_u32.
+ */
+vector_status vec_sort_key_u64(vector *vec, size_t key_offset);
+
+/**
+ * @brief Sort elements on multiple threads.
+ *
+ * Sample sort: elements are distributed into one bucket per thread using
+ * sampled splitters, then every bucket is sorted on its own thread. Keys that
+ * repeat across several splitters are spread over those buckets, so inputs
+ * with few distinct keys are still split between threads. Short vectors are
+ * sorted on the calling thread.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] cmp - Comparison function, as used by qsort. Called
+ * concurrently.
+ * @param[in] thread_count - Maximum amount of threads.
+ * @param[in] stable - Keep order of equal elements.
+ * @return Status code.
+ * @note Needs a temporary buffer of the vector's size.
+ */
+vector_status vec_sort_parallel(vector *vec,
+	int (*cmp)(const void *lhs, const void *rhs),
+	size_t thread_count,
+	bool stable);
+
+/**
+ * @brief Find first element not less than a key in a sorted vector.
+ *
+ * Branchless binary search.
+ *
+ * @param[in] vec - Vector object, sorted by cmp.
+ * @param[in] key - Key to search for.
+ * @param[in] cmp - Comparison function, called as cmp(element, key).
+ * @return Element index, count if every element is less than key.
+ * @note Returns 0 if vec is NULL.
+ */
+size_t vec_lower_bound(const vector *vec,
+	const void *key,
+	int (*cmp)(const void *lhs, const void *rhs));
+
+/**
+ * @brief Find first element greater than a key in a sorted vector.
+ *
+ * @param[in] vec - Vector object, sorted by cmp.
+ * @param[in] key - Key to search for.
+ * @param[in] cmp - Comparison function, called as cmp(element, key).
+ * @return Element index, count if no element is greater than key.
+ * @note Returns 0 if vec is NULL.
+ */
+size_t vec_upper_bound(const vector *vec,
+	const void *key,
+	int (*cmp)(const void *lhs, const void *rhs));
+
+/**
+ * @brief Insert element into a sorted vector, keeping it sorted.
+ *
+ * @param[in,out] vec - Vector object, sorted by cmp.
+ * @param[in] value - New element, placed after equal elements.
+ * @param[in] cmp - Comparison function.
+ * @return Status code.
+ */
+vector_status vec_insert_sorted(vector *vec,
+	const void *value,
+	int (*cmp)(const void *lhs, const void *rhs));
+
+/**
+ * @brief Remove first element equal to a key from a sorted vector.
+ *
+ * @param[in,out] vec - Vector object, sorted by cmp.
+ * @param[in] key - Key to search for.
+ * @param[out] buffer - If not NULL, erased value placed here.
+ * @param[in] cmp - Comparison function, called as cmp(element, key).
+ * @return Status code, VECTOR_STATUS_BOUNDS if no element matches.
+ */
+vector_status vec_erase_sorted(vector *vec,
+	const void *key,
+	void *buffer,
+	int (*cmp)(const void *lhs, const void *rhs));
+
+/**
+ * @brief Reorder a sorted vector into Eytzinger (BFS) layout.
+ *
+ * Element i holds the node i + 1 of an implicit binary search tree, so the
+ * first levels of every search share cache lines and the next levels can be
+ * prefetched. Search with vec_eytzinger_search.
+ *
+ * @param[in,out] vec - Vector object, sorted.
+ * @return Status code.
+ * @note Intended for read-only tables, the vector is no longer sorted.
+ */
+vector_status vec_eytzinger_build(vector *vec);
+
+/**
+ * @brief Find first element not less than a key in Eytzinger layout.
+ *
+ * @param[in] vec - Vector object, built with vec_eytzinger_build.
+ * @param[in] key - Key to search for.
+ * @param[in] cmp - Comparison function, called as cmp(element, key).
+ * @return Element index, count if every element is less than key.
+ * @note Returns 0 if vec is NULL.
+ */
+size_t vec_eytzinger_search(const vector *vec,
+	const void *key,
+	int (*cmp)(const void *lhs, const void *rhs));
+
+/**
+ * @brief Intersection of two sorted sets.
+ *
+ * Elements are uint32_t or uint64_t, sorted and without duplicates. A much
+ * smaller input is looked up in the larger one with galloping search.
+ * Similarly sized uint32_t inputs are compared in blocks of 4 with SSE2 when
+ * the library is built for it, uint64_t inputs with a scalar merge.
+ *
+ * @param[in] lhs - Vector object, sorted set.
+ * @param[in] rhs - Vector object, sorted set.
+ * @param[out] out - Result vector, old contents are replaced.
+ * @return Status code, VECTOR_STATUS_BOUNDS if element sizes differ, are not
+ * 4 or 8 bytes, or out is one of the inputs.
+ */
+vector_status vec_set_intersect(
+	const vector *lhs, const vector *rhs, vector *out);
+
+/**
+ * @brief Union of two sorted sets.
+ *
+ * A much smaller input is galloped through the larger one, otherwise the
+ * inputs are combined with a scalar merge. There is no SIMD path.
+ *
+ * @param[in] lhs - Vector object, sorted set.
+ * @param[in] rhs - Vector object, sorted set.
+ * @param[out] out - Result vector, old contents are replaced.
+ * @return Status code, see vec_set_intersect.
+ */
+vector_status vec_set_union(const vector *lhs, const vector *rhs, vector *out);
+
+/**
+ * @brief Elements of lhs that are not in rhs.
+ *
+ * Uses the same strategies as vec_set_intersect.
+ *
+ * @param[in] lhs - Vector object, sorted set.
+ * @param[in] rhs - Vector object, sorted set.
+ * @param[out] out - Result vector, old contents are replaced.
+ * @return Status code, see vec_set_intersect.
+ */
+vector_status vec_set_difference(
+	const vector *lhs, const vector *rhs, vector *out);
+
+/**
+ * @brief Merge two sorted vectors, keeping duplicates.
+ *
+ * Uses the same strategies as vec_set_union, there is no SIMD path.
+ *
+ * @param[in] lhs - Vector object, sorted.
+ * @param[in] rhs - Vector object, sorted.
+ * @param[out] out - Result vector, old contents are replaced.
+ * @return Status code, see vec_set_intersect.
+ */
+vector_status vec_set_merge(const vector *lhs, const vector *rhs, vector *out);
+
+/**
+ * @brief Select elements by index, dst[i] = src[indices[i]].
+ *
+ * Sources are prefetched ahead of the copies. On x86 CPUs with AVX2, 4 and 8
+ * byte elements use hardware gather, detected at run time.
+ *
+ * @param[out] dst - Result vector, old contents are replaced.
+ * @param[in] src - Vector object.
+ * @param[in] indices - Vector of uint32_t indices into src.
+ * @return Status code, VECTOR_STATUS_BOUNDS if element sizes differ, an index
+ * is out of range, or dst is one of the inputs.
+ */
+vector_status vec_gather(
+	vector *dst, const vector *src, const vector *indices);
+
+/**
+ * @brief Place elements by index, dst[indices[i]] = src[i].
+ *
+ * @param[in,out] dst - Vector object, count is not changed.
+ * @param[in] src - Vector object, one element per index.
+ * @param[in] indices - Vector of uint32_t indices into dst.
+ * @return Status code, VECTOR_STATUS_BOUNDS if element or index counts
+ * differ, an index is out of range, or dst is one of the inputs.
+ * @note For repeated indices, the last element is kept.
+ */
+vector_status vec_scatter(
+	vector *dst, const vector *src, const vector *indices);
@@ -0,0 +1,355 @@
+/**
+ * @file gather.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0.1
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Gather and scatter by index vector.
+ */
+#include "vector-ext.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <c-utils/vector.h>
+
+// AVX2 gather is compiled for x86 and selected at run time
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define HAVE_AVX2_GATHER 1
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define HAVE_AVX2_GATHER 0
+#endif
+
+// Elements ahead of the current one to prefetch
+#define PREFETCH_DISTANCE 16
+
+typedef void (*permute_fn)(uint8_t *dst,
+	const uint8_t *src,
+	const uint32_t *indices,
+	size_t count);
+
+static vector_status check_indices(const vector *indices, size_t limit);
+static permute_fn select_permute(size_t size, int scatter);
+static void gather_any(uint8_t *dst,
+	const uint8_t *src,
+	const uint32_t *indices,
+	size_t count,
+	size_t size);
+static void scatter_any(uint8_t *dst,
+	const uint8_t *src,
+	const uint32_t *indices,
+	size_t count,
+	size_t size);
+#if HAVE_AVX2_GATHER
+static int cpu_has_avx2(void);
+TARGET_AVX2 static size_t gather_avx2_4(uint8_t *dst,
+	const uint8_t *src,
+	const uint32_t *indices,
+	size_t count);
+TARGET_AVX2 static size_t gather_avx2_8(uint8_t *dst,
+	const uint8_t *src,
+	const uint32_t *indices,
+	size_t count);
+#endif
+
+/**
+ * @def DEFINE_PERMUTE(N)
+ * Define gather_N and scatter_N for N byte elements.
+ *
+ * Copies have a constant size, so they compile to plain loads and stores.
+ * The element PREFETCH_DISTANCE positions ahead is prefetched, which keeps
+ * several cache misses in flight for random indices.
+ */
+#define DEFINE_PERMUTE(N)                                                      \
+	static void gather_##N(uint8_t *dst,                                       \
+		const uint8_t *src,                                                    \
+		const uint32_t *indices,                                               \
+		size_t count) {                                                        \
+		for (size_t i = 0; i < count; i++) {                                   \
+			if (i + PREFETCH_DISTANCE < count) {                               \
+				__builtin_prefetch(                                            \
+					src + (size_t)indices[i + PREFETCH_DISTANCE] * N);         \
+			}                                                                  \
+			memcpy(dst + i * N, src + (size_t)indices[i] * N, N);              \
+		}                                                                      \
+	}                                                                          \
+                                                                               \
+	static void scatter_##N(uint8_t *dst,                                      \
+		const uint8_t *src,                                                    \
+		const uint32_t *indices,                                               \
+		size_t count) {                                                        \
+		for (size_t i = 0; i < count; i++) {                                   \
+			if (i + PREFETCH_DISTANCE < count) {                               \
+				__builtin_prefetch(                                            \
+					dst + (size_t)indices[i + PREFETCH_DISTANCE] * N, 1);      \
+			}                                                                  \
+			memcpy(dst + (size_t)indices[i] * N, src + i * N, N);              \
+		}                                                                      \
+	}
+
+DEFINE_PERMUTE(1)
+DEFINE_PERMUTE(2)
+DEFINE_PERMUTE(4)
+DEFINE_PERMUTE(8)
+DEFINE_PERMUTE(16)
+
+vector_status vec_gather(
+	vector *dst, const vector *src, const vector *indices) {
+	if (dst == NULL || src == NULL || indices == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (dst->_type_size != src->_type_size || dst == src || dst == indices) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	vector_status status = check_indices(indices, src->count);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	// Old contents are dropped, so nothing is copied if shared
+	dst->count = 0;
+	status = vec_unshare(dst);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	status = vec_reserve(dst, indices->count);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	size_t size = src->_type_size;
+	uint8_t *out = dst->data;
+	const uint32_t *index = indices->data;
+	size_t count = indices->count;
+	size_t done = 0;
+
+#if HAVE_AVX2_GATHER
+	// Hardware gather takes signed 32-bit indices
+	if (src->count <= INT32_MAX && cpu_has_avx2()) {
+		if (size == 4) {
+			done = gather_avx2_4(out, src->data, index, count);
+		} else if (size == 8) {
+			done = gather_avx2_8(out, src->data, index, count);
+		}
+	}
+#endif
+
+	permute_fn gather = select_permute(size, 0);
+	if (gather != NULL) {
+		gather(out + done * size, src->data, index + done, count - done);
+	} else {
+		gather_any(out, src->data, index, count, size);
+	}
+
+	dst->count = count;
+	return VECTOR_STATUS_OK;
+}
+
+vector_status vec_scatter(
+	vector *dst, const vector *src, const vector *indices) {
+	if (dst == NULL || src == NULL || indices == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (dst->_type_size != src->_type_size || src->count != indices->count
+		|| dst == src || dst == indices) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	vector_status status = check_indices(indices, dst->count);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	status = vec_unshare(dst);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	size_t size = src->_type_size;
+	permute_fn scatter = select_permute(size, 1);
+	if (scatter != NULL) {
+		scatter(dst->data, src->data, indices->data, indices->count);
+	} else {
+		scatter_any(dst->data, src->data, indices->data, indices->count, size);
+	}
+
+	return VECTOR_STATUS_OK;
+}
+
+/**
+ * @brief Check that an index vector only holds valid indices.
+ *
+ * @param[in] indices - Vector of uint32_t indices.
+ * @param[in] limit - Element count of the indexed vector.
+ * @return Status code.
+ */
+static vector_status check_indices(const vector *indices, size_t limit) {
+	if (indices->_type_size != sizeof(uint32_t)) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	// Sequential pass, cheap compared to the random accesses
+	const uint32_t *index = indices->data;
+	uint32_t max = 0;
+	for (size_t i = 0; i < indices->count; i++) {
+		max = (index[i] > max) ? index[i] : max;
+	}
+
+	if (indices->count > 0 && max >= limit) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	return VECTOR_STATUS_OK;
+}
+
+/**
+ * @brief Get copy loop specialized for an element size.
+ *
+ * @param[in] size - Element size.
+ * @param[in] scatter - Get scatter loop instead of gather loop.
+ * @return Copy loop, NULL if not specialized.
+ */
+static permute_fn select_permute(size_t size, int scatter) {
+	switch (size) {
+	case 1:
+		return scatter ? scatter_1 : gather_1;
+	case 2:
+		return scatter ? scatter_2 : gather_2;
+	case 4:
+		return scatter ? scatter_4 : gather_4;
+	case 8:
+		return scatter ? scatter_8 : gather_8;
+	case 16:
+		return scatter ? scatter_16 : gather_16;
+	default:
+		return NULL;
+	}
+}
+
+/**
+ * @brief Gather elements of any size.
+ *
+ * @param[out] dst - Destination array.
+ * @param[in] src - Source array.
+ * @param[in] indices - Source index for each destination element.
+ * @param[in] count - Amount of indices.
+ * @param[in] size - Element size.
+ */
+static void gather_any(uint8_t *dst,
+	const uint8_t *src,
+	const uint32_t *indices,
+	size_t count,
+	size_t size) {
+	for (size_t i = 0; i < count; i++) {
+		if (i + PREFETCH_DISTANCE < count) {
+			__builtin_prefetch(
+				src + (size_t)indices[i + PREFETCH_DISTANCE] * size);
+		}
+		memcpy(dst + i * size, src + (size_t)indices[i] * size, size);
+	}
+}
+
+/**
+ * @brief Scatter elements of any size.
+ *
+ * @param[out] dst - Destination array.
+ * @param[in] src - Source array.
+ * @param[in] indices - Destination index for each source element.
+ * @param[in] count - Amount of indices.
+ * @param[in] size - Element size.
+ */
+static void scatter_any(uint8_t *dst,
+	const uint8_t *src,
+	const uint32_t *indices,
+	size_t count,
+	size_t size) {
+	for (size_t i = 0; i < count; i++) {
+		if (i + PREFETCH_DISTANCE < count) {
+			__builtin_prefetch(
+				dst + (size_t)indices[i + PREFETCH_DISTANCE] * size, 1);
+		}
+		memcpy(dst + (size_t)indices[i] * size, src + i * size, size);
+	}
+}
+
+#if HAVE_AVX2_GATHER
+/**
+ * @brief Check for AVX2 support.
+ *
+ * @return Non-zero if AVX2 instructions can be used.
+ */
+static int cpu_has_avx2(void) {
+#ifdef __AVX2__
+	return 1;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+/**
+ * @brief Gather 4 byte elements 8 at a time with AVX2.
+ *
+ * @param[out] dst - Destination array.
+ * @param[in] src - Source array, fewer than 2^31 elements.
+ * @param[in] indices - Source index for each destination element.
+ * @param[in] count - Amount of indices.
+ * @return Amount of elements gathered, the rest is left to the caller.
+ */
+TARGET_AVX2 static size_t gather_avx2_4(uint8_t *dst,
+	const uint8_t *src,
+	const uint32_t *indices,
+	size_t count) {
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		if (i + PREFETCH_DISTANCE + 8 <= count) {
+			for (size_t k = 0; k < 8; k++) {
+				__builtin_prefetch(
+					src + (size_t)indices[i + PREFETCH_DISTANCE + k] * 4);
+			}
+		}
+
+		__m256i index = _mm256_loadu_si256((const __m256i *)(indices + i));
+		__m256i values = _mm256_i32gather_epi32((const int *)src, index, 4);
+		_mm256_storeu_si256((__m256i *)(dst + i * 4), values);
+	}
+
+	return i;
+}
+
+/**
+ * @brief Gather 8 byte elements 4 at a time with AVX2.
+ *
+ * @param[out] dst - Destination array.
+ * @param[in] src - Source array, fewer than 2^31 elements.
+ * @param[in] indices - Source index for each destination element.
+ * @param[in] count - Amount of indices.
+ * @return Amount of elements gathered, the rest is left to the caller.
+ */
+TARGET_AVX2 static size_t gather_avx2_8(uint8_t *dst,
+	const uint8_t *src,
+	const uint32_t *indices,
+	size_t count) {
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		if (i + PREFETCH_DISTANCE + 4 <= count) {
+			for (size_t k = 0; k < 4; k++) {
+				__builtin_prefetch(
+					src + (size_t)indices[i + PREFETCH_DISTANCE + k] * 8);
+			}
+		}
+
+		__m128i index = _mm_loadu_si128((const __m128i *)(indices + i));
+		__m256i values
+			= _mm256_i32gather_epi64((const long long *)src, index, 8);
+		_mm256_storeu_si256((__m256i *)(dst + i * 8), values);
+	}
+
+	return i;
+}
+#endif
@@ -0,0 +1,361 @@
+/**
+ * @file parallel.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0.1
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Parallel vector sorting.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "vector-ext.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <c-utils/vector.h>
+
+#include "sort.h"
+
+// Vectors shorter than this are sorted on the calling thread
+#define PARALLEL_THRESHOLD (64 * 1024)
+
+// Smallest chunk worth a thread
+#define MIN_CHUNK 4096
+
+// Samples taken per bucket when choosing splitters
+#define OVERSAMPLE 32
+
+// Pointer arithmetic for elements
+#define elem_at(base, size, index) ((char *)(base) + (size) * (index))
+
+/**
+ * State shared by all sorting threads.
+ */
+typedef struct {
+	char *data;
+	char *tmp;
+	size_t count;
+	size_t size;
+	compare_fn cmp;
+	bool stable;
+
+	size_t thread_count;
+	const char *splitters;
+	size_t *bucket_counts; // [thread][bucket]
+	size_t *bucket_offsets; // [thread][bucket]
+	size_t *bucket_starts; // [bucket + 1]
+} sort_ctx;
+
+/**
+ * Work item of one thread.
+ */
+typedef struct {
+	sort_ctx *ctx;
+	size_t id;
+	pthread_t thread;
+	bool started;
+} sort_task;
+
+static vector_status sort_sequential(vector *vec, compare_fn cmp, bool stable);
+static void run_phase(sort_task *tasks, size_t count, void *(*phase)(void *));
+static void *count_phase(void *arg);
+static void *scatter_phase(void *arg);
+static void *sort_phase(void *arg);
+static size_t bucket_of(const sort_ctx *ctx, const void *elem, size_t id);
+static size_t splitter_bound(const sort_ctx *ctx, const void *elem,
+	bool strict);
+static size_t chunk_start(const sort_ctx *ctx, size_t id);
+
+vector_status vec_sort_parallel(vector *vec,
+	int (*cmp)(const void *lhs, const void *rhs),
+	size_t thread_count,
+	bool stable) {
+	if (vec == NULL || cmp == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (thread_count <= 1 || vec->count < PARALLEL_THRESHOLD) {
+		return sort_sequential(vec, cmp, stable);
+	}
+
+	vector_status status = vec_unshare(vec);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	size_t count = vec->count;
+	size_t size = vec->_type_size;
+	if (thread_count > count / MIN_CHUNK) {
+		thread_count = count / MIN_CHUNK;
+	}
+
+	size_t sample_count = thread_count * OVERSAMPLE;
+	size_t cell_count = thread_count * thread_count;
+
+	char *tmp = malloc(size * count);
+	char *samples = malloc(size * sample_count);
+	size_t *counts = calloc(cell_count, sizeof(size_t));
+	size_t *offsets = malloc(sizeof(size_t) * cell_count);
+	size_t *starts = malloc(sizeof(size_t) * (thread_count + 1));
+	sort_task *tasks = malloc(sizeof(sort_task) * thread_count);
+	if (tmp == NULL || samples == NULL || counts == NULL || offsets == NULL
+		|| starts == NULL || tasks == NULL) {
+		free(tmp);
+		free(samples);
+		free(counts);
+		free(offsets);
+		free(starts);
+		free(tasks);
+		return VECTOR_STATUS_ALLOC;
+	}
+
+	// Evenly spaced samples give thread_count - 1 splitters
+	for (size_t i = 0; i < sample_count; i++) {
+		memcpy(elem_at(samples, size, i),
+			elem_at(vec->data, size, i * (count / sample_count)), size);
+	}
+	vec_sort_range(samples, sample_count, size, cmp);
+
+	size_t splitter_count = thread_count - 1;
+	for (size_t i = 0; i < splitter_count; i++) {
+		memcpy(elem_at(samples, size, i),
+			elem_at(samples, size, (i + 1) * OVERSAMPLE), size);
+	}
+
+	sort_ctx ctx = {
+		.data = vec->data,
+		.tmp = tmp,
+		.count = count,
+		.size = size,
+		.cmp = cmp,
+		.stable = stable,
+		.thread_count = thread_count,
+		.splitters = samples,
+		.bucket_counts = counts,
+		.bucket_offsets = offsets,
+		.bucket_starts = starts,
+	};
+
+	for (size_t i = 0; i < thread_count; i++) {
+		tasks[i].ctx = &ctx;
+		tasks[i].id = i;
+	}
+
+	run_phase(tasks, thread_count, count_phase);
+
+	// Buckets are laid out in order, each split by source thread
+	size_t offset = 0;
+	for (size_t bucket = 0; bucket < thread_count; bucket++) {
+		starts[bucket] = offset;
+		for (size_t thread = 0; thread < thread_count; thread++) {
+			size_t cell = thread * thread_count + bucket;
+			offsets[cell] = offset;
+			offset += counts[cell];
+		}
+	}
+	starts[thread_count] = offset;
+
+	run_phase(tasks, thread_count, scatter_phase);
+	run_phase(tasks, thread_count, sort_phase);
+
+	free(tmp);
+	free(samples);
+	free(counts);
+	free(offsets);
+	free(starts);
+	free(tasks);
+
+	return VECTOR_STATUS_OK;
+}
+
+/**
+ * @brief Sort on the calling thread.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] cmp - Comparison function.
+ * @param[in] stable - Keep order of equal elements.
+ * @return Status code.
+ */
+static vector_status sort_sequential(vector *vec, compare_fn cmp, bool stable) {
+	if (!stable) {
+		return vec_sort(vec, cmp);
+	}
+
+	if (vec->count < 2) {
+		return VECTOR_STATUS_OK;
+	}
+
+	vector_status status = vec_unshare(vec);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	void *scratch = malloc(vec->_type_size * vec->count);
+	if (scratch == NULL) {
+		return VECTOR_STATUS_ALLOC;
+	}
+
+	vec_sort_stable_range(vec->data, scratch, vec->count, vec->_type_size,
+		cmp);
+
+	free(scratch);
+	return VECTOR_STATUS_OK;
+}
+
+/**
+ * @brief Run one phase on every thread and wait for it to finish.
+ *
+ * @param[in,out] tasks - One task per thread.
+ * @param[in] count - Amount of tasks.
+ * @param[in] phase - Thread function, called with a sort_task.
+ * @note Tasks that fail to start a thread run on the calling thread.
+ */
+static void run_phase(sort_task *tasks, size_t count, void *(*phase)(void *)) {
+	for (size_t i = 0; i < count; i++) {
+		tasks[i].started
+			= pthread_create(&tasks[i].thread, NULL, phase, &tasks[i]) == 0;
+		if (!tasks[i].started) {
+			phase(&tasks[i]);
+		}
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (tasks[i].started) {
+			pthread_join(tasks[i].thread, NULL);
+		}
+	}
+}
+
+/**
+ * @brief Count elements of a thread's chunk per bucket.
+ *
+ * @param[in] arg - Sort task.
+ * @return NULL.
+ */
+static void *count_phase(void *arg) {
+	sort_task *task = arg;
+	sort_ctx *ctx = task->ctx;
+	size_t *counts = ctx->bucket_counts + task->id * ctx->thread_count;
+
+	size_t end = chunk_start(ctx, task->id + 1);
+	for (size_t i = chunk_start(ctx, task->id); i < end; i++) {
+		counts[bucket_of(ctx, elem_at(ctx->data, ctx->size, i), task->id)]++;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Move elements of a thread's chunk into their buckets.
+ *
+ * Elements keep their relative order, so the distribution is stable.
+ *
+ * @param[in] arg - Sort task.
+ * @return NULL.
+ */
+static void *scatter_phase(void *arg) {
+	sort_task *task = arg;
+	sort_ctx *ctx = task->ctx;
+	size_t *offsets = ctx->bucket_offsets + task->id * ctx->thread_count;
+
+	size_t end = chunk_start(ctx, task->id + 1);
+	for (size_t i = chunk_start(ctx, task->id); i < end; i++) {
+		const char *elem = elem_at(ctx->data, ctx->size, i);
+		size_t bucket = bucket_of(ctx, elem, task->id);
+		memcpy(elem_at(ctx->tmp, ctx->size, offsets[bucket]++), elem,
+			ctx->size);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Sort one bucket back into the vector.
+ *
+ * @param[in] arg - Sort task, id is the bucket.
+ * @return NULL.
+ */
+static void *sort_phase(void *arg) {
+	sort_task *task = arg;
+	sort_ctx *ctx = task->ctx;
+
+	size_t start = ctx->bucket_starts[task->id];
+	size_t count = ctx->bucket_starts[task->id + 1] - start;
+
+	char *src = elem_at(ctx->tmp, ctx->size, start);
+	char *dst = elem_at(ctx->data, ctx->size, start);
+	if (ctx->stable) {
+		vec_sort_stable_range(src, dst, count, ctx->size, ctx->cmp);
+	} else {
+		vec_sort_range(src, count, ctx->size, ctx->cmp);
+	}
+
+	memcpy(dst, src, ctx->size * count);
+	return NULL;
+}
+
+/**
+ * @brief Find bucket of an element.
+ *
+ * An element equal to a run of splitters may go to any bucket from the one
+ * before the run to the one after it. Each source thread picks one of them,
+ * in thread order, so equal keys are spread across threads and stay stable.
+ *
+ * @param[in] ctx - Sorting state.
+ * @param[in] elem - Element.
+ * @param[in] id - Source thread index.
+ * @return Bucket index.
+ */
+static size_t bucket_of(const sort_ctx *ctx, const void *elem, size_t id) {
+	size_t upper = splitter_bound(ctx, elem, false);
+	if (upper == 0
+		|| ctx->cmp(elem_at(ctx->splitters, ctx->size, upper - 1), elem) != 0) {
+		return upper;
+	}
+
+	size_t lower = splitter_bound(ctx, elem, true);
+	size_t span = upper - lower + 1;
+	return lower + id * span / ctx->thread_count;
+}
+
+/**
+ * @brief Count splitters ordered before an element.
+ *
+ * @param[in] ctx - Sorting state.
+ * @param[in] elem - Element.
+ * @param[in] strict - Count only splitters less than the element, instead of
+ * not greater than it.
+ * @return Amount of splitters.
+ */
+static size_t splitter_bound(const sort_ctx *ctx, const void *elem,
+	bool strict) {
+	size_t low = 0;
+	size_t high = ctx->thread_count - 1;
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+		int order = ctx->cmp(elem_at(ctx->splitters, ctx->size, mid), elem);
+		if (order < 0 || (!strict && order == 0)) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+/**
+ * @brief Get first element of a thread's input chunk.
+ *
+ * @param[in] ctx - Sorting state.
+ * @param[in] id - Thread index, up to thread_count.
+ * @return Element index.
+ */
+static size_t chunk_start(const sort_ctx *ctx, size_t id) {
+	return ctx->count / ctx->thread_count * id
+		+ (id == ctx->thread_count ? ctx->count % ctx->thread_count : 0);
+}
@@ -0,0 +1,190 @@
+/**
+ * @file search.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0.1
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Sorted vector search functions.
+ */
+#include "vector-ext.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <c-utils/vector.h>
+
+#include "sort.h"
+
+// Eytzinger nodes this many levels down are prefetched (2^4 = 16 nodes)
+#define PREFETCH_LEVELS 4
+
+// Pointer arithmetic for elements
+#define elem_at(base, size, index) ((char *)(base) + (size) * (index))
+
+static size_t bound(const vector *vec,
+	const void *key,
+	compare_fn cmp,
+	int threshold);
+static size_t eytzinger_fill(char *dst,
+	const char *src,
+	size_t size,
+	size_t count,
+	size_t node,
+	size_t next);
+
+size_t vec_lower_bound(const vector *vec,
+	const void *key,
+	int (*cmp)(const void *lhs, const void *rhs)) {
+	// Elements less than key come first
+	return bound(vec, key, cmp, 0);
+}
+
+size_t vec_upper_bound(const vector *vec,
+	const void *key,
+	int (*cmp)(const void *lhs, const void *rhs)) {
+	// Elements not greater than key come first
+	return bound(vec, key, cmp, 1);
+}
+
+vector_status vec_insert_sorted(vector *vec,
+	const void *value,
+	int (*cmp)(const void *lhs, const void *rhs)) {
+	if (vec == NULL || cmp == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	return vec_insert(vec, vec_upper_bound(vec, value, cmp), value);
+}
+
+vector_status vec_erase_sorted(vector *vec,
+	const void *key,
+	void *buffer,
+	int (*cmp)(const void *lhs, const void *rhs)) {
+	if (vec == NULL || cmp == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	size_t index = vec_lower_bound(vec, key, cmp);
+	if (index == vec->count || cmp(vec_at(vec, index), key) != 0) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	return vec_erase(vec, index, buffer);
+}
+
+vector_status vec_eytzinger_build(vector *vec) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (vec->count < 2) {
+		return VECTOR_STATUS_OK;
+	}
+
+	vector_status status = vec_unshare(vec);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	size_t size = vec->_type_size;
+	char *sorted = malloc(size * vec->count);
+	if (sorted == NULL) {
+		return VECTOR_STATUS_ALLOC;
+	}
+
+	memcpy(sorted, vec->data, size * vec->count);
+	eytzinger_fill(vec->data, sorted, size, vec->count, 1, 0);
+
+	free(sorted);
+	return VECTOR_STATUS_OK;
+}
+
+size_t vec_eytzinger_search(const vector *vec,
+	const void *key,
+	int (*cmp)(const void *lhs, const void *rhs)) {
+	if (vec == NULL || cmp == NULL) {
+		return 0;
+	}
+
+	// Nodes are 1-based, node k is stored at element k - 1
+	size_t size = vec->_type_size;
+	size_t count = vec->count;
+	size_t node = 1;
+	while (node <= count) {
+		size_t ahead = node << PREFETCH_LEVELS;
+		if (ahead <= count) {
+			__builtin_prefetch(elem_at(vec->data, size, ahead - 1));
+		}
+
+		node = 2 * node + (cmp(elem_at(vec->data, size, node - 1), key) < 0);
+	}
+
+	// Drop the trailing right turns, then the last left turn
+	node >>= __builtin_ctzll(~(unsigned long long)node) + 1;
+	return (node == 0) ? count : node - 1;
+}
+
+/**
+ * @brief Branchless binary search.
+ *
+ * @param[in] vec - Vector object, sorted by cmp.
+ * @param[in] key - Key to search for.
+ * @param[in] cmp - Comparison function, called as cmp(element, key).
+ * @param[in] threshold - Elements with cmp below this come first.
+ * @return Index of the first element with cmp of at least threshold.
+ */
+static size_t bound(const vector *vec,
+	const void *key,
+	compare_fn cmp,
+	int threshold) {
+	if (vec == NULL || cmp == NULL || vec->count == 0) {
+		return 0;
+	}
+
+	size_t size = vec->_type_size;
+	const char *base = vec->data;
+	size_t count = vec->count;
+	while (count > 1) {
+		size_t half = count / 2;
+		const char *mid = base + size * half;
+
+		// Both possible next probes, the branch is not predicted
+		__builtin_prefetch(base + size * ((count - half) / 2));
+		__builtin_prefetch(mid + size * ((count - half) / 2));
+
+		// Conditional move instead of a branch
+		base = (cmp(mid, key) < threshold) ? mid : base;
+		count -= half;
+	}
+
+	size_t index = (size_t)(base - (const char *)vec->data) / size;
+	return index + (cmp(base, key) < threshold);
+}
+
+/**
+ * @brief Place sorted elements into Eytzinger order (in-order traversal).
+ *
+ * @param[out] dst - Eytzinger storage.
+ * @param[in] src - Sorted elements.
+ * @param[in] size - Element size.
+ * @param[in] count - Element count.
+ * @param[in] node - Current node, 1-based.
+ * @param[in] next - Next sorted element to place.
+ * @return Next sorted element to place after this subtree.
+ */
+static size_t eytzinger_fill(char *dst,
+	const char *src,
+	size_t size,
+	size_t count,
+	size_t node,
+	size_t next) {
+	if (node > count) {
+		return next;
+	}
+
+	next = eytzinger_fill(dst, src, size, count, 2 * node, next);
+	memcpy(elem_at(dst, size, node - 1), elem_at(src, size, next), size);
+	return eytzinger_fill(dst, src, size, count, 2 * node + 1, next + 1);
+}
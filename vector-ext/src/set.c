@@ -0,0 +1,436 @@
+/**
+ * @file set.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0.1
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Set operations on sorted vectors.
+ */
+#include "vector-ext.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <c-utils/vector.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Size ratio at which the smaller side is galloped through the larger one
+#define GALLOP_RATIO 32
+
+// Which elements of lhs are written
+#define KEEP_COMMON 0 // Intersection
+#define KEEP_MISSING 1 // Difference
+
+// Which elements of both sides are written
+#define MERGE_UNIQUE 0 // Union
+#define MERGE_ALL 1 // Merge
+
+typedef enum {
+	SET_INTERSECT,
+	SET_UNION,
+	SET_DIFFERENCE,
+	SET_MERGE,
+} set_op;
+
+static vector_status set_apply(const vector *lhs,
+	const vector *rhs,
+	vector *out,
+	set_op op);
+
+/**
+ * @def DEFINE_SET_OPS(T)
+ * Define set algorithms for sorted arrays of unsigned integer type T.
+ *
+ * - size_t gallop_T(const T *arr, size_t count, size_t start, T key):
+ *   first index from start with arr[index] >= key, using exponential search.
+ * - size_t filter_T(const T *lhs, size_t lhs_count, const T *rhs,
+ *   size_t rhs_count, T *out, int keep): elements of lhs that are
+ *   (KEEP_COMMON) or are not (KEEP_MISSING) in rhs.
+ * - size_t combine_T(const T *lhs, size_t lhs_count, const T *rhs,
+ *   size_t rhs_count, T *out, int keep): elements of both, equal elements
+ *   once (MERGE_UNIQUE) or from both sides (MERGE_ALL).
+ *
+ * Functions return the amount of elements written to out.
+ */
+#define DEFINE_SET_OPS(T)                                                      \
+	static size_t gallop_##T(                                                  \
+		const T *arr, size_t count, size_t start, T key) {                     \
+		if (start >= count || arr[start] >= key) {                             \
+			return start;                                                      \
+		}                                                                      \
+                                                                               \
+		/* Double the step until past key, arr[start] < key */                 \
+		size_t step = 1;                                                       \
+		while (step < count - start && arr[start + step] < key) {              \
+			step *= 2;                                                         \
+		}                                                                      \
+                                                                               \
+		size_t low = start + step / 2 + 1;                                     \
+		size_t high = (step < count - start) ? start + step : count;           \
+		while (low < high) {                                                   \
+			size_t mid = low + (high - low) / 2;                               \
+			if (arr[mid] < key) {                                              \
+				low = mid + 1;                                                 \
+			} else {                                                           \
+				high = mid;                                                    \
+			}                                                                  \
+		}                                                                      \
+                                                                               \
+		return low;                                                            \
+	}                                                                          \
+                                                                               \
+	static size_t filter_##T(const T *lhs, size_t lhs_count, const T *rhs,     \
+		size_t rhs_count, T *out, int keep) {                                  \
+		size_t written = 0;                                                    \
+		size_t i = 0;                                                          \
+		size_t j = 0;                                                          \
+                                                                               \
+		/* Few lhs elements: look each up in rhs */                            \
+		if (lhs_count * GALLOP_RATIO < rhs_count) {                            \
+			for (; i < lhs_count; i++) {                                       \
+				j = gallop_##T(rhs, rhs_count, j, lhs[i]);                     \
+				int found = j < rhs_count && rhs[j] == lhs[i];                 \
+				if (found == (keep == KEEP_COMMON)) {                          \
+					out[written++] = lhs[i];                                   \
+				}                                                              \
+			}                                                                  \
+                                                                               \
+			return written;                                                    \
+		}                                                                      \
+                                                                               \
+		/* Few rhs elements: skip lhs runs between them */                     \
+		if (rhs_count * GALLOP_RATIO < lhs_count) {                            \
+			for (; j < rhs_count && i < lhs_count; j++) {                      \
+				size_t next = gallop_##T(lhs, lhs_count, i, rhs[j]);           \
+				if (keep == KEEP_MISSING) {                                    \
+					memcpy(out + written, lhs + i, sizeof(T) * (next - i));    \
+					written += next - i;                                       \
+				}                                                              \
+                                                                               \
+				i = next;                                                      \
+				if (i < lhs_count && lhs[i] == rhs[j]) {                       \
+					if (keep == KEEP_COMMON) {                                 \
+						out[written++] = lhs[i];                               \
+					}                                                          \
+					i++;                                                       \
+				}                                                              \
+			}                                                                  \
+                                                                               \
+			if (keep == KEEP_MISSING) {                                        \
+				memcpy(out + written, lhs + i, sizeof(T) * (lhs_count - i));   \
+				written += lhs_count - i;                                      \
+			}                                                                  \
+                                                                               \
+			return written;                                                    \
+		}                                                                      \
+                                                                               \
+		return written                                                         \
+			+ filter_block_##T(lhs, lhs_count, rhs, rhs_count, out, keep);     \
+	}                                                                          \
+                                                                               \
+	static size_t combine_##T(const T *lhs, size_t lhs_count, const T *rhs,    \
+		size_t rhs_count, T *out, int keep) {                                  \
+		/* Gallop the smaller side through the larger one */                   \
+		if (lhs_count * GALLOP_RATIO < rhs_count                               \
+			|| rhs_count * GALLOP_RATIO < lhs_count) {                         \
+			const T *small = (lhs_count < rhs_count) ? lhs : rhs;              \
+			const T *large = (lhs_count < rhs_count) ? rhs : lhs;              \
+			size_t small_count = (lhs_count < rhs_count) ? lhs_count           \
+														 : rhs_count;          \
+			size_t large_count = lhs_count + rhs_count - small_count;          \
+                                                                               \
+			size_t written = 0;                                                \
+			size_t i = 0;                                                      \
+			for (size_t j = 0; j < small_count; j++) {                         \
+				size_t next = gallop_##T(large, large_count, i, small[j]);     \
+				memcpy(out + written, large + i, sizeof(T) * (next - i));      \
+				written += next - i;                                           \
+				i = next;                                                      \
+                                                                               \
+				if (keep == MERGE_UNIQUE && i < large_count                    \
+					&& large[i] == small[j]) {                                 \
+					i++;                                                       \
+				}                                                              \
+				out[written++] = small[j];                                     \
+			}                                                                  \
+                                                                               \
+			memcpy(out + written, large + i, sizeof(T) * (large_count - i));   \
+			return written + large_count - i;                                  \
+		}                                                                      \
+                                                                               \
+		size_t written = 0;                                                    \
+		size_t i = 0;                                                          \
+		size_t j = 0;                                                          \
+		while (i < lhs_count && j < rhs_count) {                               \
+			T lhs_value = lhs[i];                                              \
+			T rhs_value = rhs[j];                                              \
+			if (keep == MERGE_UNIQUE && lhs_value == rhs_value) {              \
+				out[written++] = lhs_value;                                    \
+				i++;                                                           \
+				j++;                                                           \
+			} else if (rhs_value < lhs_value) {                                \
+				out[written++] = rhs_value;                                    \
+				j++;                                                           \
+			} else {                                                           \
+				out[written++] = lhs_value;                                    \
+				i++;                                                           \
+			}                                                                  \
+		}                                                                      \
+                                                                               \
+		memcpy(out + written, lhs + i, sizeof(T) * (lhs_count - i));           \
+		written += lhs_count - i;                                              \
+		memcpy(out + written, rhs + j, sizeof(T) * (rhs_count - j));           \
+		return written + rhs_count - j;                                        \
+	}
+
+static size_t filter_block_uint32_t(const uint32_t *lhs,
+	size_t lhs_count,
+	const uint32_t *rhs,
+	size_t rhs_count,
+	uint32_t *out,
+	int keep);
+static size_t filter_block_uint64_t(const uint64_t *lhs,
+	size_t lhs_count,
+	const uint64_t *rhs,
+	size_t rhs_count,
+	uint64_t *out,
+	int keep);
+
+DEFINE_SET_OPS(uint32_t)
+DEFINE_SET_OPS(uint64_t)
+
+vector_status vec_set_intersect(
+	const vector *lhs, const vector *rhs, vector *out) {
+	return set_apply(lhs, rhs, out, SET_INTERSECT);
+}
+
+vector_status vec_set_union(const vector *lhs, const vector *rhs, vector *out) {
+	return set_apply(lhs, rhs, out, SET_UNION);
+}
+
+vector_status vec_set_difference(
+	const vector *lhs, const vector *rhs, vector *out) {
+	return set_apply(lhs, rhs, out, SET_DIFFERENCE);
+}
+
+vector_status vec_set_merge(const vector *lhs, const vector *rhs, vector *out) {
+	return set_apply(lhs, rhs, out, SET_MERGE);
+}
+
+/**
+ * @brief Run a set operation, replacing the contents of out.
+ *
+ * @param[in] lhs - Left sorted vector.
+ * @param[in] rhs - Right sorted vector.
+ * @param[out] out - Result vector.
+ * @param[in] op - Operation.
+ * @return Status code.
+ */
+static vector_status set_apply(const vector *lhs,
+	const vector *rhs,
+	vector *out,
+	set_op op) {
+	if (lhs == NULL || rhs == NULL || out == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	size_t size = lhs->_type_size;
+	if ((size != sizeof(uint32_t) && size != sizeof(uint64_t))
+		|| rhs->_type_size != size || out->_type_size != size || out == lhs
+		|| out == rhs) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	// Largest possible result
+	size_t max_count = lhs->count;
+	if (op == SET_INTERSECT && rhs->count < max_count) {
+		max_count = rhs->count;
+	} else if (op == SET_UNION || op == SET_MERGE) {
+		if (rhs->count > SIZE_MAX / size - lhs->count) {
+			return VECTOR_STATUS_OVERFLOW;
+		}
+		max_count += rhs->count;
+	}
+
+	// Old contents are dropped, so nothing is copied if shared
+	out->count = 0;
+	vector_status status = vec_unshare(out);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	status = vec_reserve(out, max_count);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	if (max_count == 0) {
+		return VECTOR_STATUS_OK;
+	}
+
+	int keep;
+	switch (op) {
+	case SET_INTERSECT:
+		keep = KEEP_COMMON;
+		break;
+	case SET_DIFFERENCE:
+		keep = KEEP_MISSING;
+		break;
+	case SET_UNION:
+		keep = MERGE_UNIQUE;
+		break;
+	default:
+		keep = MERGE_ALL;
+		break;
+	}
+
+	int filter = (op == SET_INTERSECT || op == SET_DIFFERENCE);
+	if (size == sizeof(uint32_t)) {
+		// clang-format off
+		out->count = filter
+			? filter_uint32_t(lhs->data, lhs->count, rhs->data, rhs->count,
+				out->data, keep)
+			: combine_uint32_t(lhs->data, lhs->count, rhs->data, rhs->count,
+				out->data, keep);
+		// clang-format on
+	} else {
+		// clang-format off
+		out->count = filter
+			? filter_uint64_t(lhs->data, lhs->count, rhs->data, rhs->count,
+				out->data, keep)
+			: combine_uint64_t(lhs->data, lhs->count, rhs->data, rhs->count,
+				out->data, keep);
+		// clang-format on
+	}
+
+	return VECTOR_STATUS_OK;
+}
+
+/**
+ * @brief Filter similarly sized uint32_t arrays, 4x4 blocks at a time.
+ *
+ * Every element of a lhs block is compared against every element of a rhs
+ * block with SIMD equality checks, then the block with the smaller maximum
+ * is advanced.
+ *
+ * @param[in] lhs - Left sorted array.
+ * @param[in] lhs_count - Left element count.
+ * @param[in] rhs - Right sorted array.
+ * @param[in] rhs_count - Right element count.
+ * @param[out] out - Result array.
+ * @param[in] keep - KEEP_COMMON or KEEP_MISSING.
+ * @return Amount of elements written.
+ */
+static size_t filter_block_uint32_t(const uint32_t *lhs,
+	size_t lhs_count,
+	const uint32_t *rhs,
+	size_t rhs_count,
+	uint32_t *out,
+	int keep) {
+	size_t written = 0;
+	size_t i = 0;
+	size_t j = 0;
+
+#ifdef __SSE2__
+	// Lanes of the current lhs block seen in rhs so far
+	unsigned int found = 0;
+	while (i + 4 <= lhs_count && j + 4 <= rhs_count) {
+		__m128i lhs_block = _mm_loadu_si128((const __m128i *)(lhs + i));
+		__m128i rhs_block = _mm_loadu_si128((const __m128i *)(rhs + j));
+
+		// All 16 pairs through rotations of the rhs block
+		__m128i match = _mm_cmpeq_epi32(lhs_block, rhs_block);
+		rhs_block = _mm_shuffle_epi32(rhs_block, _MM_SHUFFLE(0, 3, 2, 1));
+		match = _mm_or_si128(match, _mm_cmpeq_epi32(lhs_block, rhs_block));
+		rhs_block = _mm_shuffle_epi32(rhs_block, _MM_SHUFFLE(0, 3, 2, 1));
+		match = _mm_or_si128(match, _mm_cmpeq_epi32(lhs_block, rhs_block));
+		rhs_block = _mm_shuffle_epi32(rhs_block, _MM_SHUFFLE(0, 3, 2, 1));
+		match = _mm_or_si128(match, _mm_cmpeq_epi32(lhs_block, rhs_block));
+		found |= (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(match));
+
+		uint32_t lhs_max = lhs[i + 3];
+		uint32_t rhs_max = rhs[j + 3];
+		if (lhs_max <= rhs_max) {
+			unsigned int lanes = (keep == KEEP_COMMON) ? found : ~found & 0xf;
+			for (; lanes != 0; lanes &= lanes - 1) {
+				out[written++] = lhs[i + __builtin_ctz(lanes)];
+			}
+
+			i += 4;
+			found = 0;
+		}
+		if (rhs_max <= lhs_max) {
+			j += 4;
+		}
+	}
+
+	// Finish a block that already matched rhs elements left behind
+	if (found != 0) {
+		for (size_t end = i + 4; i < end; i++) {
+			int lane_found = (found >> (4 - (end - i))) & 1;
+			if (!lane_found) {
+				while (j < rhs_count && rhs[j] < lhs[i]) {
+					j++;
+				}
+				lane_found = j < rhs_count && rhs[j] == lhs[i];
+			}
+
+			if (lane_found == (keep == KEEP_COMMON)) {
+				out[written++] = lhs[i];
+			}
+		}
+	}
+#endif
+
+	// Scalar merge of the rest
+	while (i < lhs_count) {
+		while (j < rhs_count && rhs[j] < lhs[i]) {
+			j++;
+		}
+
+		int lane_found = j < rhs_count && rhs[j] == lhs[i];
+		if (lane_found == (keep == KEEP_COMMON)) {
+			out[written++] = lhs[i];
+		}
+		i++;
+	}
+
+	return written;
+}
+
+/**
+ * @brief Filter similarly sized uint64_t arrays with a scalar merge.
+ *
+ * @param[in] lhs - Left sorted array.
+ * @param[in] lhs_count - Left element count.
+ * @param[in] rhs - Right sorted array.
+ * @param[in] rhs_count - Right element count.
+ * @param[out] out - Result array.
+ * @param[in] keep - KEEP_COMMON or KEEP_MISSING.
+ * @return Amount of elements written.
+ */
+static size_t filter_block_uint64_t(const uint64_t *lhs,
+	size_t lhs_count,
+	const uint64_t *rhs,
+	size_t rhs_count,
+	uint64_t *out,
+	int keep) {
+	size_t written = 0;
+	size_t j = 0;
+	for (size_t i = 0; i < lhs_count; i++) {
+		while (j < rhs_count && rhs[j] < lhs[i]) {
+			j++;
+		}
+
+		int found = j < rhs_count && rhs[j] == lhs[i];
+		if (found == (keep == KEEP_COMMON)) {
+			out[written++] = lhs[i];
+		}
+	}
+
+	return written;
+}
@@ -0,0 +1,444 @@
+/**
+ * @file sort.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0.1
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Vector sorting functions.
+ */
+#include "vector-ext.h"
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <c-utils/vector.h>
+
+#include "sort.h"
+
+// Ranges this short are insertion sorted
+#define INSERTION_THRESHOLD 16
+
+// Radix sort digit size
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+
+// Pointer arithmetic for elements
+#define elem_at(base, size, index) ((char *)(base) + (size) * (index))
+
+static void introsort(
+	char *base, size_t count, size_t size, compare_fn cmp, size_t depth);
+static void heap_sort(char *base, size_t count, size_t size, compare_fn cmp);
+static void sift_down(
+	char *base, size_t root, size_t count, size_t size, compare_fn cmp);
+static void swap(void *lhs, void *rhs, size_t size);
+static vector_status radix_sort(
+	vector *vec, size_t key_offset, size_t key_size);
+static uint64_t load_key(const char *elem, size_t key_size);
+
+vector_status vec_sort(
+	vector *vec, int (*cmp)(const void *lhs, const void *rhs)) {
+	if (vec == NULL || cmp == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (vec->count < 2) {
+		return VECTOR_STATUS_OK;
+	}
+
+	vector_status status = vec_unshare(vec);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	vec_sort_range(vec->data, vec->count, vec->_type_size, cmp);
+	return VECTOR_STATUS_OK;
+}
+
+vector_status vec_sort_u32(vector *vec) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (vec->_type_size != sizeof(uint32_t)) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	return radix_sort(vec, 0, sizeof(uint32_t));
+}
+
+vector_status vec_sort_u64(vector *vec) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (vec->_type_size != sizeof(uint64_t)) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	return radix_sort(vec, 0, sizeof(uint64_t));
+}
+
+vector_status vec_sort_key_u32(vector *vec, size_t key_offset) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (key_offset > vec->_type_size
+		|| vec->_type_size - key_offset < sizeof(uint32_t)) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	return radix_sort(vec, key_offset, sizeof(uint32_t));
+}
+
+vector_status vec_sort_key_u64(vector *vec, size_t key_offset) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (key_offset > vec->_type_size
+		|| vec->_type_size - key_offset < sizeof(uint64_t)) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	return radix_sort(vec, key_offset, sizeof(uint64_t));
+}
+
+void vec_sort_range(void *base, size_t count, size_t size, compare_fn cmp) {
+	// Depth limit of 2 * log2(count)
+	size_t depth = 0;
+	for (size_t n = count; n > 1; n >>= 1) {
+		depth += 2;
+	}
+
+	introsort(base, count, size, cmp, depth);
+}
+
+void vec_sort_stable_range(
+	void *base, void *scratch, size_t count, size_t size, compare_fn cmp) {
+	// Sorted runs, then merge passes alternating between buffers
+	for (size_t i = 0; i < count; i += INSERTION_THRESHOLD) {
+		size_t run_count = count - i;
+		if (run_count > INSERTION_THRESHOLD) {
+			run_count = INSERTION_THRESHOLD;
+		}
+
+		vec_sort_insertion(elem_at(base, size, i), run_count, size, cmp);
+	}
+
+	char *src = base;
+	char *dst = scratch;
+	for (size_t width = INSERTION_THRESHOLD; width < count; width *= 2) {
+		for (size_t i = 0; i < count; i += 2 * width) {
+			size_t left_count = (count - i < width) ? count - i : width;
+			size_t rest = count - i - left_count;
+			size_t right_count = (rest < width) ? rest : width;
+
+			char *left = elem_at(src, size, i);
+			char *right = elem_at(left, size, left_count);
+			char *out = elem_at(dst, size, i);
+			while (left_count > 0 && right_count > 0) {
+				// Ties are taken from the left run
+				if (cmp(right, left) < 0) {
+					memcpy(out, right, size);
+					right += size;
+					right_count--;
+				} else {
+					memcpy(out, left, size);
+					left += size;
+					left_count--;
+				}
+				out += size;
+			}
+
+			memcpy(out, left, size * left_count);
+			memcpy(out + size * left_count, right, size * right_count);
+		}
+
+		char *swap_ptr = src;
+		src = dst;
+		dst = swap_ptr;
+	}
+
+	if (src != base) {
+		memcpy(base, src, size * count);
+	}
+}
+
+void vec_sort_insertion(void *base, size_t count, size_t size, compare_fn cmp) {
+	for (size_t i = 1; i < count; i++) {
+		for (size_t j = i; j > 0; j--) {
+			char *prev = elem_at(base, size, j - 1);
+			char *cur = elem_at(base, size, j);
+			if (cmp(prev, cur) <= 0) {
+				break;
+			}
+
+			swap(prev, cur, size);
+		}
+	}
+}
+
+/**
+ * @brief Sort a range with quicksort, falling back to heapsort.
+ *
+ * @param[in,out] base - First element.
+ * @param[in] count - Element count.
+ * @param[in] size - Element size.
+ * @param[in] cmp - Comparison function.
+ * @param[in] depth - Partitioning steps left before heapsort is used.
+ */
+static void introsort(
+	char *base, size_t count, size_t size, compare_fn cmp, size_t depth) {
+	while (count > INSERTION_THRESHOLD) {
+		if (depth == 0) {
+			heap_sort(base, count, size, cmp);
+			return;
+		}
+		depth--;
+
+		// Median of first, middle and last becomes the pivot at base
+		char *first = base;
+		char *mid = elem_at(base, size, count / 2);
+		char *last = elem_at(base, size, count - 1);
+		if (cmp(mid, first) < 0) {
+			swap(mid, first, size);
+		}
+		if (cmp(last, mid) < 0) {
+			swap(last, mid, size);
+			if (cmp(mid, first) < 0) {
+				swap(mid, first, size);
+			}
+		}
+		swap(first, mid, size);
+
+		// Hoare partition around the pivot
+		size_t i = 0;
+		size_t j = count;
+		while (1) {
+			do {
+				i++;
+			} while (i < count && cmp(elem_at(base, size, i), base) < 0);
+
+			do {
+				j--;
+			} while (cmp(elem_at(base, size, j), base) > 0);
+
+			if (i >= j) {
+				break;
+			}
+
+			swap(elem_at(base, size, i), elem_at(base, size, j), size);
+		}
+		swap(base, elem_at(base, size, j), size);
+
+		// Recurse into the smaller side, loop on the larger one
+		size_t left_count = j;
+		size_t right_count = count - j - 1;
+		char *right = elem_at(base, size, j + 1);
+		if (left_count < right_count) {
+			introsort(base, left_count, size, cmp, depth);
+			base = right;
+			count = right_count;
+		} else {
+			introsort(right, right_count, size, cmp, depth);
+			count = left_count;
+		}
+	}
+
+	vec_sort_insertion(base, count, size, cmp);
+}
+
+/**
+ * @brief Sort a range with heapsort.
+ *
+ * @param[in,out] base - First element.
+ * @param[in] count - Element count.
+ * @param[in] size - Element size.
+ * @param[in] cmp - Comparison function.
+ */
+static void heap_sort(char *base, size_t count, size_t size, compare_fn cmp) {
+	for (size_t root = count / 2; root > 0; root--) {
+		sift_down(base, root - 1, count, size, cmp);
+	}
+
+	for (size_t end = count - 1; end > 0; end--) {
+		swap(base, elem_at(base, size, end), size);
+		sift_down(base, 0, end, size, cmp);
+	}
+}
+
+/**
+ * @brief Restore max-heap order below a node.
+ *
+ * @param[in,out] base - First element of the heap.
+ * @param[in] root - Node index.
+ * @param[in] count - Heap size.
+ * @param[in] size - Element size.
+ * @param[in] cmp - Comparison function.
+ */
+static void sift_down(
+	char *base, size_t root, size_t count, size_t size, compare_fn cmp) {
+	while (root < count / 2) {
+		size_t child = 2 * root + 1;
+		if (child + 1 < count
+			&& cmp(elem_at(base, size, child), elem_at(base, size, child + 1))
+				< 0) {
+			child++;
+		}
+
+		if (cmp(elem_at(base, size, root), elem_at(base, size, child)) >= 0) {
+			return;
+		}
+
+		swap(elem_at(base, size, root), elem_at(base, size, child), size);
+		root = child;
+	}
+}
+
+/**
+ * @brief Swap two elements.
+ *
+ * Common sizes are swapped as single words.
+ *
+ * @param[in,out] lhs - First element.
+ * @param[in,out] rhs - Second element.
+ * @param[in] size - Element size.
+ */
+static void swap(void *lhs, void *rhs, size_t size) {
+	switch (size) {
+	case sizeof(uint32_t): {
+		uint32_t tmp;
+		memcpy(&tmp, lhs, sizeof(tmp));
+		memcpy(lhs, rhs, sizeof(tmp));
+		memcpy(rhs, &tmp, sizeof(tmp));
+		return;
+	}
+	case sizeof(uint64_t): {
+		uint64_t tmp;
+		memcpy(&tmp, lhs, sizeof(tmp));
+		memcpy(lhs, rhs, sizeof(tmp));
+		memcpy(rhs, &tmp, sizeof(tmp));
+		return;
+	}
+	}
+
+	// Word-sized chunks, then the remaining bytes
+	char *a = lhs;
+	char *b = rhs;
+	for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+		uint64_t tmp;
+		memcpy(&tmp, a, sizeof(tmp));
+		memcpy(a, b, sizeof(tmp));
+		memcpy(b, &tmp, sizeof(tmp));
+		a += sizeof(tmp);
+		b += sizeof(tmp);
+	}
+
+	for (; size > 0; size--) {
+		char tmp = *a;
+		*a++ = *b;
+		*b++ = tmp;
+	}
+}
+
+/**
+ * @brief Sort elements by an unsigned key with LSD radix sort.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] key_offset - Offset of the key inside an element.
+ * @param[in] key_size - sizeof(uint32_t) or sizeof(uint64_t).
+ * @return Status code.
+ */
+static vector_status radix_sort(
+	vector *vec, size_t key_offset, size_t key_size) {
+	if (vec->count < 2) {
+		return VECTOR_STATUS_OK;
+	}
+
+	vector_status status = vec_unshare(vec);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	size_t count = vec->count;
+	size_t size = vec->_type_size;
+	char *tmp = malloc(size * count);
+	if (tmp == NULL) {
+		return VECTOR_STATUS_ALLOC;
+	}
+
+	// Histograms of every digit in a single read
+	size_t digits = key_size * CHAR_BIT / RADIX_BITS;
+	size_t histograms[sizeof(uint64_t)][RADIX_BUCKETS] = { { 0 } };
+	for (size_t i = 0; i < count; i++) {
+		uint64_t key = load_key(elem_at(vec->data, size, i) + key_offset,
+			key_size);
+		for (size_t d = 0; d < digits; d++) {
+			histograms[d][(key >> (d * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+		}
+	}
+
+	char *src = vec->data;
+	char *dst = tmp;
+	for (size_t d = 0; d < digits; d++) {
+		size_t *histogram = histograms[d];
+
+		// Every key has the same digit
+		uint64_t first_key = load_key(src + key_offset, key_size);
+		size_t first_digit = (first_key >> (d * RADIX_BITS))
+			& (RADIX_BUCKETS - 1);
+		if (histogram[first_digit] == count) {
+			continue;
+		}
+
+		// Bucket start offsets
+		size_t offset = 0;
+		for (size_t b = 0; b < RADIX_BUCKETS; b++) {
+			size_t bucket_count = histogram[b];
+			histogram[b] = offset;
+			offset += bucket_count;
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			char *elem = elem_at(src, size, i);
+			uint64_t key = load_key(elem + key_offset, key_size);
+			size_t digit = (key >> (d * RADIX_BITS)) & (RADIX_BUCKETS - 1);
+			memcpy(elem_at(dst, size, histogram[digit]++), elem, size);
+		}
+
+		char *swap_ptr = src;
+		src = dst;
+		dst = swap_ptr;
+	}
+
+	// Odd amount of passes leaves the result in the temporary buffer
+	if (src != vec->data) {
+		memcpy(vec->data, src, size * count);
+	}
+
+	free(tmp);
+	return VECTOR_STATUS_OK;
+}
+
+/**
+ * @brief Read an unsigned key of any alignment.
+ *
+ * @param[in] ptr - Key location.
+ * @param[in] key_size - sizeof(uint32_t) or sizeof(uint64_t).
+ * @return Key value.
+ */
+static uint64_t load_key(const char *ptr, size_t key_size) {
+	if (key_size == sizeof(uint32_t)) {
+		uint32_t key;
+		memcpy(&key, ptr, sizeof(key));
+		return key;
+	}
+
+	uint64_t key;
+	memcpy(&key, ptr, sizeof(key));
+	return key;
+}
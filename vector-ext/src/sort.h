@@ -0,0 +1,48 @@
+/**
+ * @file sort.h
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.0.1
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Sorting routines shared by vector extension functions.
+ */
+#pragma once
+
+#include <stddef.h>
+
+/**
+ * @brief Element comparison function, as used by qsort.
+ */
+typedef int (*compare_fn)(const void *lhs, const void *rhs);
+
+/**
+ * @brief Sort a range with introsort.
+ *
+ * @param[in,out] base - First element.
+ * @param[in] count - Element count.
+ * @param[in] size - Element size.
+ * @param[in] cmp - Comparison function.
+ */
+void vec_sort_range(void *base, size_t count, size_t size, compare_fn cmp);
+
+/**
+ * @brief Sort a range with stable merge sort.
+ *
+ * @param[in,out] base - First element.
+ * @param[in] scratch - Buffer of count elements, contents are clobbered.
+ * @param[in] count - Element count.
+ * @param[in] size - Element size.
+ * @param[in] cmp - Comparison function.
+ */
+void vec_sort_stable_range(
+	void *base, void *scratch, size_t count, size_t size, compare_fn cmp);
+
+/**
+ * @brief Sort a short range with stable insertion sort.
+ *
+ * @param[in,out] base - First element.
+ * @param[in] count - Element count.
+ * @param[in] size - Element size.
+ * @param[in] cmp - Comparison function.
+ */
+void vec_sort_insertion(void *base, size_t count, size_t size, compare_fn cmp);
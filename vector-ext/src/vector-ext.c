@@ -14,21 +14,19 @@
 
 #include <c-utils/vector.h>
 
-// Growth factor
-#define FACTOR 2
-
 // Pointer arithmetic for elements
 #define ptr_at(vec, index) (vec->data + vec->_type_size * (index))
 
-static uint32_t new_alloc_size(const vector *vec, uint32_t more_count);
-
-vector_status vec_bulk_push(vector *vec, const void *items, uint32_t count) {
+vector_status vec_bulk_push(vector *vec, const void *items, size_t count) {
 	if (vec == NULL) {
 		return VECTOR_STATUS_NULL;
 	}
 
 	// Reserve more space
-	vec_reserve(vec, new_alloc_size(vec, count));
+	vector_status status = vec_grow(vec, count);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
 
 	// Copy elements
 	void *push_ptr = ptr_at(vec, vec->count);
@@ -39,7 +37,7 @@ vector_status vec_bulk_push(vector *vec, const void *items, uint32_t count) {
 }
 
 vector_status vec_bulk_insert(
-	vector *vec, uint32_t index, const void *items, uint32_t count) {
+	vector *vec, size_t index, const void *items, size_t count) {
 	if (vec == NULL) {
 		return VECTOR_STATUS_NULL;
 	}
@@ -49,17 +47,21 @@ vector_status vec_bulk_insert(
 	}
 
 	// Reserve more space
-	vec_reserve(vec, new_alloc_size(vec, count));
+	vector_status status = vec_grow(vec, count);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
 
 	// Move elements forwards
-	uint32_t move_to = vec->count + count - 1;
-	uint32_t last_insert_index = index + count - 1;
+	vec_stats_move(vec, vec->_type_size * (vec->count - index));
+	size_t move_to = vec->count + count - 1;
+	size_t last_insert_index = index + count - 1;
 	while (move_to > last_insert_index) {
-		uint32_t remaining = move_to - last_insert_index;
-		uint32_t copy_count = (remaining >= count) ? count : remaining;
+		size_t remaining = move_to - last_insert_index;
+		size_t copy_count = (remaining >= count) ? count : remaining;
 
 		// Offset to front of copy frame
-		uint32_t offset = copy_count - 1;
+		size_t offset = copy_count - 1;
 
 		memcpy(ptr_at(vec, move_to - offset),
 			ptr_at(vec, move_to - count - offset),
@@ -75,25 +77,31 @@ vector_status vec_bulk_insert(
 }
 
 vector_status vec_bulk_erase(
-	vector *vec, uint32_t index, void *buffer, uint32_t count) {
+	vector *vec, size_t index, void *buffer, size_t count) {
 	if (vec == NULL) {
 		return VECTOR_STATUS_NULL;
 	}
 
-	if (index > vec->count - count) {
+	if (count > vec->count || index > vec->count - count) {
 		return VECTOR_STATUS_BOUNDS;
 	}
 
+	vector_status status = vec_unshare(vec);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
 	// Copy elements if needed
 	if (buffer != NULL) {
 		memcpy(buffer, ptr_at(vec, index), vec->_type_size * count);
 	}
 
 	// Move elements backwards
-	uint32_t move_from = index + count;
+	vec_stats_move(vec, vec->_type_size * (vec->count - index - count));
+	size_t move_from = index + count;
 	while (move_from < vec->count) {
-		uint32_t remaining = vec->count - move_from;
-		uint32_t copy_count = (remaining >= count) ? count : remaining;
+		size_t remaining = vec->count - move_from;
+		size_t copy_count = (remaining >= count) ? count : remaining;
 
 		memcpy(ptr_at(vec, move_from - count), ptr_at(vec, move_from),
 			vec->_type_size * copy_count);
@@ -102,21 +110,7 @@ vector_status vec_bulk_erase(
 
 	vec->count -= count;
 
+	// Best effort, the elements are removed either way
+	vec_auto_shrink(vec);
 	return VECTOR_STATUS_OK;
 }
-
-/**
- * @brief Calculate new allocation size.
- *
- * @param[in] vec - Vector object.
- * @param[in] more_count - How many more elements should fit.
- * @return New allocation size.
- */
-static uint32_t new_alloc_size(const vector *vec, uint32_t more_count) {
-	uint32_t alloc = vec->_alloc_count;
-	while (vec->count + more_count > alloc) {
-		alloc = (alloc == 0) ? FACTOR : alloc * FACTOR;
-	}
-
-	return alloc;
-}
@@ -4,8 +4,11 @@ extern "C" {
 #include "../include/vector-ext.h"
 }
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <gtest/gtest.h>
+#include <vector>
 
 static char element0 = '0';
 static char element1 = '1';
@@ -17,6 +20,29 @@ static char elements1[] = { element2, element0, element1 };
 static int int_elements0[] = { element0, element1, element2 };
 static int int_elements1[] = { element2, element0, element1 };
 
+struct record {
+	uint32_t id;
+	uint64_t key;
+	char tag;
+};
+
+static int compare_int(const void *lhs, const void *rhs) {
+	int a = *(const int *)lhs;
+	int b = *(const int *)rhs;
+	return (a > b) - (a < b);
+}
+
+static int compare_record(const void *lhs, const void *rhs) {
+	uint64_t a = ((const record *)lhs)->key;
+	uint64_t b = ((const record *)rhs)->key;
+	return (a > b) - (a < b);
+}
+
+static uint64_t next_random(uint64_t *state) {
+	*state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+	return *state >> 17;
+}
+
 TEST(VectorExt, VecBulkPushNull) {
 	vector *vec = nullptr;
 
@@ -24,12 +50,7 @@ TEST(VectorExt, VecBulkPushNull) {
 }
 
 TEST(VectorExt, VecBulkPushOk) {
-	vector vec = {
-		.data = nullptr,
-		.count = 0,
-		._type_size = sizeof(char),
-		._alloc_count = 0,
-	};
+	vector vec = vec_init(sizeof(char));
 
 	EXPECT_EQ(vec_bulk_push(&vec, elements0, 3), VECTOR_STATUS_OK);
 	EXPECT_NE(vec.data, nullptr);
@@ -52,6 +73,79 @@ TEST(VectorExt, VecBulkPushOk) {
 	free(vec.data);
 }
 
+TEST(VectorExt, VecBulkPushInline) {
+	char buffer[4];
+	vector vec = vec_init_inline(sizeof(char), buffer, 4);
+
+	EXPECT_EQ(vec_bulk_push(&vec, elements0, 3), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.data, buffer);
+
+	// Overflow moves elements to the heap
+	EXPECT_EQ(vec_bulk_insert(&vec, 1, elements1, 3), VECTOR_STATUS_OK);
+	EXPECT_NE(vec.data, buffer);
+	EXPECT_EQ(vec.count, 6);
+	EXPECT_EQ(*((char *)vec.data), element0);
+	EXPECT_EQ(*((char *)vec.data + 1), element2);
+	EXPECT_EQ(*((char *)vec.data + 4), element1);
+	EXPECT_EQ(*((char *)vec.data + 5), element2);
+
+	EXPECT_EQ(vec_bulk_erase(&vec, 0, nullptr, 2), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.count, 4);
+	EXPECT_EQ(*((char *)vec.data), element0);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+
+TEST(VectorExt, VecBulkPushAligned) {
+	vector vec = vec_init_aligned(sizeof(char), 64, false);
+
+	for (int i = 0; i < 100; i++) {
+		EXPECT_EQ(vec_bulk_push(&vec, elements0, 3), VECTOR_STATUS_OK);
+		EXPECT_EQ((uintptr_t)vec.data % 64, 0);
+	}
+	EXPECT_EQ(vec_bulk_insert(&vec, 0, elements1, 3), VECTOR_STATUS_OK);
+	EXPECT_EQ((uintptr_t)vec.data % 64, 0);
+	EXPECT_EQ(vec.count, 303);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+
+TEST(VectorExt, VecBulkShared) {
+	vector vec = vec_init(sizeof(char));
+	vec_bulk_push(&vec, elements0, 3);
+
+	vector push_vec = vec_init_clone_cow(&vec);
+	vector insert_vec = vec_init_clone_cow(&vec);
+	vector erase_vec = vec_init_clone_cow(&vec);
+
+	EXPECT_EQ(vec_bulk_push(&push_vec, elements1, 1), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_bulk_insert(&insert_vec, 0, elements1, 1), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_bulk_erase(&erase_vec, 0, nullptr, 2), VECTOR_STATUS_OK);
+
+	// Original is untouched
+	EXPECT_EQ(vec.count, 3);
+	EXPECT_EQ(*((char *)vec.data), element0);
+	EXPECT_EQ(*((char *)vec.data + 2), element2);
+
+	EXPECT_EQ(*((char *)push_vec.data + 3), element2);
+	EXPECT_EQ(*((char *)insert_vec.data), element2);
+	EXPECT_EQ(*((char *)erase_vec.data), element2);
+
+	vec_deinit(&vec);
+	vec_deinit(&push_vec);
+	vec_deinit(&insert_vec);
+	vec_deinit(&erase_vec);
+}
+
+TEST(VectorExt, VecBulkPushOverflow) {
+	vector vec = vec_init(sizeof(int));
+
+	EXPECT_EQ(vec_bulk_push(&vec, int_elements0, SIZE_MAX / 2),
+		VECTOR_STATUS_OVERFLOW);
+	EXPECT_EQ(vec.data, nullptr);
+	EXPECT_EQ(vec.count, 0);
+}
+
 TEST(VectorExt, VecBulkInsertNull) {
 	vector *vec = nullptr;
 
@@ -59,12 +153,7 @@ TEST(VectorExt, VecBulkInsertNull) {
 }
 
 TEST(VectorExt, VecBulkInsertBounds) {
-	vector vec = {
-		.data = nullptr,
-		.count = 0,
-		._type_size = sizeof(char),
-		._alloc_count = 0,
-	};
+	vector vec = vec_init(sizeof(char));
 
 	char elements[] = { element0, element1, element2 };
 
@@ -74,12 +163,7 @@ TEST(VectorExt, VecBulkInsertBounds) {
 }
 
 TEST(VectorExt, VecBulkInsertOk) {
-	vector vec = {
-		.data = nullptr,
-		.count = 0,
-		._type_size = sizeof(char),
-		._alloc_count = 0,
-	};
+	vector vec = vec_init(sizeof(char));
 
 	EXPECT_EQ(vec_bulk_insert(&vec, 0, elements0, 3), VECTOR_STATUS_OK);
 	EXPECT_NE(vec.data, nullptr);
@@ -103,12 +187,7 @@ TEST(VectorExt, VecBulkInsertOk) {
 }
 
 TEST(VectorExt, VecBulkInsertOkMultibyte) {
-	vector vec = {
-		.data = nullptr,
-		.count = 0,
-		._type_size = sizeof(int),
-		._alloc_count = 0,
-	};
+	vector vec = vec_init(sizeof(int));
 
 	EXPECT_EQ(vec_bulk_insert(&vec, 0, int_elements0, 3), VECTOR_STATUS_OK);
 	EXPECT_NE(vec.data, nullptr);
@@ -138,12 +217,10 @@ TEST(VectorExt, VecEraseNull) {
 }
 
 TEST(VectorExt, VecEraseBounds) {
-	vector vec = {
-		.data = malloc(sizeof(char) * 2),
-		.count = 2,
-		._type_size = sizeof(char),
-		._alloc_count = 2,
-	};
+	vector vec = vec_init(sizeof(char));
+	vec.data = malloc(sizeof(char) * 2);
+	vec.count = 2;
+	vec._alloc_count = 2;
 
 	*((char *)vec.data) = element0;
 	*((char *)vec.data + 1) = element1;
@@ -154,6 +231,10 @@ TEST(VectorExt, VecEraseBounds) {
 	EXPECT_EQ(vec_bulk_erase(&vec, 1, nullptr, 2), VECTOR_STATUS_BOUNDS);
 	EXPECT_EQ(vec.count, 2);
 
+	// More than the element count
+	EXPECT_EQ(vec_bulk_erase(&vec, 0, nullptr, 3), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec.count, 2);
+
 	EXPECT_EQ(vec_bulk_erase(&vec, 0, nullptr, 2), VECTOR_STATUS_OK);
 	EXPECT_EQ(vec.count, 0);
 
@@ -161,12 +242,10 @@ TEST(VectorExt, VecEraseBounds) {
 }
 
 TEST(VectorExt, VecEraseOk) {
-	vector vec = {
-		.data = malloc(sizeof(char) * 9),
-		.count = 9,
-		._type_size = sizeof(char),
-		._alloc_count = 9,
-	};
+	vector vec = vec_init(sizeof(char));
+	vec.data = malloc(sizeof(char) * 9);
+	vec.count = 9;
+	vec._alloc_count = 9;
 
 	// elements0
 	*((char *)vec.data) = element0;
@@ -207,3 +286,603 @@ TEST(VectorExt, VecEraseOk) {
 
 	free(vec.data);
 }
+
+TEST(VectorExt, VecSortNull) {
+	vector vec = vec_init(sizeof(int));
+
+	EXPECT_EQ(vec_sort(nullptr, compare_int), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_sort(&vec, nullptr), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_sort_u32(nullptr), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_sort_u64(nullptr), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_sort_key_u32(nullptr, 0), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_sort_key_u64(nullptr, 0), VECTOR_STATUS_NULL);
+}
+
+TEST(VectorExt, VecSortOk) {
+	vector vec = vec_init(sizeof(int));
+	std::vector<int> expected;
+
+	uint64_t state = 1;
+	for (int i = 0; i < 10000; i++) {
+		int value = (int)(next_random(&state) % 1000) - 500;
+		vec_push(&vec, &value);
+		expected.push_back(value);
+	}
+	std::sort(expected.begin(), expected.end());
+
+	EXPECT_EQ(vec_sort(&vec, compare_int), VECTOR_STATUS_OK);
+	EXPECT_EQ(memcmp(vec.data, expected.data(), sizeof(int) * 10000), 0);
+
+	vec_deinit(&vec);
+}
+
+TEST(VectorExt, VecSortPatterns) {
+	vector vec = vec_init(sizeof(int));
+
+	// Sorted, reversed and constant runs
+	for (int i = 0; i < 3000; i++) {
+		int value = (i < 1000) ? i : (i < 2000) ? 3000 - i : 7;
+		vec_push(&vec, &value);
+	}
+
+	EXPECT_EQ(vec_sort(&vec, compare_int), VECTOR_STATUS_OK);
+	for (size_t i = 1; i < vec.count; i++) {
+		EXPECT_LE(*(int *)vec_at(&vec, i - 1), *(int *)vec_at(&vec, i));
+	}
+
+	vec_deinit(&vec);
+}
+
+TEST(VectorExt, VecSortMultibyte) {
+	vector vec = vec_init(sizeof(record));
+
+	uint64_t state = 2;
+	for (uint32_t i = 0; i < 1000; i++) {
+		record rec = { .id = i, .key = next_random(&state) % 100, .tag = 'x' };
+		vec_push(&vec, &rec);
+	}
+
+	EXPECT_EQ(vec_sort(&vec, compare_record), VECTOR_STATUS_OK);
+	for (size_t i = 1; i < vec.count; i++) {
+		const record *prev = (const record *)vec_at(&vec, i - 1);
+		const record *cur = (const record *)vec_at(&vec, i);
+		EXPECT_LE(prev->key, cur->key);
+		EXPECT_EQ(cur->tag, 'x');
+	}
+
+	vec_deinit(&vec);
+}
+
+TEST(VectorExt, VecSortU32Bounds) {
+	vector vec = vec_init(sizeof(uint64_t));
+
+	EXPECT_EQ(vec_sort_u32(&vec), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec_sort_key_u64(&vec, 1), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec_sort_key_u32(&vec, 5), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec_sort_key_u32(&vec, 4), VECTOR_STATUS_OK);
+}
+
+TEST(VectorExt, VecSortU32Ok) {
+	vector vec = vec_init(sizeof(uint32_t));
+	std::vector<uint32_t> expected;
+
+	uint64_t state = 3;
+	for (int i = 0; i < 10000; i++) {
+		uint32_t value = (uint32_t)next_random(&state);
+		vec_push(&vec, &value);
+		expected.push_back(value);
+	}
+	std::sort(expected.begin(), expected.end());
+
+	EXPECT_EQ(vec_sort_u32(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(memcmp(vec.data, expected.data(), sizeof(uint32_t) * 10000), 0);
+
+	vec_deinit(&vec);
+}
+
+TEST(VectorExt, VecSortU64Ok) {
+	vector vec = vec_init(sizeof(uint64_t));
+	std::vector<uint64_t> expected;
+
+	// Only low bytes vary, so most passes are skipped
+	uint64_t state = 4;
+	for (int i = 0; i < 10000; i++) {
+		uint64_t value = (i % 2 == 0) ? next_random(&state) : i % 300;
+		vec_push(&vec, &value);
+		expected.push_back(value);
+	}
+	std::sort(expected.begin(), expected.end());
+
+	EXPECT_EQ(vec_sort_u64(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(memcmp(vec.data, expected.data(), sizeof(uint64_t) * 10000), 0);
+
+	vec_deinit(&vec);
+}
+
+TEST(VectorExt, VecSortKeyOk) {
+	vector vec = vec_init(sizeof(record));
+
+	uint64_t state = 5;
+	for (uint32_t i = 0; i < 5000; i++) {
+		record rec = { .id = i, .key = next_random(&state) % 50, .tag = 'y' };
+		vec_push(&vec, &rec);
+	}
+
+	// Stable: equal keys keep id order
+	EXPECT_EQ(vec_sort_key_u64(&vec, offsetof(record, key)), VECTOR_STATUS_OK);
+	for (size_t i = 1; i < vec.count; i++) {
+		const record *prev = (const record *)vec_at(&vec, i - 1);
+		const record *cur = (const record *)vec_at(&vec, i);
+		EXPECT_LE(prev->key, cur->key);
+		if (prev->key == cur->key) {
+			EXPECT_LT(prev->id, cur->id);
+		}
+	}
+
+	// Sort back by id
+	EXPECT_EQ(vec_sort_key_u32(&vec, offsetof(record, id)), VECTOR_STATUS_OK);
+	for (uint32_t i = 0; i < 5000; i++) {
+		EXPECT_EQ(((const record *)vec_at(&vec, i))->id, i);
+	}
+
+	vec_deinit(&vec);
+}
+
+TEST(VectorExt, VecSortShared) {
+	vector vec = vec_init(sizeof(uint32_t));
+	uint32_t values[] = { 3, 1, 2 };
+	vec_bulk_push(&vec, values, 3);
+	vector cloned_vec = vec_init_clone_cow(&vec);
+
+	EXPECT_EQ(vec_sort_u32(&cloned_vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(*(uint32_t *)vec_at(&cloned_vec, 0), 1);
+	EXPECT_EQ(*(uint32_t *)vec_at(&vec, 0), 3);
+
+	vec_deinit(&vec);
+	vec_deinit(&cloned_vec);
+}
+
+TEST(VectorExt, VecSortParallelNull) {
+	vector vec = vec_init(sizeof(int));
+
+	EXPECT_EQ(vec_sort_parallel(nullptr, compare_int, 4, false),
+		VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_sort_parallel(&vec, nullptr, 4, false), VECTOR_STATUS_NULL);
+}
+
+TEST(VectorExt, VecSortParallelSmall) {
+	vector vec = vec_init(sizeof(record));
+
+	// Sorted on the calling thread, still stable
+	for (uint32_t i = 0; i < 100; i++) {
+		record rec = { .id = i, .key = i % 3, .tag = 'z' };
+		vec_push(&vec, &rec);
+	}
+
+	EXPECT_EQ(vec_sort_parallel(&vec, compare_record, 4, true),
+		VECTOR_STATUS_OK);
+	for (size_t i = 1; i < vec.count; i++) {
+		const record *prev = (const record *)vec_at(&vec, i - 1);
+		const record *cur = (const record *)vec_at(&vec, i);
+		EXPECT_TRUE(prev->key < cur->key
+			|| (prev->key == cur->key && prev->id < cur->id));
+	}
+
+	vec_deinit(&vec);
+}
+
+TEST(VectorExt, VecSortParallelOk) {
+	vector vec = vec_init(sizeof(int));
+	std::vector<int> expected;
+
+	uint64_t state = 6;
+	for (int i = 0; i < 300000; i++) {
+		int value = (int)(next_random(&state) % 100000);
+		vec_push(&vec, &value);
+		expected.push_back(value);
+	}
+	std::sort(expected.begin(), expected.end());
+
+	EXPECT_EQ(vec_sort_parallel(&vec, compare_int, 8, false),
+		VECTOR_STATUS_OK);
+	EXPECT_EQ(memcmp(vec.data, expected.data(), sizeof(int) * 300000), 0);
+
+	vec_deinit(&vec);
+}
+
+TEST(VectorExt, VecSortParallelStable) {
+	vector vec = vec_init(sizeof(record));
+	std::vector<record> expected;
+
+	// Heavy duplicates, more threads than chunks
+	uint64_t state = 7;
+	for (uint32_t i = 0; i < 200000; i++) {
+		record rec = { .id = i, .key = next_random(&state) % 20, .tag = 'w' };
+		vec_push(&vec, &rec);
+		expected.push_back(rec);
+	}
+	std::stable_sort(expected.begin(), expected.end(),
+		[](const record &a, const record &b) { return a.key < b.key; });
+
+	EXPECT_EQ(vec_sort_parallel(&vec, compare_record, 1000, true),
+		VECTOR_STATUS_OK);
+	for (size_t i = 0; i < vec.count; i++) {
+		const record *rec = (const record *)vec_at(&vec, i);
+		EXPECT_EQ(rec->id, expected[i].id);
+		EXPECT_EQ(rec->key, expected[i].key);
+	}
+
+	vec_deinit(&vec);
+}
+
+TEST(VectorExt, VecSortParallelEqual) {
+	// Equal keys are split across buckets, two keys and then a single one
+	for (uint32_t key_count = 2; key_count > 0; key_count--) {
+		vector vec = vec_init(sizeof(record));
+		for (uint32_t i = 0; i < 200000; i++) {
+			record rec = { .id = i, .key = i % key_count, .tag = 'e' };
+			vec_push(&vec, &rec);
+		}
+
+		EXPECT_EQ(vec_sort_parallel(&vec, compare_record, 8, true),
+			VECTOR_STATUS_OK);
+		for (size_t i = 1; i < vec.count; i++) {
+			const record *prev = (const record *)vec_at(&vec, i - 1);
+			const record *cur = (const record *)vec_at(&vec, i);
+			EXPECT_TRUE(prev->key < cur->key
+				|| (prev->key == cur->key && prev->id < cur->id));
+		}
+
+		EXPECT_EQ(vec_sort_parallel(&vec, compare_record, 8, false),
+			VECTOR_STATUS_OK);
+		for (size_t i = 1; i < vec.count; i++) {
+			const record *prev = (const record *)vec_at(&vec, i - 1);
+			const record *cur = (const record *)vec_at(&vec, i);
+			EXPECT_LE(prev->key, cur->key);
+		}
+
+		vec_deinit(&vec);
+	}
+}
+
+TEST(VectorExt, VecBoundNull) {
+	int key = 0;
+
+	EXPECT_EQ(vec_lower_bound(nullptr, &key, compare_int), 0);
+	EXPECT_EQ(vec_upper_bound(nullptr, &key, compare_int), 0);
+	EXPECT_EQ(vec_eytzinger_search(nullptr, &key, compare_int), 0);
+}
+
+TEST(VectorExt, VecBoundOk) {
+	vector vec = vec_init(sizeof(int));
+	int values[] = { 1, 3, 3, 3, 5, 7 };
+	vec_bulk_push(&vec, values, 6);
+
+	int key = 3;
+	EXPECT_EQ(vec_lower_bound(&vec, &key, compare_int), 1);
+	EXPECT_EQ(vec_upper_bound(&vec, &key, compare_int), 4);
+	key = 0;
+	EXPECT_EQ(vec_lower_bound(&vec, &key, compare_int), 0);
+	EXPECT_EQ(vec_upper_bound(&vec, &key, compare_int), 0);
+	key = 6;
+	EXPECT_EQ(vec_lower_bound(&vec, &key, compare_int), 5);
+	key = 8;
+	EXPECT_EQ(vec_lower_bound(&vec, &key, compare_int), 6);
+	EXPECT_EQ(vec_upper_bound(&vec, &key, compare_int), 6);
+
+	vec_deinit(&vec);
+}
+
+TEST(VectorExt, VecInsertSortedNull) {
+	vector vec = vec_init(sizeof(int));
+
+	EXPECT_EQ(vec_insert_sorted(nullptr, &int_elements0[0], compare_int),
+		VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_insert_sorted(&vec, &int_elements0[0], nullptr),
+		VECTOR_STATUS_NULL);
+}
+
+TEST(VectorExt, VecInsertSortedOk) {
+	vector vec = vec_init(sizeof(record));
+
+	// Equal elements are kept in insertion order
+	uint64_t keys[] = { 5, 1, 5, 3, 1 };
+	for (uint32_t i = 0; i < 5; i++) {
+		record rec = { .id = i, .key = keys[i], .tag = 'v' };
+		EXPECT_EQ(vec_insert_sorted(&vec, &rec, compare_record),
+			VECTOR_STATUS_OK);
+	}
+
+	uint32_t expected_ids[] = { 1, 4, 3, 0, 2 };
+	for (size_t i = 0; i < 5; i++) {
+		EXPECT_EQ(((const record *)vec_at(&vec, i))->id, expected_ids[i]);
+	}
+
+	vec_deinit(&vec);
+}
+
+TEST(VectorExt, VecEraseSortedNull) {
+	vector vec = vec_init(sizeof(int));
+	int key = 0;
+
+	EXPECT_EQ(vec_erase_sorted(nullptr, &key, nullptr, compare_int),
+		VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_erase_sorted(&vec, &key, nullptr, nullptr),
+		VECTOR_STATUS_NULL);
+}
+
+TEST(VectorExt, VecEraseSortedOk) {
+	vector vec = vec_init(sizeof(int));
+	int values[] = { 1, 3, 3, 5 };
+	vec_bulk_push(&vec, values, 4);
+
+	int key = 4;
+	EXPECT_EQ(vec_erase_sorted(&vec, &key, nullptr, compare_int),
+		VECTOR_STATUS_BOUNDS);
+	key = 6;
+	EXPECT_EQ(vec_erase_sorted(&vec, &key, nullptr, compare_int),
+		VECTOR_STATUS_BOUNDS);
+
+	key = 3;
+	int buffer = 0;
+	EXPECT_EQ(vec_erase_sorted(&vec, &key, &buffer, compare_int),
+		VECTOR_STATUS_OK);
+	EXPECT_EQ(buffer, 3);
+	EXPECT_EQ(vec.count, 3);
+	EXPECT_EQ(*(int *)vec_at(&vec, 1), 3);
+
+	vec_deinit(&vec);
+}
+
+TEST(VectorExt, VecEytzingerOk) {
+	vector vec = vec_init(sizeof(int));
+
+	// Even values 0, 2, ..., 1998
+	for (int i = 0; i < 1000; i++) {
+		int value = 2 * i;
+		vec_push(&vec, &value);
+	}
+
+	EXPECT_EQ(vec_eytzinger_build(nullptr), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_eytzinger_build(&vec), VECTOR_STATUS_OK);
+
+	// Root is the median
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), 1022);
+
+	for (int key = -1; key < 2001; key++) {
+		size_t index = vec_eytzinger_search(&vec, &key, compare_int);
+		if (key > 1998) {
+			EXPECT_EQ(index, vec.count);
+		} else {
+			int expected = (key <= 0) ? 0 : key + (key % 2);
+			EXPECT_EQ(*(int *)vec_at(&vec, index), expected);
+		}
+	}
+
+	vec_deinit(&vec);
+}
+
+template <typename T>
+static std::vector<T> random_set(size_t count, uint64_t seed, uint64_t range) {
+	std::vector<T> values;
+	for (size_t i = 0; i < count; i++) {
+		values.push_back((T)(next_random(&seed) % range));
+	}
+	std::sort(values.begin(), values.end());
+	values.erase(std::unique(values.begin(), values.end()), values.end());
+
+	return values;
+}
+
+template <typename T>
+static void expect_set_ops(
+	const std::vector<T> &lhs, const std::vector<T> &rhs) {
+	vector lhs_vec = vec_init(sizeof(T));
+	vector rhs_vec = vec_init(sizeof(T));
+	vector out = vec_init(sizeof(T));
+	vec_bulk_push(&lhs_vec, lhs.data(), lhs.size());
+	vec_bulk_push(&rhs_vec, rhs.data(), rhs.size());
+
+	std::vector<T> expected;
+	std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+		std::back_inserter(expected));
+	EXPECT_EQ(vec_set_intersect(&lhs_vec, &rhs_vec, &out), VECTOR_STATUS_OK);
+	EXPECT_EQ(std::vector<T>((T *)out.data, (T *)out.data + out.count),
+		expected);
+
+	expected.clear();
+	std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+		std::back_inserter(expected));
+	EXPECT_EQ(vec_set_union(&lhs_vec, &rhs_vec, &out), VECTOR_STATUS_OK);
+	EXPECT_EQ(std::vector<T>((T *)out.data, (T *)out.data + out.count),
+		expected);
+
+	expected.clear();
+	std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+		std::back_inserter(expected));
+	EXPECT_EQ(vec_set_difference(&lhs_vec, &rhs_vec, &out), VECTOR_STATUS_OK);
+	EXPECT_EQ(std::vector<T>((T *)out.data, (T *)out.data + out.count),
+		expected);
+
+	expected.clear();
+	std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+		std::back_inserter(expected));
+	EXPECT_EQ(vec_set_merge(&lhs_vec, &rhs_vec, &out), VECTOR_STATUS_OK);
+	EXPECT_EQ(std::vector<T>((T *)out.data, (T *)out.data + out.count),
+		expected);
+
+	vec_deinit(&lhs_vec);
+	vec_deinit(&rhs_vec);
+	vec_deinit(&out);
+}
+
+TEST(VectorExt, VecSetNull) {
+	vector vec = vec_init(sizeof(uint32_t));
+
+	EXPECT_EQ(vec_set_intersect(nullptr, &vec, &vec), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_set_union(&vec, nullptr, &vec), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_set_difference(&vec, &vec, nullptr), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_set_merge(nullptr, nullptr, nullptr), VECTOR_STATUS_NULL);
+}
+
+TEST(VectorExt, VecSetBounds) {
+	vector small = vec_init(sizeof(uint16_t));
+	vector lhs = vec_init(sizeof(uint32_t));
+	vector rhs = vec_init(sizeof(uint32_t));
+	vector wide = vec_init(sizeof(uint64_t));
+
+	EXPECT_EQ(vec_set_union(&small, &small, &rhs), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec_set_union(&lhs, &wide, &rhs), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec_set_union(&lhs, &rhs, &wide), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec_set_union(&lhs, &rhs, &lhs), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec_set_intersect(&lhs, &rhs, &rhs), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec_set_union(&lhs, &lhs, &rhs), VECTOR_STATUS_OK);
+}
+
+TEST(VectorExt, VecSetU32Ok) {
+	// Similar sizes, block comparisons
+	expect_set_ops<uint32_t>(random_set<uint32_t>(5000, 1, 20000),
+		random_set<uint32_t>(5000, 2, 20000));
+	expect_set_ops<uint32_t>(random_set<uint32_t>(1000, 3, 1000),
+		random_set<uint32_t>(900, 4, 1000));
+	expect_set_ops<uint32_t>(random_set<uint32_t>(7, 5, 30),
+		random_set<uint32_t>(0, 6, 30));
+
+	// One side much smaller, galloping search
+	expect_set_ops<uint32_t>(random_set<uint32_t>(50, 7, 100000),
+		random_set<uint32_t>(20000, 8, 100000));
+	expect_set_ops<uint32_t>(random_set<uint32_t>(20000, 9, 100000),
+		random_set<uint32_t>(50, 10, 100000));
+}
+
+TEST(VectorExt, VecSetU64Ok) {
+	expect_set_ops<uint64_t>(random_set<uint64_t>(5000, 11, 1ULL << 40),
+		random_set<uint64_t>(5000, 12, 1ULL << 40));
+	expect_set_ops<uint64_t>(random_set<uint64_t>(3000, 13, 5000),
+		random_set<uint64_t>(4000, 14, 5000));
+	expect_set_ops<uint64_t>(random_set<uint64_t>(10, 15, 5000),
+		random_set<uint64_t>(4000, 16, 5000));
+	expect_set_ops<uint64_t>(random_set<uint64_t>(4000, 17, 5000),
+		random_set<uint64_t>(10, 18, 5000));
+}
+
+TEST(VectorExt, VecSetShared) {
+	vector lhs = vec_init(sizeof(uint32_t));
+	vector rhs = vec_init(sizeof(uint32_t));
+	for (uint32_t i = 0; i < 100; i++) {
+		vec_push(&lhs, &i);
+		uint32_t value = 3 * i;
+		vec_push(&rhs, &value);
+	}
+
+	// Result replaces out without touching the clone source
+	vector out = vec_init_clone_cow(&lhs);
+	EXPECT_EQ(vec_set_intersect(&lhs, &rhs, &out), VECTOR_STATUS_OK);
+	EXPECT_EQ(out.count, 34);
+	EXPECT_EQ(*(uint32_t *)vec_at(&out, 33), 99);
+	EXPECT_EQ(lhs.count, 100);
+	EXPECT_EQ(*(uint32_t *)vec_at(&lhs, 33), 33);
+
+	vec_deinit(&lhs);
+	vec_deinit(&rhs);
+	vec_deinit(&out);
+}
+
+TEST(VectorExt, VecGatherNull) {
+	vector vec = vec_init(sizeof(uint32_t));
+
+	EXPECT_EQ(vec_gather(nullptr, &vec, &vec), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_gather(&vec, nullptr, &vec), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_scatter(&vec, &vec, nullptr), VECTOR_STATUS_NULL);
+}
+
+TEST(VectorExt, VecGatherBounds) {
+	vector src = vec_init(sizeof(uint64_t));
+	vector dst = vec_init(sizeof(uint64_t));
+	vector indices = vec_init(sizeof(uint32_t));
+	vector wide = vec_init(sizeof(uint64_t));
+	for (uint32_t i = 0; i < 10; i++) {
+		uint64_t value = i;
+		vec_push(&src, &value);
+		vec_push(&indices, &i);
+	}
+
+	EXPECT_EQ(vec_gather(&dst, &src, &wide), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec_gather(&src, &src, &indices), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec_gather(&indices, &src, &indices), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec_scatter(&dst, &src, &indices), VECTOR_STATUS_BOUNDS);
+
+	uint32_t past = 10;
+	vec_push(&indices, &past);
+	EXPECT_EQ(vec_gather(&dst, &src, &indices), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(dst.count, 0);
+
+	vec_deinit(&src);
+	vec_deinit(&dst);
+	vec_deinit(&indices);
+	vec_deinit(&wide);
+}
+
+TEST(VectorExt, VecGatherOk) {
+	// Specialized sizes, AVX2 sizes and a generic size
+	for (size_t size : { 1, 2, 3, 4, 8, 16 }) {
+		vector src = vec_init(size);
+		vector dst = vec_init(size);
+		vector indices = vec_init(sizeof(uint32_t));
+
+		uint64_t state = size;
+		std::vector<uint8_t> value(size);
+		for (int i = 0; i < 1000; i++) {
+			for (size_t k = 0; k < size; k++) {
+				value[k] = (uint8_t)next_random(&state);
+			}
+			vec_push(&src, value.data());
+		}
+		for (int i = 0; i < 1037; i++) {
+			uint32_t index = (uint32_t)(next_random(&state) % 1000);
+			vec_push(&indices, &index);
+		}
+
+		EXPECT_EQ(vec_gather(&dst, &src, &indices), VECTOR_STATUS_OK);
+		EXPECT_EQ(dst.count, 1037);
+		for (size_t i = 0; i < dst.count; i++) {
+			uint32_t index = *(uint32_t *)vec_at(&indices, i);
+			EXPECT_EQ(memcmp(vec_at(&dst, i), vec_at(&src, index), size), 0);
+		}
+
+		vec_deinit(&src);
+		vec_deinit(&dst);
+		vec_deinit(&indices);
+	}
+}
+
+TEST(VectorExt, VecScatterOk) {
+	for (size_t size : { 1, 2, 3, 4, 8, 16 }) {
+		vector src = vec_init(size);
+		vector dst = vec_init(size);
+		vector indices = vec_init(sizeof(uint32_t));
+
+		// Reverse permutation
+		std::vector<uint8_t> value(size);
+		for (uint32_t i = 0; i < 500; i++) {
+			memset(value.data(), (int)i, size);
+			vec_push(&src, value.data());
+			vec_push(&dst, value.data());
+			uint32_t index = 499 - i;
+			vec_push(&indices, &index);
+		}
+
+		vector shared = vec_init_clone_cow(&dst);
+		EXPECT_EQ(vec_scatter(&dst, &src, &indices), VECTOR_STATUS_OK);
+		EXPECT_EQ(dst.count, 500);
+		for (size_t i = 0; i < dst.count; i++) {
+			EXPECT_EQ(memcmp(vec_at(&dst, i), vec_at(&src, 499 - i), size), 0);
+		}
+		EXPECT_EQ(*(uint8_t *)vec_at(&shared, 0), 0);
+
+		vec_deinit(&src);
+		vec_deinit(&dst);
+		vec_deinit(&indices);
+		vec_deinit(&shared);
+	}
+}
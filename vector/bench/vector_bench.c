@@ -0,0 +1,81 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <c-utils/vector.h>
+
+#define COUNT 10000000
+#define ROUNDS 5
+
+VECTOR_DECLARE(u32vec, uint32_t)
+VECTOR_DEFINE(u32vec, uint32_t)
+
+// Keeps results alive, so loops are not optimized out
+static volatile uint64_t sink;
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void report(const char *name, double seconds) {
+	printf("%-20s %6.2f ns/element\n", name, seconds * 1e9 / COUNT / ROUNDS);
+}
+
+int main(void) {
+	vector vec = vec_init(sizeof(uint32_t));
+	vec_reserve(&vec, COUNT);
+	double start;
+
+	// Push, capacity reserved up front so only the call path is measured
+	start = now();
+	for (int round = 0; round < ROUNDS; round++) {
+		vec.count = 0;
+		for (uint32_t i = 0; i < COUNT; i++) {
+			vec_push(&vec, &i);
+		}
+	}
+	report("vec_push", now() - start);
+
+	start = now();
+	for (int round = 0; round < ROUNDS; round++) {
+		vec.count = 0;
+		for (uint32_t i = 0; i < COUNT; i++) {
+			vec_push_fast(&vec, &i);
+		}
+	}
+	report("vec_push_fast", now() - start);
+
+	start = now();
+	for (int round = 0; round < ROUNDS; round++) {
+		vec.count = 0;
+		for (uint32_t i = 0; i < COUNT; i++) {
+			u32vec_push(&vec, i);
+		}
+	}
+	report("u32vec_push", now() - start);
+
+	// Sequential reads
+	uint64_t sum = 0;
+	start = now();
+	for (int round = 0; round < ROUNDS; round++) {
+		for (size_t i = 0; i < vec.count; i++) {
+			sum += *(const uint32_t *)vec_at(&vec, i);
+		}
+	}
+	report("vec_at", now() - start);
+
+	start = now();
+	for (int round = 0; round < ROUNDS; round++) {
+		for (size_t i = 0; i < vec.count; i++) {
+			sum += *(const uint32_t *)vec_at_unchecked(&vec, i);
+		}
+	}
+	report("vec_at_unchecked", now() - start);
+
+	sink = sum;
+	vec_deinit(&vec);
+	return 0;
+}
@@ -8,8 +8,98 @@
  */
 #pragma once
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
+
+#include <c-utils/vector_config.h>
+
+#ifdef VECTOR_STATS
+#include <stdio.h>
+#endif
+
+/**
+ * @struct vector_allocator
+ * Custom memory allocator for vector storage.
+ *
+ * @var vector_allocator::alloc
+ * Allocate size bytes, returns NULL on failure.
+ * @var vector_allocator::resize
+ * Resize allocation at ptr from old_size to new_size bytes, preserving
+ * contents. Returns NULL on failure, leaving the allocation intact.
+ * @var vector_allocator::release
+ * Free allocation at ptr of size bytes.
+ * @var vector_allocator::ctx
+ * User context, passed to every call.
+ */
+typedef struct {
+	void *(*alloc)(void *ctx, size_t size);
+	void *(*resize)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+	void (*release)(void *ctx, void *ptr, size_t size);
+	void *ctx;
+} vector_allocator;
+
+/**
+ * @enum vector_growth_factor
+ * Capacity multiplier used when a vector grows.
+ *
+ * @var vector_growth_factor::VECTOR_GROWTH_DOUBLE
+ * Double the capacity (default).
+ *
+ * @var vector_growth_factor::VECTOR_GROWTH_HALF
+ * Grow capacity by half, trading more copies for less unused memory.
+ */
+typedef enum {
+	VECTOR_GROWTH_DOUBLE = 0,
+	VECTOR_GROWTH_HALF = 1,
+} vector_growth_factor;
+
+/**
+ * @struct vector_growth
+ * Growth policy for vector storage.
+ *
+ * @var vector_growth::factor
+ * Capacity multiplier.
+ * @var vector_growth::max_step
+ * Most elements added by one growth step, 0 for no limit. Capacity grows
+ * linearly once the factor would exceed it.
+ * @var vector_growth::usable_size
+ * Use the slack of the malloc size class as capacity (glibc only).
+ * @var vector_growth::auto_shrink
+ * Shrink storage when removals leave less than a quarter of it used.
+ */
+typedef struct {
+	vector_growth_factor factor;
+	size_t max_step;
+	bool usable_size;
+	bool auto_shrink;
+} vector_growth;
+
+#ifdef VECTOR_STATS
+/**
+ * @struct vector_stats
+ * Storage statistics, only available when built with VECTOR_STATS.
+ *
+ * @var vector_stats::tag
+ * Name shown by vec_stats_dump, may be NULL.
+ * @var vector_stats::reallocs
+ * Storage growth and shrink operations.
+ * @var vector_stats::bytes_moved
+ * Bytes copied by reallocation and moved by insertion and removal.
+ * @var vector_stats::live_bytes
+ * Owned storage in bytes. Inline and file storage is not counted.
+ * @var vector_stats::peak_bytes
+ * Largest value of live_bytes.
+ */
+typedef struct {
+	const char *tag;
+	size_t reallocs;
+	size_t bytes_moved;
+	size_t live_bytes;
+	size_t peak_bytes;
+} vector_stats;
+#endif
 
 /**
  * @struct vector
@@ -26,17 +116,76 @@
  * Size of contained type.
  * @var vector::_alloc_count
  * How many elements can fit in data.
+ * @var vector::_allocator
+ * Custom allocator, libc is used if NULL.
+ * @var vector::_flags
+ * Storage mode flags.
+ * @var vector::_fd
+ * Backing file descriptor, -1 if not file-backed.
+ * @var vector::_alignment
+ * Required data alignment in bytes, 0 for the allocator default.
+ * @var vector::_refcount
+ * Reference count of copy-on-write storage, NULL if not shared.
+ * @var vector::_growth
+ * Growth policy, default policy is used if NULL.
+ * @var vector::_stats
+ * Storage statistics, only present when built with VECTOR_STATS.
  *
  * @endinternal
  */
 typedef struct {
 	void *data;
-	uint32_t count;
+	size_t count;
 
 	size_t _type_size;
-	uint32_t _alloc_count;
+	size_t _alloc_count;
+	const vector_allocator *_allocator;
+	unsigned int _flags;
+	int _fd;
+	size_t _alignment;
+	size_t *_refcount;
+	const vector_growth *_growth;
+#ifdef VECTOR_STATS
+	vector_stats _stats;
+#endif
 } vector;
 
+/**
+ * @struct vector_writer
+ * Streaming vector file writer. Fields should not be edited.
+ *
+ * @internal
+ *
+ * @var vector_writer::_fd
+ * Output file descriptor.
+ * @var vector_writer::_type_size
+ * Size of contained type.
+ * @var vector_writer::_count
+ * Elements written so far.
+ * @var vector_writer::_start
+ * File offset of the header.
+ * @var vector_writer::_lanes
+ * Checksum state.
+ * @var vector_writer::_length
+ * Bytes added to the checksum.
+ * @var vector_writer::_tail
+ * Bytes not yet added to the checksum lanes.
+ * @var vector_writer::_tail_size
+ * Bytes used in _tail.
+ *
+ * @endinternal
+ */
+typedef struct {
+	int _fd;
+	size_t _type_size;
+	size_t _count;
+	int64_t _start;
+	uint64_t _lanes[4];
+	uint64_t _length;
+	unsigned char _tail[32];
+	size_t _tail_size;
+} vector_writer;
+
 /**
  * @enum vector_status
  * Result of vector operation.
@@ -49,11 +198,27 @@ typedef struct {
  *
  * @var vector_status::VECTOR_STATUS_BOUNDS
  * Operation was out of bounds.
+ *
+ * @var vector_status::VECTOR_STATUS_ALLOC
+ * Memory allocation failed.
+ *
+ * @var vector_status::VECTOR_STATUS_OVERFLOW
+ * Requested size is not addressable.
+ *
+ * @var vector_status::VECTOR_STATUS_IO
+ * File operation failed, errno is set.
+ *
+ * @var vector_status::VECTOR_STATUS_FORMAT
+ * File contents are not a compatible vector.
  */
 typedef enum {
 	VECTOR_STATUS_OK = 0,
 	VECTOR_STATUS_NULL = 1,
 	VECTOR_STATUS_BOUNDS = 2,
+	VECTOR_STATUS_ALLOC = 3,
+	VECTOR_STATUS_OVERFLOW = 4,
+	VECTOR_STATUS_IO = 5,
+	VECTOR_STATUS_FORMAT = 6,
 } vector_status;
 
 /**
@@ -74,11 +239,167 @@ vector vec_init(size_t type_size);
  */
 vector *vec_new(size_t type_size);
 
+/**
+ * @brief Create vector object on the stack with a custom allocator.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @param[in] allocator - Memory allocator, must outlive the vector.
+ * @return Vector object.
+ * @note Delete with vec_deinit.
+ */
+vector vec_init_alloc(size_t type_size, const vector_allocator *allocator);
+
+/**
+ * @brief Create vector object on the heap with a custom allocator.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @param[in] allocator - Memory allocator, must outlive the vector.
+ * @return Vector object, NULL if allocation failed.
+ * @note The object itself is also allocated with allocator.
+ * @note Delete with vec_delete.
+ */
+vector *vec_new_alloc(size_t type_size, const vector_allocator *allocator);
+
+/**
+ * @brief Create vector object on the stack, backed by a caller buffer.
+ *
+ * Elements are stored in buffer until it overflows, after which they are
+ * moved to the heap.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @param[in] buffer - Inline storage, must outlive the vector.
+ * @param[in] buffer_count - How many elements can fit in buffer.
+ * @return Vector object.
+ * @note Delete with vec_deinit.
+ */
+vector vec_init_inline(size_t type_size, void *buffer, size_t buffer_count);
+
+/**
+ * @brief Create vector object on the stack with aligned storage.
+ *
+ * Data is aligned on every growth, including clones and bulk operations.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @param[in] alignment - Data alignment in bytes, rounded up to a power of
+ * two no smaller than sizeof(void *).
+ * @param[in] pad_tail - Round storage up to a multiple of alignment, so that
+ * no other allocation shares the last aligned block (e.g. cache line).
+ * @return Vector object.
+ * @note Delete with vec_deinit.
+ */
+vector vec_init_aligned(size_t type_size, size_t alignment, bool pad_tail);
+
+/**
+ * @brief Create vector object on the heap with aligned storage.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @param[in] alignment - Data alignment in bytes, see vec_init_aligned.
+ * @param[in] pad_tail - Round storage up to a multiple of alignment.
+ * @return Vector object, NULL if allocation failed.
+ * @note Delete with vec_delete.
+ */
+vector *vec_new_aligned(size_t type_size, size_t alignment, bool pad_tail);
+
+/**
+ * @brief Open a vector backed by a file.
+ *
+ * The file is created if it does not exist. Elements are stored in a shared
+ * memory mapping of the file, so they are paged in lazily and changes are
+ * written back to the file.
+ *
+ * @param[out] vec - Vector object.
+ * @param[in] path - File path.
+ * @param[in] type_size - sizeof result of the desired type.
+ * @return Status code, VECTOR_STATUS_BOUNDS if type_size is 0.
+ * @note Delete with vec_deinit, which also records the element count.
+ * @note Not available with custom allocators or inline storage.
+ */
+vector_status vec_open_file(vector *vec, const char *path, size_t type_size);
+
+/**
+ * @brief Write a vector to a file descriptor.
+ *
+ * The header (type size, count and checksum) and the elements are written
+ * with a single writev call where possible. The format is the same as
+ * vec_open_file uses.
+ *
+ * @param[in] vec - Vector object.
+ * @param[in] fd - Output file descriptor.
+ * @return Status code.
+ */
+vector_status vec_write_fd(const vector *vec, int fd);
+
+/**
+ * @brief Read a vector written by vec_write_fd.
+ *
+ * @param[out] vec - Vector object.
+ * @param[in] fd - Input file descriptor.
+ * @param[in] type_size - sizeof result of the desired type.
+ * @return Status code, VECTOR_STATUS_FORMAT on a bad header, truncated file
+ * or checksum mismatch.
+ * @note Delete with vec_deinit.
+ */
+vector_status vec_read_fd(vector *vec, int fd, size_t type_size);
+
+/**
+ * @brief Map a vector file without copying it.
+ *
+ * Data points into a read-only memory mapping of the file. The first
+ * modification through the vector API (including vec_at_mut) copies the
+ * elements to the heap, so changes never reach the file.
+ *
+ * @param[out] vec - Vector object.
+ * @param[in] path - File path.
+ * @param[in] type_size - sizeof result of the desired type.
+ * @param[in] verify - Check the checksum, which reads the whole file.
+ * @return Status code.
+ * @note Delete with vec_deinit.
+ * @note Writing through data or vec_at_unchecked without vec_unshare faults.
+ */
+vector_status vec_map_readonly(vector *vec,
+	const char *path,
+	size_t type_size,
+	bool verify);
+
+/**
+ * @brief Start writing a vector file in chunks.
+ *
+ * A placeholder header is written at the current offset of fd.
+ *
+ * @param[out] writer - Writer object.
+ * @param[in] fd - Seekable output file descriptor.
+ * @param[in] type_size - sizeof result of the element type.
+ * @return Status code, VECTOR_STATUS_BOUNDS for a zero type size.
+ */
+vector_status vec_writer_open(vector_writer *writer, int fd, size_t type_size);
+
+/**
+ * @brief Append elements to a vector file.
+ *
+ * @param[in,out] writer - Writer object.
+ * @param[in] elements - Element array.
+ * @param[in] count - Element count.
+ * @return Status code.
+ */
+vector_status vec_writer_write(vector_writer *writer,
+	const void *elements,
+	size_t count);
+
+/**
+ * @brief Complete the header of a vector file.
+ *
+ * @param[in,out] writer - Writer object.
+ * @return Status code.
+ * @note The file descriptor is not closed.
+ */
+vector_status vec_writer_finish(vector_writer *writer);
+
 /**
  * @brief Clone a vector object on the stack.
  *
  * @param[in] vec - Original vector.
  * @return Cloned vector.
+ * @note Clone uses the same allocator and alignment as the original.
  */
 vector vec_init_clone(const vector *vec);
 
@@ -87,9 +408,33 @@ vector vec_init_clone(const vector *vec);
  *
  * @param[in] vec - Original vector.
  * @return Cloned vector.
+ * @note Clone uses the same allocator and alignment as the original.
  */
 vector *vec_new_clone(const vector *vec);
 
+/**
+ * @brief Clone a vector object on the stack, sharing storage.
+ *
+ * The original and the clone share a reference counted buffer until either
+ * of them is modified, at which point the modified vector takes a private
+ * copy. Cloning is O(1).
+ *
+ * @param[in,out] vec - Original vector, its storage becomes shared.
+ * @return Cloned vector.
+ * @note Inline and file storage is copied immediately.
+ * @note Shared vectors may be read and deleted from different threads.
+ */
+vector vec_init_clone_cow(vector *vec);
+
+/**
+ * @brief Clone a vector object on the heap, sharing storage.
+ *
+ * @param[in,out] vec - Original vector, its storage becomes shared.
+ * @return Cloned vector.
+ * @note See vec_init_clone_cow.
+ */
+vector *vec_new_clone_cow(vector *vec);
+
 /**
  * @brief Delete vector object from the stack.
  *
@@ -106,15 +451,81 @@ vector_status vec_deinit(vector *vec);
  */
 vector_status vec_delete(vector *vec);
 
+/**
+ * @brief Write a file-backed vector to its file.
+ *
+ * @param[in,out] vec - Vector object.
+ * @return Status code.
+ * @note Does nothing for vectors that are not file-backed.
+ */
+vector_status vec_sync(vector *vec);
+
+/**
+ * @brief Take a private copy of copy-on-write storage.
+ *
+ * Storage from vec_map_readonly is copied to the heap as well.
+ *
+ * @param[in,out] vec - Vector object.
+ * @return Status code.
+ * @note Called by every modifying function, does nothing for storage that
+ * is not shared or mapped.
+ */
+vector_status vec_unshare(vector *vec);
+
 /**
  * @brief Reserve space for elements.
  *
  * @param[in,out] vec - Vector object.
  * @param[in] count - Amount of elements to reserve.
- * @return Status code.
+ * @return Status code, VECTOR_STATUS_BOUNDS for a zero type size.
  * @note Will only grow the object.
  */
-vector_status vec_reserve(vector *vec, uint32_t count);
+vector_status vec_reserve(vector *vec, size_t count);
+
+/**
+ * @brief Grow storage to fit more elements, using the growth policy.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] more_count - How many more elements should fit.
+ * @return Status code, VECTOR_STATUS_BOUNDS for a zero type size.
+ * @note Will only grow the object.
+ * @note Also takes a private copy of shared storage, so elements may be
+ * written afterwards.
+ */
+vector_status vec_grow(vector *vec, size_t more_count);
+
+/**
+ * @brief Attach growth policy.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] growth - Growth policy, must outlive the vector. NULL restores
+ * the default policy.
+ * @return Status code.
+ * @note Clones share the policy of the original.
+ */
+vector_status vec_set_growth(vector *vec, const vector_growth *growth);
+
+/**
+ * @brief Release unused storage.
+ *
+ * @param[in,out] vec - Vector object.
+ * @return Status code.
+ * @note Inline, file-backed and still shared storage is left untouched.
+ */
+vector_status vec_shrink_to_fit(vector *vec);
+
+/**
+ * @brief Shrink storage if the growth policy allows it and it is mostly
+ * unused.
+ *
+ * Storage shrinks to twice the element count once less than a quarter is
+ * used, so alternating pushes and removals do not reallocate every time.
+ *
+ * @param[in,out] vec - Vector object.
+ * @return Status code.
+ * @note Called by functions that remove elements.
+ */
+vector_status vec_auto_shrink(vector *vec);
 
 /**
  * @brief Add element to the end.
@@ -133,7 +544,7 @@ vector_status vec_push(vector *vec, const void *value);
  * @param[in] value - New element.
  * @return Status code.
  */
-vector_status vec_insert(vector *vec, uint32_t index, const void *value);
+vector_status vec_insert(vector *vec, size_t index, const void *value);
 
 /**
  * @brief Remove element at specified location.
@@ -143,7 +554,35 @@ vector_status vec_insert(vector *vec, uint32_t index, const void *value);
  * @param[out] buffer - If not NULL, erased value placed here.
  * @return Status code.
  */
-vector_status vec_erase(vector *vec, uint32_t index, void *buffer);
+vector_status vec_erase(vector *vec, size_t index, void *buffer);
+
+/**
+ * @brief Remove element at specified location, moving the last element into
+ * its place.
+ *
+ * O(1), but does not keep element order.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] index - Removal index.
+ * @param[out] buffer - If not NULL, erased value placed here.
+ * @return Status code.
+ */
+vector_status vec_swap_remove(vector *vec, size_t index, void *buffer);
+
+/**
+ * @brief Keep only elements matching a predicate.
+ *
+ * Kept elements are compacted in a single pass, moving runs of them at once,
+ * and keep their order.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] pred - Called once per element in order, returns true to keep.
+ * @param[in] ctx - User context, passed to every call.
+ * @return Status code.
+ */
+vector_status vec_retain(vector *vec,
+	bool (*pred)(const void *elem, void *ctx),
+	void *ctx);
 
 /**
  * @brief Access element at specified location (const).
@@ -152,22 +591,216 @@ vector_status vec_erase(vector *vec, uint32_t index, void *buffer);
  * @param[in] index - Access index.
  * @return Pointer to element (const).
  */
-const void *vec_at(const vector *vec, uint32_t index);
+const void *vec_at(const vector *vec, size_t index);
 
 /**
  * @brief Access element at specified location (mutable).
  *
- * @param[in] vec - Vector object.
+ * @param[in,out] vec - Vector object.
  * @param[in] index - Access index.
- * @return Pointer to element (mutable).
+ * @return Pointer to element (mutable), NULL if shared storage could not be
+ * copied.
+ */
+void *vec_at_mut(vector *vec, size_t index);
+
+/**
+ * @brief Access element at specified location without checks (const).
+ *
+ * Inlined into the caller, for loops that already keep index in range.
+ *
+ * @param[in] vec - Vector object, not NULL.
+ * @param[in] index - Access index, less than count.
+ * @return Pointer to element (const).
+ */
+static inline const void *vec_at_unchecked(const vector *vec, size_t index) {
+	return (const char *)vec->data + vec->_type_size * index;
+}
+
+/**
+ * @brief Add element to the end, inlined while capacity is left.
+ *
+ * Falls back to vec_push to grow or copy shared storage.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] value - New element.
+ * @return Status code.
  */
-void *vec_at_mut(const vector *vec, uint32_t index);
+static inline vector_status vec_push_fast(vector *vec, const void *value) {
+	if (vec == NULL || vec->count == vec->_alloc_count
+		|| vec->_refcount != NULL) {
+		return vec_push(vec, value);
+	}
+
+	// Constant sizes compile to a single move instead of a memcpy call
+	void *push_ptr = (char *)vec->data + vec->_type_size * vec->count;
+	switch (vec->_type_size) {
+	case 4:
+		memcpy(push_ptr, value, 4);
+		break;
+	case 8:
+		memcpy(push_ptr, value, 8);
+		break;
+	default:
+		memcpy(push_ptr, value, vec->_type_size);
+		break;
+	}
+
+	vec->count++;
+	return VECTOR_STATUS_OK;
+}
 
 /**
  * @brief Collect vector data array, resetting the vector.
  *
  * @param[in] vec - Vector object.
  * @return Data array.
- * @note User is responsible for freeing the memory.
+ * @note User is responsible for freeing the memory, using the vector's
+ * allocator if one was attached.
+ * @note Data in inline storage, a memory mapping or a file is returned as a
+ * heap copy. Inline and file storage is kept for reuse.
  */
 void *vec_collect(vector *vec);
+
+#ifdef VECTOR_STATS
+/**
+ * @brief Create a tagged vector object on the stack.
+ *
+ * @param[in] type_size - sizeof result of the desired type.
+ * @param[in] tag - Name shown by vec_stats_dump, must outlive the vector.
+ * @return Vector object.
+ * @note Without VECTOR_STATS this is vec_init.
+ */
+vector vec_init_tagged(size_t type_size, const char *tag);
+
+/**
+ * @brief Attach a tag to a vector object.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] tag - Name shown by vec_stats_dump, must outlive the vector.
+ * @return Status code.
+ * @note Without VECTOR_STATS this does nothing.
+ */
+vector_status vec_set_tag(vector *vec, const char *tag);
+
+/**
+ * @brief Record elements moved outside of the vector library.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] bytes - Bytes moved.
+ * @note Without VECTOR_STATS this does nothing.
+ */
+void vec_stats_move(vector *vec, size_t bytes);
+
+/**
+ * @brief Record storage assigned to the vector outside of the vector library.
+ *
+ * @param[in,out] vec - Vector object, after data and _alloc_count are set.
+ * @note Without VECTOR_STATS this does nothing.
+ */
+void vec_stats_adopt(vector *vec);
+
+/**
+ * @brief Get statistics of all vectors.
+ *
+ * @return Totals of every vector, live_bytes is the storage currently owned
+ * by all vectors.
+ * @note Only available with VECTOR_STATS.
+ */
+vector_stats vec_stats_total(void);
+
+/**
+ * @brief Print statistics of a vector.
+ *
+ * @param[in] stream - Output stream.
+ * @param[in] vec - Vector object, NULL prints vec_stats_total.
+ * @note Without VECTOR_STATS this does nothing.
+ */
+void vec_stats_dump(FILE *stream, const vector *vec);
+#else
+// Statistics compile to nothing
+#define vec_init_tagged(type_size, tag) vec_init(type_size)
+#define vec_set_tag(vec, tag) VECTOR_STATUS_OK
+#define vec_stats_move(vec, bytes) ((void)0)
+#define vec_stats_adopt(vec) ((void)0)
+#define vec_stats_dump(stream, vec) ((void)0)
+#endif
+
+/**
+ * @def VECTOR_DECLARE(name, T)
+ * Declare type-specialized functions for a vector of T.
+ *
+ * Generated functions operate on a regular vector created with sizeof(T) and
+ * behave like their generic counterparts, but copy elements with plain
+ * assignments:
+ * - vector_status name_push(vector *vec, T value)
+ * - vector_status name_insert(vector *vec, size_t index, T value)
+ * - const T *name_at(const vector *vec, size_t index)
+ *
+ * @param name - Prefix for generated functions.
+ * @param T - Element type.
+ */
+#define VECTOR_DECLARE(name, T)                                                \
+	vector_status name##_push(vector *vec, T value);                           \
+	vector_status name##_insert(vector *vec, size_t index, T value);           \
+	const T *name##_at(const vector *vec, size_t index);
+
+/**
+ * @def VECTOR_DEFINE(name, T)
+ * Define type-specialized functions for a vector of T.
+ *
+ * @param name - Prefix for generated functions.
+ * @param T - Element type.
+ * @note Place in exactly one translation unit, see VECTOR_DECLARE.
+ */
+#define VECTOR_DEFINE(name, T)                                                 \
+	vector_status name##_push(vector *vec, T value) {                          \
+		if (vec == NULL) {                                                     \
+			return VECTOR_STATUS_NULL;                                         \
+		}                                                                      \
+                                                                               \
+		if (vec->count == vec->_alloc_count || vec->_refcount != NULL) {       \
+			vector_status status = vec_grow(vec, 1);                           \
+			if (status != VECTOR_STATUS_OK) {                                  \
+				return status;                                                 \
+			}                                                                  \
+		}                                                                      \
+                                                                               \
+		((T *)vec->data)[vec->count] = value;                                  \
+		vec->count++;                                                          \
+		return VECTOR_STATUS_OK;                                               \
+	}                                                                          \
+                                                                               \
+	vector_status name##_insert(vector *vec, size_t index, T value) {          \
+		if (vec == NULL) {                                                     \
+			return VECTOR_STATUS_NULL;                                         \
+		}                                                                      \
+                                                                               \
+		if (index > vec->count) {                                              \
+			return VECTOR_STATUS_BOUNDS;                                       \
+		}                                                                      \
+                                                                               \
+		if (vec->count == vec->_alloc_count || vec->_refcount != NULL) {       \
+			vector_status status = vec_grow(vec, 1);                           \
+			if (status != VECTOR_STATUS_OK) {                                  \
+				return status;                                                 \
+			}                                                                  \
+		}                                                                      \
+                                                                               \
+		vec_stats_move(vec, sizeof(T) * (vec->count - index));                 \
+		T *elements = (T *)vec->data;                                          \
+		for (size_t i = vec->count; i > index; i--) {                          \
+			elements[i] = elements[i - 1];                                     \
+		}                                                                      \
+                                                                               \
+		elements[index] = value;                                               \
+		vec->count++;                                                          \
+		return VECTOR_STATUS_OK;                                               \
+	}                                                                          \
+                                                                               \
+	const T *name##_at(const vector *vec, size_t index) {                      \
+		if (vec == NULL || index >= vec->count) {                              \
+			return NULL;                                                       \
+		}                                                                      \
+                                                                               \
+		return (const T *)vec->data + index;                                   \
+	}
@@ -0,0 +1,16 @@
+/**
+ * @file config.h
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.2
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Compile-time configuration.
+ */
+#pragma once
+
+// Move large storage to anonymous memory mappings
+#define ENABLE_MMAP 1
+// Storage size in bytes at which memory mappings are used
+#define MMAP_THRESHOLD (64 * 1024 * 1024)
+// Allow growth policies to use malloc_usable_size (glibc only)
+#define ENABLE_USABLE_SIZE 1
@@ -0,0 +1,190 @@
+/**
+ * @file file.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.2
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief File-backed vector storage.
+ */
+#define _GNU_SOURCE
+#include "file.h"
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "storage.h"
+
+// Mapping layout
+#define map_start(vec) ((file_header *)(vec)->data - 1)
+#define map_size(vec, count) (sizeof(file_header) + (vec)->_type_size * (count))
+
+static void *map_file(int fd, void *old_map, size_t old_size, size_t new_size);
+
+vector_status vec_open_file(vector *vec, const char *path, size_t type_size) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	// Element count of the file is not defined
+	if (type_size == 0) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	int fd = open(path, O_RDWR | O_CREAT, 0644);
+	if (fd < 0) {
+		return VECTOR_STATUS_IO;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) < 0) {
+		close(fd);
+		return VECTOR_STATUS_IO;
+	}
+
+	// Write header to a new file
+	size_t file_size = st.st_size;
+	if (file_size == 0) {
+		file_header header = {
+			.version = FILE_VERSION,
+			.type_size = type_size,
+			.count = 0,
+			.checksum = 0,
+		};
+		memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+
+		if (write(fd, &header, sizeof(header)) != (ssize_t)sizeof(header)) {
+			close(fd);
+			return VECTOR_STATUS_IO;
+		}
+
+		file_size = sizeof(header);
+	}
+
+	if (file_size < sizeof(file_header)) {
+		close(fd);
+		return VECTOR_STATUS_FORMAT;
+	}
+
+	file_header *header = map_file(fd, NULL, 0, file_size);
+	if (header == NULL) {
+		close(fd);
+		return VECTOR_STATUS_IO;
+	}
+
+	// Validate existing contents
+	size_t alloc_count = (file_size - sizeof(file_header)) / type_size;
+	if (memcmp(header->magic, FILE_MAGIC, sizeof(header->magic)) != 0
+		|| header->version != FILE_VERSION || header->type_size != type_size
+		|| header->count > alloc_count) {
+		munmap(header, file_size);
+		close(fd);
+		return VECTOR_STATUS_FORMAT;
+	}
+
+	// Elements are written in place, so a stored checksum would go stale
+	header->checksum = 0;
+
+	*vec = vec_init(type_size);
+	vec->data = header + 1;
+	vec->count = header->count;
+	vec->_alloc_count = alloc_count;
+	vec->_flags = FLAG_FILE;
+	vec->_fd = fd;
+
+	return VECTOR_STATUS_OK;
+}
+
+vector_status vec_sync(vector *vec) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (!(vec->_flags & FLAG_FILE)) {
+		return VECTOR_STATUS_OK;
+	}
+
+	file_header *header = map_start(vec);
+	header->count = vec->count;
+
+	if (msync(header, map_size(vec, vec->_alloc_count), MS_SYNC) < 0) {
+		return VECTOR_STATUS_IO;
+	}
+
+	return VECTOR_STATUS_OK;
+}
+
+vector_status vec_file_grow(vector *vec, size_t count) {
+	size_t old_size = map_size(vec, vec->_alloc_count);
+	size_t new_size = map_size(vec, count);
+
+	// Use the rest of the last page
+	size_t page = (size_t)sysconf(_SC_PAGESIZE);
+	if (new_size % page != 0 && new_size <= SIZE_MAX - page) {
+		new_size += page - new_size % page;
+		count = (new_size - sizeof(file_header)) / vec->_type_size;
+		new_size = map_size(vec, count);
+	}
+
+	if (ftruncate(vec->_fd, new_size) < 0) {
+		return VECTOR_STATUS_IO;
+	}
+
+	void *map = map_file(vec->_fd, map_start(vec), old_size, new_size);
+	if (map == NULL) {
+		return VECTOR_STATUS_IO;
+	}
+
+	vec->data = (file_header *)map + 1;
+	vec->_alloc_count = count;
+
+	return VECTOR_STATUS_OK;
+}
+
+void vec_file_release(vector *vec) {
+	file_header *header = map_start(vec);
+	header->count = vec->count;
+
+	munmap(header, map_size(vec, vec->_alloc_count));
+	close(vec->_fd);
+
+	vec->data = NULL;
+	vec->_alloc_count = 0;
+	vec->_flags &= ~FLAG_FILE;
+	vec->_fd = -1;
+}
+
+/**
+ * @brief Map or remap a file.
+ *
+ * @param[in] fd - File descriptor.
+ * @param[in] old_map - Existing mapping, may be NULL.
+ * @param[in] old_size - Existing mapping size in bytes.
+ * @param[in] new_size - Requested mapping size in bytes.
+ * @return Shared mapping of the file or NULL on failure.
+ */
+static void *map_file(int fd, void *old_map, size_t old_size, size_t new_size) {
+	void *map;
+
+#ifdef MREMAP_MAYMOVE
+	if (old_map != NULL) {
+		map = mremap(old_map, old_size, new_size, MREMAP_MAYMOVE);
+		return (map == MAP_FAILED) ? NULL : map;
+	}
+#endif
+
+	map = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (map == MAP_FAILED) {
+		return NULL;
+	}
+
+	if (old_map != NULL) {
+		munmap(old_map, old_size);
+	}
+
+	return map;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file file.h
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.2
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief File-backed vector storage.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vector.h"
+
+// File format
+#define FILE_MAGIC "CUTILVEC"
+#define FILE_VERSION 1
+
+/**
+ * @struct file_header
+ * Header at the start of a vector file, followed by the elements.
+ *
+ * @var file_header::magic
+ * FILE_MAGIC, not null-terminated.
+ * @var file_header::version
+ * FILE_VERSION at the time of writing.
+ * @var file_header::type_size
+ * Size of contained type.
+ * @var file_header::count
+ * Element count.
+ * @var file_header::checksum
+ * Checksum of the elements, 0 if not computed or opened by vec_open_file.
+ */
+typedef struct {
+	char magic[8];
+	uint32_t version;
+	uint32_t _reserved;
+	uint64_t type_size;
+	uint64_t count;
+	uint64_t checksum;
+	char _padding[24];
+} file_header;
+
+/**
+ * @brief Grow file-backed storage, preserving elements.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] count - New element capacity.
+ * @return Status code.
+ * @note Capacity may be rounded up to fill the last page.
+ */
+vector_status vec_file_grow(vector *vec, size_t count);
+
+/**
+ * @brief Record element count, unmap and close the file.
+ *
+ * @param[in,out] vec - Vector object.
+ */
+void vec_file_release(vector *vec);
@@ -0,0 +1,548 @@
+/**
+ * @file serialize.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.2
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Vector serialization.
+ */
+#define _GNU_SOURCE
+#include "serialize.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "file.h"
+#include "storage.h"
+
+// Checksum constants
+#define PRIME1 0x9e3779b185ebca87ULL
+#define PRIME2 0xc2b2ae3d27d4eb4fULL
+#define PRIME3 0x165667b19e3779f9ULL
+#define PRIME5 0x27d4eb2f165667c5ULL
+
+// Mapping layout
+#define map_start(vec) ((file_header *)(vec)->data - 1)
+#define map_size(vec, count) (sizeof(file_header) + (vec)->_type_size * (count))
+
+static void checksum_init(vector_writer *writer);
+static void checksum_update(vector_writer *writer,
+	const void *data,
+	size_t size);
+static uint64_t checksum_final(const vector_writer *writer);
+static uint64_t checksum(const void *data, size_t size);
+static void make_header(file_header *header,
+	size_t type_size,
+	size_t count,
+	uint64_t sum);
+static vector_status check_header(const file_header *header,
+	size_t type_size);
+static vector_status check_remaining(int fd, size_t size);
+static vector_status write_all(int fd, struct iovec *iov, int iov_count);
+static vector_status pwrite_all(int fd,
+	const void *data,
+	size_t size,
+	off_t offset);
+static vector_status read_all(int fd, void *data, size_t size);
+
+vector_status vec_write_fd(const vector *vec, int fd) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	size_t size = vec->_type_size * vec->count;
+	file_header header;
+	make_header(&header, vec->_type_size, vec->count,
+		checksum(vec->data, size));
+
+	// Header and elements in one call
+	struct iovec iov[2] = {
+		{ .iov_base = &header, .iov_len = sizeof(header) },
+		{ .iov_base = vec->data, .iov_len = size },
+	};
+
+	return write_all(fd, iov, (size > 0) ? 2 : 1);
+}
+
+vector_status vec_read_fd(vector *vec, int fd, size_t type_size) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	file_header header;
+	vector_status status = read_all(fd, &header, sizeof(header));
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	status = check_header(&header, type_size);
+	if (status == VECTOR_STATUS_OK) {
+		status = check_remaining(fd, type_size * header.count);
+	}
+
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	// Elements are read straight into storage
+	*vec = vec_init(type_size);
+	status = vec_reserve(vec, header.count);
+	if (status == VECTOR_STATUS_OK) {
+		status = read_all(fd, vec->data, type_size * header.count);
+	}
+
+	if (status == VECTOR_STATUS_OK && header.checksum != 0
+		&& checksum(vec->data, type_size * header.count) != header.checksum) {
+		status = VECTOR_STATUS_FORMAT;
+	}
+
+	if (status != VECTOR_STATUS_OK) {
+		vec_deinit(vec);
+		*vec = vec_init(type_size);
+		return status;
+	}
+
+	vec->count = header.count;
+	return VECTOR_STATUS_OK;
+}
+
+vector_status vec_map_readonly(vector *vec,
+	const char *path,
+	size_t type_size,
+	bool verify) {
+	if (vec == NULL || path == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return VECTOR_STATUS_IO;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) < 0) {
+		close(fd);
+		return VECTOR_STATUS_IO;
+	}
+
+	size_t file_size = st.st_size;
+	if (file_size < sizeof(file_header)) {
+		close(fd);
+		return VECTOR_STATUS_FORMAT;
+	}
+
+	file_header header;
+	vector_status status = read_all(fd, &header, sizeof(header));
+	if (status == VECTOR_STATUS_OK) {
+		status = check_header(&header, type_size);
+	}
+
+	// Elements must be in the file
+	if (status == VECTOR_STATUS_OK
+		&& header.count > (file_size - sizeof(file_header)) / type_size) {
+		status = VECTOR_STATUS_FORMAT;
+	}
+
+	if (status != VECTOR_STATUS_OK) {
+		close(fd);
+		return status;
+	}
+
+	// Read-only, vec_unshare copies to the heap before the first write
+	size_t size = sizeof(file_header) + type_size * header.count;
+	void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) {
+		return VECTOR_STATUS_IO;
+	}
+
+	*vec = vec_init(type_size);
+	vec->data = (file_header *)map + 1;
+	vec->count = header.count;
+	vec->_alloc_count = header.count;
+	vec->_flags = FLAG_MAPPED;
+
+	if (verify && header.checksum != 0
+		&& checksum(vec->data, type_size * header.count) != header.checksum) {
+		vec_deinit(vec);
+		*vec = vec_init(type_size);
+		return VECTOR_STATUS_FORMAT;
+	}
+
+	return VECTOR_STATUS_OK;
+}
+
+vector_status vec_writer_open(vector_writer *writer, int fd, size_t type_size) {
+	if (writer == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	// Element count of the file is not defined
+	if (type_size == 0) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	off_t start = lseek(fd, 0, SEEK_CUR);
+	if (start < 0) {
+		return VECTOR_STATUS_IO;
+	}
+
+	writer->_fd = fd;
+	writer->_type_size = type_size;
+	writer->_count = 0;
+	writer->_start = start;
+	checksum_init(writer);
+
+	// Placeholder, completed by vec_writer_finish
+	file_header header;
+	make_header(&header, type_size, 0, 0);
+	struct iovec iov = { .iov_base = &header, .iov_len = sizeof(header) };
+	return write_all(fd, &iov, 1);
+}
+
+vector_status vec_writer_write(vector_writer *writer,
+	const void *elements,
+	size_t count) {
+	if (writer == NULL || (elements == NULL && count > 0)) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (count == 0) {
+		return VECTOR_STATUS_OK;
+	}
+
+	if (count > SIZE_MAX / writer->_type_size) {
+		return VECTOR_STATUS_OVERFLOW;
+	}
+
+	size_t size = writer->_type_size * count;
+	struct iovec iov = { .iov_base = (void *)elements, .iov_len = size };
+	vector_status status = write_all(writer->_fd, &iov, 1);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	checksum_update(writer, elements, size);
+	writer->_count += count;
+	return VECTOR_STATUS_OK;
+}
+
+vector_status vec_writer_finish(vector_writer *writer) {
+	if (writer == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	file_header header;
+	make_header(&header, writer->_type_size, writer->_count,
+		checksum_final(writer));
+
+	return pwrite_all(writer->_fd, &header, sizeof(header), writer->_start);
+}
+
+void vec_mapped_release(vector *vec) {
+	munmap(map_start(vec), map_size(vec, vec->_alloc_count));
+}
+
+/**
+ * @brief Start a checksum.
+ *
+ * @param[out] writer - Writer holding the checksum state.
+ */
+static void checksum_init(vector_writer *writer) {
+	writer->_lanes[0] = PRIME1 + PRIME2;
+	writer->_lanes[1] = PRIME2;
+	writer->_lanes[2] = 0;
+	writer->_lanes[3] = -PRIME1;
+	writer->_length = 0;
+	writer->_tail_size = 0;
+}
+
+/**
+ * @brief Mix one word into a checksum lane.
+ *
+ * @param[in] lane - Lane value.
+ * @param[in] word - Input word.
+ * @return New lane value.
+ */
+static inline uint64_t checksum_round(uint64_t lane, uint64_t word) {
+	lane += word * PRIME2;
+	lane = (lane << 31) | (lane >> 33);
+	return lane * PRIME1;
+}
+
+/**
+ * @brief Add bytes to a checksum.
+ *
+ * Input is consumed in 32 byte stripes, one word per lane, so chunk
+ * boundaries do not change the result.
+ *
+ * @param[in,out] writer - Writer holding the checksum state.
+ * @param[in] data - Input bytes.
+ * @param[in] size - Input size in bytes.
+ */
+static void checksum_update(vector_writer *writer,
+	const void *data,
+	size_t size) {
+	const unsigned char *bytes = data;
+	writer->_length += size;
+
+	// Complete a stripe left over from the previous call
+	if (writer->_tail_size > 0) {
+		size_t fill = sizeof(writer->_tail) - writer->_tail_size;
+		if (fill > size) {
+			fill = size;
+		}
+
+		memcpy(writer->_tail + writer->_tail_size, bytes, fill);
+		writer->_tail_size += fill;
+		bytes += fill;
+		size -= fill;
+		if (writer->_tail_size < sizeof(writer->_tail)) {
+			return;
+		}
+
+		for (int i = 0; i < 4; i++) {
+			uint64_t word;
+			memcpy(&word, writer->_tail + 8 * i, sizeof(word));
+			writer->_lanes[i] = checksum_round(writer->_lanes[i], word);
+		}
+		writer->_tail_size = 0;
+	}
+
+	uint64_t lanes[4];
+	memcpy(lanes, writer->_lanes, sizeof(lanes));
+	for (; size >= 32; bytes += 32, size -= 32) {
+		for (int i = 0; i < 4; i++) {
+			uint64_t word;
+			memcpy(&word, bytes + 8 * i, sizeof(word));
+			lanes[i] = checksum_round(lanes[i], word);
+		}
+	}
+	memcpy(writer->_lanes, lanes, sizeof(lanes));
+
+	memcpy(writer->_tail, bytes, size);
+	writer->_tail_size = size;
+}
+
+/**
+ * @brief Finish a checksum.
+ *
+ * @param[in] writer - Writer holding the checksum state.
+ * @return Checksum, never 0.
+ */
+static uint64_t checksum_final(const vector_writer *writer) {
+	const uint64_t *lanes = writer->_lanes;
+	uint64_t sum = ((lanes[0] << 1) | (lanes[0] >> 63))
+		+ ((lanes[1] << 7) | (lanes[1] >> 57))
+		+ ((lanes[2] << 12) | (lanes[2] >> 52))
+		+ ((lanes[3] << 18) | (lanes[3] >> 46));
+	sum += writer->_length;
+
+	for (size_t i = 0; i < writer->_tail_size; i++) {
+		sum ^= writer->_tail[i] * PRIME5;
+		sum = ((sum << 11) | (sum >> 53)) * PRIME1;
+	}
+
+	// Avalanche
+	sum ^= sum >> 33;
+	sum *= PRIME2;
+	sum ^= sum >> 29;
+	sum *= PRIME3;
+	sum ^= sum >> 32;
+
+	// 0 marks files without a checksum
+	return (sum == 0) ? 1 : sum;
+}
+
+/**
+ * @brief Compute checksum of a buffer.
+ *
+ * @param[in] data - Input bytes.
+ * @param[in] size - Input size in bytes.
+ * @return Checksum, never 0.
+ */
+static uint64_t checksum(const void *data, size_t size) {
+	vector_writer state;
+	checksum_init(&state);
+	if (size > 0) {
+		checksum_update(&state, data, size);
+	}
+
+	return checksum_final(&state);
+}
+
+/**
+ * @brief Fill in a file header.
+ *
+ * @param[out] header - Header.
+ * @param[in] type_size - Size of contained type.
+ * @param[in] count - Element count.
+ * @param[in] sum - Checksum of the elements.
+ */
+static void make_header(file_header *header,
+	size_t type_size,
+	size_t count,
+	uint64_t sum) {
+	memset(header, 0, sizeof(*header));
+	memcpy(header->magic, FILE_MAGIC, sizeof(header->magic));
+	header->version = FILE_VERSION;
+	header->type_size = type_size;
+	header->count = count;
+	header->checksum = sum;
+}
+
+/**
+ * @brief Validate a file header.
+ *
+ * @param[in] header - Header.
+ * @param[in] type_size - Expected size of contained type.
+ * @return Status code.
+ */
+static vector_status check_header(const file_header *header,
+	size_t type_size) {
+	if (memcmp(header->magic, FILE_MAGIC, sizeof(header->magic)) != 0
+		|| header->version != FILE_VERSION || header->type_size != type_size
+		|| type_size == 0 || header->count > SIZE_MAX / type_size) {
+		return VECTOR_STATUS_FORMAT;
+	}
+
+	return VECTOR_STATUS_OK;
+}
+
+/**
+ * @brief Check that a regular file holds enough bytes after the offset.
+ *
+ * Keeps a corrupt count from allocating storage the file cannot fill.
+ *
+ * @param[in] fd - File descriptor.
+ * @param[in] size - Bytes about to be read.
+ * @return Status code, VECTOR_STATUS_FORMAT if the file is too short.
+ * @note Pipes and other streams are not checked.
+ */
+static vector_status check_remaining(int fd, size_t size) {
+	struct stat st;
+	if (fstat(fd, &st) < 0) {
+		return VECTOR_STATUS_IO;
+	}
+
+	if (!S_ISREG(st.st_mode)) {
+		return VECTOR_STATUS_OK;
+	}
+
+	off_t offset = lseek(fd, 0, SEEK_CUR);
+	if (offset < 0) {
+		return VECTOR_STATUS_IO;
+	}
+
+	if (offset > st.st_size || size > (uint64_t)(st.st_size - offset)) {
+		return VECTOR_STATUS_FORMAT;
+	}
+
+	return VECTOR_STATUS_OK;
+}
+
+/**
+ * @brief Write buffers, retrying partial writes.
+ *
+ * @param[in] fd - File descriptor.
+ * @param[in,out] iov - Buffers, without empty ones. Advanced while writing.
+ * @param[in] iov_count - Buffer count.
+ * @return Status code.
+ */
+static vector_status write_all(int fd, struct iovec *iov, int iov_count) {
+	while (iov_count > 0) {
+		ssize_t written = writev(fd, iov, iov_count);
+		if (written < 0 && errno == EINTR) {
+			continue;
+		}
+
+		if (written <= 0) {
+			return VECTOR_STATUS_IO;
+		}
+
+		// Skip what was written
+		size_t done = written;
+		while (iov_count > 0 && done >= iov->iov_len) {
+			done -= iov->iov_len;
+			iov++;
+			iov_count--;
+		}
+
+		if (iov_count > 0) {
+			iov->iov_base = (char *)iov->iov_base + done;
+			iov->iov_len -= done;
+		}
+	}
+
+	return VECTOR_STATUS_OK;
+}
+
+/**
+ * @brief Write buffer at an offset, retrying partial writes.
+ *
+ * @param[in] fd - File descriptor.
+ * @param[in] data - Buffer.
+ * @param[in] size - Buffer size in bytes.
+ * @param[in] offset - File offset.
+ * @return Status code.
+ */
+static vector_status pwrite_all(int fd,
+	const void *data,
+	size_t size,
+	off_t offset) {
+	const char *bytes = data;
+	while (size > 0) {
+		ssize_t written = pwrite(fd, bytes, size, offset);
+		if (written < 0 && errno == EINTR) {
+			continue;
+		}
+
+		if (written <= 0) {
+			return VECTOR_STATUS_IO;
+		}
+
+		bytes += written;
+		size -= written;
+		offset += written;
+	}
+
+	return VECTOR_STATUS_OK;
+}
+
+/**
+ * @brief Read buffer, retrying partial reads.
+ *
+ * @param[in] fd - File descriptor.
+ * @param[out] data - Buffer.
+ * @param[in] size - Buffer size in bytes.
+ * @return Status code, VECTOR_STATUS_FORMAT if the file ends early.
+ */
+static vector_status read_all(int fd, void *data, size_t size) {
+	char *bytes = data;
+	while (size > 0) {
+		ssize_t got = read(fd, bytes, size);
+		if (got < 0 && errno == EINTR) {
+			continue;
+		}
+
+		if (got < 0) {
+			return VECTOR_STATUS_IO;
+		}
+
+		if (got == 0) {
+			return VECTOR_STATUS_FORMAT;
+		}
+
+		bytes += got;
+		size -= got;
+	}
+
+	return VECTOR_STATUS_OK;
+}
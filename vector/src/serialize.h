@@ -0,0 +1,18 @@
+/**
+ * @file serialize.h
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.2
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Vector serialization.
+ */
+#pragma once
+
+#include "vector.h"
+
+/**
+ * @brief Unmap storage created by vec_map_readonly.
+ *
+ * @param[in,out] vec - Vector object.
+ */
+void vec_mapped_release(vector *vec);
@@ -0,0 +1,159 @@
+/**
+ * @file stats.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.2
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Vector storage statistics.
+ */
+#include "stats.h"
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "storage.h"
+
+#ifdef VECTOR_STATS
+
+// Storage not owned by the vector
+#define FLAGS_UNOWNED (FLAG_INLINE | FLAG_FILE | FLAG_MAPPED)
+
+// Totals of all vectors
+static size_t total_reallocs = 0;
+static size_t total_moved = 0;
+static size_t total_live = 0;
+static size_t total_peak = 0;
+
+static size_t owned_bytes(const vector *vec);
+static void add_live(vector *vec, size_t old_bytes, size_t new_bytes);
+
+vector vec_init_tagged(size_t type_size, const char *tag) {
+	vector vec = vec_init(type_size);
+	vec._stats.tag = tag;
+
+	return vec;
+}
+
+vector_status vec_set_tag(vector *vec, const char *tag) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	vec->_stats.tag = tag;
+	return VECTOR_STATUS_OK;
+}
+
+void vec_stats_move(vector *vec, size_t bytes) {
+	if (vec == NULL) {
+		return;
+	}
+
+	vec->_stats.bytes_moved += bytes;
+	__atomic_fetch_add(&total_moved, bytes, __ATOMIC_RELAXED);
+}
+
+void vec_stats_adopt(vector *vec) {
+	if (vec == NULL) {
+		return;
+	}
+
+	add_live(vec, 0, owned_bytes(vec));
+}
+
+vector_stats vec_stats_total(void) {
+	vector_stats stats = {
+		.tag = "total",
+		.reallocs = __atomic_load_n(&total_reallocs, __ATOMIC_RELAXED),
+		.bytes_moved = __atomic_load_n(&total_moved, __ATOMIC_RELAXED),
+		.live_bytes = __atomic_load_n(&total_live, __ATOMIC_RELAXED),
+		.peak_bytes = __atomic_load_n(&total_peak, __ATOMIC_RELAXED),
+	};
+
+	return stats;
+}
+
+void vec_stats_dump(FILE *stream, const vector *vec) {
+	if (vec == NULL) {
+		vector_stats stats = vec_stats_total();
+		fprintf(stream, "%s: reallocs=%zu moved=%zu live=%zu peak=%zu\n",
+			stats.tag, stats.reallocs, stats.bytes_moved, stats.live_bytes,
+			stats.peak_bytes);
+		return;
+	}
+
+	// Unused part of owned storage
+	const vector_stats *stats = &vec->_stats;
+	size_t used = vec->_type_size * vec->count;
+	size_t slack = (stats->live_bytes > used) ? stats->live_bytes - used : 0;
+
+	fprintf(stream,
+		"%s: reallocs=%zu moved=%zu live=%zu peak=%zu slack=%zu\n",
+		(stats->tag != NULL) ? stats->tag : "(untagged)", stats->reallocs,
+		stats->bytes_moved, stats->live_bytes, stats->peak_bytes, slack);
+}
+
+void vec_stats_resize(vector *vec, const void *data, size_t count) {
+	vec->_stats.reallocs++;
+	__atomic_fetch_add(&total_reallocs, 1, __ATOMIC_RELAXED);
+
+	// Elements were copied to new storage
+	if (vec->data != NULL && data != vec->data) {
+		vec_stats_move(vec, vec->_type_size * vec->count);
+	}
+
+	add_live(vec, owned_bytes(vec), vec->_type_size * count);
+}
+
+void vec_stats_release(vector *vec) {
+	add_live(vec, owned_bytes(vec), 0);
+}
+
+/**
+ * @brief Get storage owned by the vector.
+ *
+ * @param[in] vec - Vector object.
+ * @return Size in bytes.
+ */
+static size_t owned_bytes(const vector *vec) {
+	if (vec->data == NULL || (vec->_flags & FLAGS_UNOWNED)) {
+		return 0;
+	}
+
+	return vec->_type_size * vec->_alloc_count;
+}
+
+/**
+ * @brief Update owned storage size of a vector and the totals.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] old_bytes - Previous size in bytes.
+ * @param[in] new_bytes - Current size in bytes.
+ */
+static void add_live(vector *vec, size_t old_bytes, size_t new_bytes) {
+	vec->_stats.live_bytes = new_bytes;
+	if (new_bytes > vec->_stats.peak_bytes) {
+		vec->_stats.peak_bytes = new_bytes;
+	}
+
+	// Clamp at zero, storage may have been assigned without vec_stats_adopt
+	size_t live = __atomic_load_n(&total_live, __ATOMIC_RELAXED);
+	size_t next;
+	do {
+		if (new_bytes >= old_bytes) {
+			next = live + (new_bytes - old_bytes);
+		} else if (live > old_bytes - new_bytes) {
+			next = live - (old_bytes - new_bytes);
+		} else {
+			next = 0;
+		}
+	} while (!__atomic_compare_exchange_n(&total_live, &live, next, true,
+		__ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+	size_t peak = __atomic_load_n(&total_peak, __ATOMIC_RELAXED);
+	while (next > peak
+		&& !__atomic_compare_exchange_n(&total_peak, &peak, next, true,
+			__ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+	}
+}
+
+#endif
@@ -0,0 +1,34 @@
+/**
+ * @file stats.h
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.2
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Vector storage statistics.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "vector.h"
+
+#ifdef VECTOR_STATS
+/**
+ * @brief Record a storage resize, before vec is updated.
+ *
+ * @param[in,out] vec - Vector object with the old storage.
+ * @param[in] data - New storage.
+ * @param[in] count - New element capacity.
+ */
+void vec_stats_resize(vector *vec, const void *data, size_t count);
+
+/**
+ * @brief Record storage leaving the vector, before vec is updated.
+ *
+ * @param[in,out] vec - Vector object.
+ */
+void vec_stats_release(vector *vec);
+#else
+#define vec_stats_resize(vec, data, count) ((void)0)
+#define vec_stats_release(vec) ((void)0)
+#endif
@@ -0,0 +1,475 @@
+/**
+ * @file storage.c
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.2
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Vector storage management.
+ */
+#define _GNU_SOURCE
+#include "storage.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "config.h"
+#include "file.h"
+#include "serialize.h"
+#include "stats.h"
+
+#if ENABLE_USABLE_SIZE && defined(__GLIBC__)
+#include <malloc.h>
+#define HAVE_USABLE_SIZE 1
+#else
+#define HAVE_USABLE_SIZE 0
+#endif
+
+// Storage size in bytes
+#define data_size(vec, count) ((vec)->_type_size * (count))
+
+static void *mem_resize(const vector_allocator *allocator,
+	void *ptr,
+	size_t old_size,
+	size_t new_size);
+static void *map_resize(void *ptr, size_t old_size, size_t new_size);
+static void *aligned_resize(void *ptr,
+	size_t used_size,
+	size_t new_size,
+	size_t alignment);
+static size_t tail_round(const vector *vec, size_t size);
+static size_t usable_count(const vector *vec, void *data, size_t count);
+static size_t page_size(void);
+static size_t page_round(size_t size);
+
+void *vec_mem_alloc(const vector_allocator *allocator, size_t size) {
+	if (allocator == NULL) {
+		return malloc(size);
+	}
+
+	return allocator->alloc(allocator->ctx, size);
+}
+
+void vec_mem_free(const vector_allocator *allocator, void *ptr, size_t size) {
+	if (allocator == NULL) {
+		free(ptr);
+		return;
+	}
+
+	allocator->release(allocator->ctx, ptr, size);
+}
+
+vector_status vec_storage_grow(vector *vec, size_t count) {
+	if (vec->_flags & FLAG_FILE) {
+		return vec_file_grow(vec, count);
+	}
+
+	if (vec->_refcount != NULL) {
+		return vec_storage_unshare(vec, count);
+	}
+
+	size_t old_size = data_size(vec, vec->_alloc_count);
+	size_t new_size = data_size(vec, count);
+
+	// Large storage without a custom allocator is memory mapped
+	int use_map = ENABLE_MMAP && vec->_allocator == NULL
+		&& new_size >= MMAP_THRESHOLD && vec->_alignment <= page_size();
+	if (use_map) {
+		// Use the rest of the last page
+		count = page_round(new_size) / vec->_type_size;
+		new_size = data_size(vec, count);
+	}
+
+	// Keep the last aligned block to ourselves
+	size_t alloc_size = new_size;
+	if (!use_map) {
+		alloc_size = tail_round(vec, new_size);
+		count = alloc_size / vec->_type_size;
+	}
+
+	void *data;
+	if (vec->_flags & FLAG_MMAP) {
+		data = map_resize(vec->data, old_size, new_size);
+	} else if (use_map || (vec->_flags & (FLAG_INLINE | FLAG_MAPPED))) {
+		// Move elements to new storage
+		// clang-format off
+		data = use_map
+			? map_resize(NULL, 0, new_size)
+			: vec_mem_alloc(vec->_allocator, new_size);
+		// clang-format on
+		if (data != NULL && vec->count > 0) {
+			memcpy(data, vec->data, data_size(vec, vec->count));
+		}
+
+		if (data != NULL && (vec->_flags & FLAG_MAPPED)) {
+			vec_mapped_release(vec);
+		} else if (data != NULL && !(vec->_flags & FLAG_INLINE)) {
+			vec_mem_free(vec->_allocator, vec->data, old_size);
+		}
+	} else if (vec->_alignment != 0) {
+		data = aligned_resize(vec->data, data_size(vec, vec->count),
+			alloc_size, vec->_alignment);
+	} else {
+		data = mem_resize(vec->_allocator, vec->data, old_size, new_size);
+	}
+
+	if (data == NULL) {
+		return VECTOR_STATUS_ALLOC;
+	}
+
+	if (!use_map && !(vec->_flags & FLAG_MMAP)) {
+		count = usable_count(vec, data, count);
+	}
+
+	vec_stats_resize(vec, data, count);
+	vec->data = data;
+	vec->_alloc_count = count;
+	vec->_flags &= ~(FLAG_INLINE | FLAG_MAPPED);
+	if (use_map) {
+		vec->_flags |= FLAG_MMAP;
+	}
+
+	return VECTOR_STATUS_OK;
+}
+
+vector_status vec_storage_shrink(vector *vec, size_t count) {
+	if (vec->data == NULL || count >= vec->_alloc_count
+		|| (vec->_flags & (FLAG_INLINE | FLAG_FILE | FLAG_MAPPED))) {
+		return VECTOR_STATUS_OK;
+	}
+
+	// Other vectors still use shared storage, a sole owner drops the count
+	if (vec->_refcount != NULL) {
+		if (__atomic_load_n(vec->_refcount, __ATOMIC_ACQUIRE) != 1) {
+			return VECTOR_STATUS_OK;
+		}
+
+		vector_status status = vec_storage_unshare(vec, vec->_alloc_count);
+		if (status != VECTOR_STATUS_OK) {
+			return status;
+		}
+	}
+
+	size_t old_size = data_size(vec, vec->_alloc_count);
+	if (count == 0) {
+		vec_storage_release(vec);
+		vec->data = NULL;
+		vec->_alloc_count = 0;
+		vec->_flags &= ~FLAG_MMAP;
+		return VECTOR_STATUS_OK;
+	}
+
+	size_t new_size = data_size(vec, count);
+	int keep_map = (vec->_flags & FLAG_MMAP) && new_size >= MMAP_THRESHOLD;
+	if (keep_map) {
+		count = page_round(new_size) / vec->_type_size;
+		new_size = data_size(vec, count);
+		if (count >= vec->_alloc_count) {
+			return VECTOR_STATUS_OK;
+		}
+	} else {
+		new_size = tail_round(vec, new_size);
+		count = new_size / vec->_type_size;
+	}
+
+	void *data;
+	if (keep_map) {
+		data = map_resize(vec->data, old_size, new_size);
+	} else if (vec->_flags & FLAG_MMAP) {
+		// Small enough for the heap again
+		// clang-format off
+		data = (vec->_alignment != 0)
+			? aligned_resize(NULL, 0, new_size, vec->_alignment)
+			: vec_mem_alloc(NULL, new_size);
+		// clang-format on
+		if (data != NULL) {
+			memcpy(data, vec->data, data_size(vec, vec->count));
+			munmap(vec->data, old_size);
+		}
+	} else if (vec->_alignment != 0) {
+		data = aligned_resize(vec->data, data_size(vec, vec->count),
+			new_size, vec->_alignment);
+	} else {
+		data = mem_resize(vec->_allocator, vec->data, old_size, new_size);
+	}
+
+	if (data == NULL) {
+		return VECTOR_STATUS_ALLOC;
+	}
+
+	if (!keep_map) {
+		count = usable_count(vec, data, count);
+	}
+
+	vec_stats_resize(vec, data, count);
+	vec->data = data;
+	vec->_alloc_count = count;
+	if (!keep_map) {
+		vec->_flags &= ~FLAG_MMAP;
+	}
+
+	return VECTOR_STATUS_OK;
+}
+
+vector_status vec_storage_share(vector *vec) {
+	if (vec->_refcount == NULL) {
+		vec->_refcount = vec_mem_alloc(vec->_allocator, sizeof(size_t));
+		if (vec->_refcount == NULL) {
+			return VECTOR_STATUS_ALLOC;
+		}
+
+		*vec->_refcount = 1;
+	}
+
+	__atomic_fetch_add(vec->_refcount, 1, __ATOMIC_RELAXED);
+	return VECTOR_STATUS_OK;
+}
+
+vector_status vec_storage_unshare(vector *vec, size_t count) {
+	// Sole owner keeps the buffer
+	if (__atomic_load_n(vec->_refcount, __ATOMIC_ACQUIRE) == 1) {
+		vec_mem_free(vec->_allocator, vec->_refcount, sizeof(size_t));
+		vec->_refcount = NULL;
+
+		if (count > vec->_alloc_count) {
+			return vec_storage_grow(vec, count);
+		}
+
+		return VECTOR_STATUS_OK;
+	}
+
+	vector copy = *vec;
+	copy.data = NULL;
+	copy._alloc_count = 0;
+	copy._flags &= FLAG_PAD_TAIL;
+	copy._refcount = NULL;
+
+	vector_status status = vec_storage_grow(&copy, count);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	if (vec->count > 0) {
+		memcpy(copy.data, vec->data, data_size(vec, vec->count));
+	}
+
+	vec_storage_release(vec);
+	*vec = copy;
+
+	return VECTOR_STATUS_OK;
+}
+
+void vec_storage_release(vector *vec) {
+	if (vec->data == NULL || (vec->_flags & FLAG_INLINE)) {
+		return;
+	}
+
+	// Other vectors still use shared storage
+	if (vec->_refcount != NULL) {
+		if (__atomic_sub_fetch(vec->_refcount, 1, __ATOMIC_ACQ_REL) != 0) {
+			return;
+		}
+
+		vec_mem_free(vec->_allocator, vec->_refcount, sizeof(size_t));
+	}
+
+	vec_stats_release(vec);
+	if (vec->_flags & FLAG_FILE) {
+		vec_file_release(vec);
+	} else if (vec->_flags & FLAG_MAPPED) {
+		vec_mapped_release(vec);
+	} else if (vec->_flags & FLAG_MMAP) {
+		munmap(vec->data, data_size(vec, vec->_alloc_count));
+	} else {
+		vec_mem_free(vec->_allocator, vec->data,
+			data_size(vec, vec->_alloc_count));
+	}
+}
+
+void *vec_storage_take(vector *vec) {
+	if (vec->_refcount != NULL
+		&& vec_storage_unshare(vec, vec->_alloc_count) != VECTOR_STATUS_OK) {
+		return NULL;
+	}
+
+	if (!(vec->_flags & (FLAG_INLINE | FLAG_MMAP | FLAG_FILE | FLAG_MAPPED))) {
+		void *data = vec->data;
+
+		vec_stats_release(vec);
+		vec->data = NULL;
+		vec->_alloc_count = 0;
+		return data;
+	}
+
+	// Copy into memory the user can free
+	size_t size = data_size(vec, vec->count);
+	void *data = vec_mem_alloc(vec->_allocator, size);
+	if (data != NULL) {
+		memcpy(data, vec->data, size);
+	}
+
+	if (vec->_flags & (FLAG_MMAP | FLAG_MAPPED)) {
+		vec_storage_release(vec);
+		vec->data = NULL;
+		vec->_alloc_count = 0;
+		vec->_flags &= ~(FLAG_MMAP | FLAG_MAPPED);
+	}
+
+	return data;
+}
+
+/**
+ * @brief Resize memory, preserving contents.
+ *
+ * @param[in] allocator - Custom allocator or NULL for libc.
+ * @param[in] ptr - Existing allocation, may be NULL.
+ * @param[in] old_size - Current size in bytes.
+ * @param[in] new_size - Requested size in bytes.
+ * @return Resized memory or NULL on failure.
+ */
+static void *mem_resize(const vector_allocator *allocator,
+	void *ptr,
+	size_t old_size,
+	size_t new_size) {
+	if (allocator == NULL) {
+		return realloc(ptr, new_size);
+	}
+
+	if (ptr == NULL) {
+		return allocator->alloc(allocator->ctx, new_size);
+	}
+
+	return allocator->resize(allocator->ctx, ptr, old_size, new_size);
+}
+
+/**
+ * @brief Resize an anonymous memory mapping, preserving contents.
+ *
+ * @param[in] ptr - Existing mapping, may be NULL.
+ * @param[in] old_size - Current size in bytes.
+ * @param[in] new_size - Requested size in bytes.
+ * @return Resized mapping or NULL on failure.
+ * @note Pages are remapped instead of copied where supported.
+ */
+static void *map_resize(void *ptr, size_t old_size, size_t new_size) {
+	void *data;
+
+#ifdef MREMAP_MAYMOVE
+	if (ptr != NULL) {
+		data = mremap(ptr, old_size, new_size, MREMAP_MAYMOVE);
+		return (data == MAP_FAILED) ? NULL : data;
+	}
+#endif
+
+	data = mmap(NULL, new_size, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (data == MAP_FAILED) {
+		return NULL;
+	}
+
+	if (ptr != NULL) {
+		memcpy(data, ptr, (old_size < new_size) ? old_size : new_size);
+		munmap(ptr, old_size);
+	}
+
+	return data;
+}
+
+/**
+ * @brief Resize memory with a given alignment, preserving contents.
+ *
+ * @param[in] ptr - Existing allocation, may be NULL.
+ * @param[in] used_size - Amount of bytes to preserve.
+ * @param[in] new_size - Requested size in bytes.
+ * @param[in] alignment - Power of two multiple of sizeof(void *).
+ * @return Resized memory or NULL on failure.
+ * @note realloc does not keep alignment, so contents are always moved.
+ */
+static void *aligned_resize(void *ptr,
+	size_t used_size,
+	size_t new_size,
+	size_t alignment) {
+	void *data;
+	if (posix_memalign(&data, alignment, new_size) != 0) {
+		return NULL;
+	}
+
+	if (ptr != NULL) {
+		memcpy(data, ptr, used_size);
+		free(ptr);
+	}
+
+	return data;
+}
+
+/**
+ * @brief Round heap storage size up to the alignment if tail padding is on.
+ *
+ * @param[in] vec - Vector object.
+ * @param[in] size - Size in bytes.
+ * @return Rounded size, or size if padding is off or would overflow.
+ */
+static size_t tail_round(const vector *vec, size_t size) {
+	if (!(vec->_flags & FLAG_PAD_TAIL)) {
+		return size;
+	}
+
+	size_t remainder = size % vec->_alignment;
+	if (remainder == 0 || size > SIZE_MAX - vec->_alignment) {
+		return size;
+	}
+
+	return size + (vec->_alignment - remainder);
+}
+
+/**
+ * @brief Get capacity of heap storage including malloc slack.
+ *
+ * @param[in] vec - Vector object.
+ * @param[in] data - Heap storage.
+ * @param[in] count - Requested element capacity.
+ * @return Usable capacity if the growth policy asks for it, otherwise count.
+ * @note Only libc allocations are measured, custom allocators report count.
+ */
+static size_t usable_count(const vector *vec, void *data, size_t count) {
+#if HAVE_USABLE_SIZE
+	if (vec->_growth != NULL && vec->_growth->usable_size
+		&& vec->_allocator == NULL) {
+		size_t usable = malloc_usable_size(data) / vec->_type_size;
+		return (usable > count) ? usable : count;
+	}
+#else
+	(void)vec;
+	(void)data;
+#endif
+
+	return count;
+}
+
+/**
+ * @brief Get system page size.
+ *
+ * @return Page size in bytes.
+ */
+static size_t page_size(void) {
+	return (size_t)sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * @brief Round size up to a whole number of pages.
+ *
+ * @param[in] size - Size in bytes.
+ * @return Rounded size, or size if rounding would overflow.
+ */
+static size_t page_round(size_t size) {
+	size_t page = page_size();
+	size_t remainder = size % page;
+	if (remainder == 0 || size > SIZE_MAX - (page - remainder)) {
+		return size;
+	}
+
+	return size + (page - remainder);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file storage.h
+ * @author Vladyslav Aviedov <vladaviedov at protonmail dot com>
+ * @version 1.2
+ * @date 2024
+ * @license LGPLv3.0
+ * @brief Vector storage management.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "vector.h"
+
+// Storage flags
+#define FLAG_INLINE 0x1 // Data is in a caller buffer, not owned
+#define FLAG_MMAP 0x2 // Data is an anonymous memory mapping
+#define FLAG_FILE 0x4 // Data is a shared mapping of a file
+#define FLAG_PAD_TAIL 0x8 // Storage is rounded up to the alignment
+#define FLAG_MAPPED 0x10 // Data is a read-only mapping of a vector file
+
+/**
+ * @brief Allocate memory.
+ *
+ * @param[in] allocator - Custom allocator or NULL for libc.
+ * @param[in] size - Size in bytes.
+ * @return Allocated memory or NULL on failure.
+ */
+void *vec_mem_alloc(const vector_allocator *allocator, size_t size);
+
+/**
+ * @brief Free memory.
+ *
+ * @param[in] allocator - Custom allocator or NULL for libc.
+ * @param[in] ptr - Allocation to free.
+ * @param[in] size - Size in bytes.
+ */
+void vec_mem_free(const vector_allocator *allocator, void *ptr, size_t size);
+
+/**
+ * @brief Grow vector storage, preserving elements.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] count - New element capacity, byte size must not overflow.
+ * @return Status code.
+ * @note Capacity may be rounded up to fill the allocation.
+ */
+vector_status vec_storage_grow(vector *vec, size_t count);
+
+/**
+ * @brief Shrink vector storage, preserving elements.
+ *
+ * @param[in,out] vec - Vector object.
+ * @param[in] count - New element capacity, at least the element count.
+ * @return Status code.
+ * @note Inline, file-backed and still shared storage is left untouched.
+ * Storage dropping below the mapping threshold moves back to the heap.
+ */
+vector_status vec_storage_shrink(vector *vec, size_t count);
+
+/**
+ * @brief Mark vector storage as shared by one more vector.
+ *
+ * @param[in,out] vec - Vector object with heap or mapped storage.
+ * @return Status code.
+ */
+vector_status vec_storage_share(vector *vec);
+
+/**
+ * @brief Give vector a private copy of shared storage.
+ *
+ * @param[in,out] vec - Vector object with shared storage.
+ * @param[in] count - Element capacity of the copy, at least the current one.
+ * @return Status code.
+ * @note The buffer is kept without copying if no other vector shares it.
+ */
+vector_status vec_storage_unshare(vector *vec, size_t count);
+
+/**
+ * @brief Release vector storage.
+ *
+ * @param[in,out] vec - Vector object.
+ * @note Inline storage is left untouched, files are closed. Shared storage
+ * is freed by the last vector referencing it.
+ */
+void vec_storage_release(vector *vec);
+
+/**
+ * @brief Take vector data as a buffer owned by the vector's allocator.
+ *
+ * @param[in,out] vec - Vector object.
+ * @return Data buffer.
+ * @note Inline and file storage is copied and kept, other storage is
+ * detached.
+ */
+void *vec_storage_take(vector *vec);
@@ -10,66 +10,184 @@
 
 #include <stddef.h>
 #include <stdint.h>
-#include <stdlib.h>
 #include <string.h>
 
-// Growth factor
-#define FACTOR 2
+#include "stats.h"
+#include "storage.h"
+
+// Initial capacity of an empty vector
+#define MIN_CAPACITY 2
+// Storage is shrunk when less than 1 / SHRINK_RATIO of it is used
+#define SHRINK_RATIO 4
+// Capacity below which storage is never shrunk automatically
+#define SHRINK_MIN 64
 
 // Pointer arithmetic for elements
 #define ptr_at(vec, index) (vec->data + vec->_type_size * (index))
 
+// Checked multiplication
+#define mul_overflows(a, b) ((b) != 0 && (a) > SIZE_MAX / (b))
+
+static const vector_growth default_growth = {
+	.factor = VECTOR_GROWTH_DOUBLE,
+	.max_step = 0,
+	.usable_size = false,
+	.auto_shrink = false,
+};
+
+static size_t grow_count(const vector_growth *growth,
+	size_t alloc_count,
+	size_t min_count,
+	size_t max_count);
+
 vector vec_init(size_t type_size) {
+	return vec_init_alloc(type_size, NULL);
+}
+
+vector *vec_new(size_t type_size) {
+	return vec_new_alloc(type_size, NULL);
+}
+
+vector vec_init_alloc(size_t type_size, const vector_allocator *allocator) {
 	vector vec = {
 		.data = NULL,
 		._type_size = type_size,
 		.count = 0,
 		._alloc_count = 0,
+		._allocator = allocator,
+		._flags = 0,
+		._fd = -1,
+		._alignment = 0,
+		._refcount = NULL,
+		._growth = NULL,
 	};
 
 	return vec;
 }
 
-vector *vec_new(size_t type_size) {
-	vector *vec = malloc(sizeof(vector));
+vector *vec_new_alloc(size_t type_size, const vector_allocator *allocator) {
+	vector *vec = vec_mem_alloc(allocator, sizeof(vector));
+	if (vec == NULL) {
+		return NULL;
+	}
+
 	vec->data = NULL;
 	vec->_type_size = type_size;
 	vec->count = 0;
 	vec->_alloc_count = 0;
+	vec->_allocator = allocator;
+	vec->_flags = 0;
+	vec->_fd = -1;
+	vec->_alignment = 0;
+	vec->_refcount = NULL;
+	vec->_growth = NULL;
+#ifdef VECTOR_STATS
+	vec->_stats = (vector_stats) { 0 };
+#endif
+
+	return vec;
+}
+
+vector vec_init_inline(size_t type_size, void *buffer, size_t buffer_count) {
+	vector vec = {
+		.data = buffer,
+		._type_size = type_size,
+		.count = 0,
+		._alloc_count = buffer_count,
+		._allocator = NULL,
+		._flags = FLAG_INLINE,
+		._fd = -1,
+		._alignment = 0,
+		._refcount = NULL,
+		._growth = NULL,
+	};
 
 	return vec;
 }
 
+vector vec_init_aligned(size_t type_size, size_t alignment, bool pad_tail) {
+	vector vec = vec_init(type_size);
+
+	// posix_memalign needs a power of two multiple of sizeof(void *)
+	size_t normalized = sizeof(void *);
+	while (normalized < alignment && normalized <= SIZE_MAX / 2) {
+		normalized *= 2;
+	}
+
+	vec._alignment = normalized;
+	if (pad_tail) {
+		vec._flags = FLAG_PAD_TAIL;
+	}
+
+	return vec;
+}
+
+vector *vec_new_aligned(size_t type_size, size_t alignment, bool pad_tail) {
+	// Same path vec_delete frees through, storage has no allocator
+	vector *vec = vec_mem_alloc(NULL, sizeof(vector));
+	if (vec == NULL) {
+		return NULL;
+	}
+
+	*vec = vec_init_aligned(type_size, alignment, pad_tail);
+	return vec;
+}
+
 vector vec_init_clone(const vector *vec) {
-	uint32_t data_size = vec->_type_size * vec->count;
-	if (data_size == 0) {
-		return vec_init(vec->_type_size);
+	vector cloned_vec = vec_init_alloc(vec->_type_size, vec->_allocator);
+	cloned_vec._alignment = vec->_alignment;
+	cloned_vec._flags = vec->_flags & FLAG_PAD_TAIL;
+	cloned_vec._growth = vec->_growth;
+#ifdef VECTOR_STATS
+	cloned_vec._stats.tag = vec->_stats.tag;
+#endif
+	if (vec->count == 0) {
+		return cloned_vec;
 	}
 
-	vector cloned_vec = {
-		.data = malloc(data_size),
-		._type_size = vec->_type_size,
-		.count = vec->count,
-		._alloc_count = vec->count,
-	};
+	if (vec_storage_grow(&cloned_vec, vec->count) == VECTOR_STATUS_OK) {
+		memcpy(cloned_vec.data, vec->data, vec->_type_size * vec->count);
+		cloned_vec.count = vec->count;
+	}
 
-	memcpy(cloned_vec.data, vec->data, data_size);
 	return cloned_vec;
 }
 
 vector *vec_new_clone(const vector *vec) {
-	uint32_t data_size = vec->_type_size * vec->count;
-	if (data_size == 0) {
-		return vec_new(vec->_type_size);
+	vector *cloned_vec = vec_mem_alloc(vec->_allocator, sizeof(vector));
+	if (cloned_vec == NULL) {
+		return NULL;
+	}
+
+	*cloned_vec = vec_init_clone(vec);
+	return cloned_vec;
+}
+
+vector vec_init_clone_cow(vector *vec) {
+	if (vec->data == NULL || (vec->_flags & (FLAG_INLINE | FLAG_FILE))) {
+		return vec_init_clone(vec);
 	}
 
-	vector *cloned_vec = malloc(sizeof(vector));
-	cloned_vec->data = malloc(data_size);
-	cloned_vec->_type_size = vec->_type_size;
-	cloned_vec->count = vec->count;
-	cloned_vec->_alloc_count = vec->count;
+	if (vec_storage_share(vec) != VECTOR_STATUS_OK) {
+		return vec_init_clone(vec);
+	}
+
+	vector cloned_vec = *vec;
+#ifdef VECTOR_STATS
+	// Storage is owned by the original until it is copied
+	cloned_vec._stats = (vector_stats) { .tag = vec->_stats.tag };
+#endif
 
-	memcpy(cloned_vec->data, vec->data, data_size);
+	return cloned_vec;
+}
+
+vector *vec_new_clone_cow(vector *vec) {
+	vector *cloned_vec = vec_mem_alloc(vec->_allocator, sizeof(vector));
+	if (cloned_vec == NULL) {
+		return NULL;
+	}
+
+	*cloned_vec = vec_init_clone_cow(vec);
 	return cloned_vec;
 }
 
@@ -78,9 +196,7 @@ vector_status vec_deinit(vector *vec) {
 		return VECTOR_STATUS_NULL;
 	}
 
-	if (vec->data != NULL) {
-		free(vec->data);
-	}
+	vec_storage_release(vec);
 
 	return VECTOR_STATUS_OK;
 }
@@ -90,36 +206,124 @@ vector_status vec_delete(vector *vec) {
 		return VECTOR_STATUS_NULL;
 	}
 
-	free(vec);
+	vec_mem_free(vec->_allocator, vec, sizeof(vector));
+	return VECTOR_STATUS_OK;
+}
+
+vector_status vec_unshare(vector *vec) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (vec->_refcount != NULL) {
+		vector_status status = vec_storage_unshare(vec, vec->_alloc_count);
+		if (status != VECTOR_STATUS_OK) {
+			return status;
+		}
+	}
+
+	// Read-only mappings are copied before the first write
+	if (vec->_flags & FLAG_MAPPED) {
+		return vec_storage_grow(vec, vec->_alloc_count);
+	}
+
 	return VECTOR_STATUS_OK;
 }
 
-vector_status vec_reserve(vector *vec, uint32_t count) {
+vector_status vec_reserve(vector *vec, size_t count) {
 	if (vec == NULL) {
 		return VECTOR_STATUS_NULL;
 	}
 
 	if (count > vec->_alloc_count) {
-		vec->data = realloc(vec->data, vec->_type_size * count);
-		vec->_alloc_count = count;
+		// Capacity math divides by the type size
+		if (vec->_type_size == 0) {
+			return VECTOR_STATUS_BOUNDS;
+		}
+
+		if (mul_overflows(count, vec->_type_size)) {
+			return VECTOR_STATUS_OVERFLOW;
+		}
+
+		return vec_storage_grow(vec, count);
 	}
 
 	return VECTOR_STATUS_OK;
 }
 
+vector_status vec_grow(vector *vec, size_t more_count) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (vec->_type_size == 0) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	size_t max_count = SIZE_MAX / vec->_type_size;
+	if (more_count > max_count - vec->count) {
+		return VECTOR_STATUS_OVERFLOW;
+	}
+
+	// clang-format off
+	const vector_growth *growth = (vec->_growth != NULL)
+		? vec->_growth
+		: &default_growth;
+	// clang-format on
+	size_t new_count = grow_count(growth, vec->_alloc_count,
+		vec->count + more_count, max_count);
+
+	// Caller writes next, so shared storage is copied in the same step
+	if (vec->_refcount != NULL) {
+		return vec_storage_unshare(vec, new_count);
+	}
+
+	return vec_reserve(vec, new_count);
+}
+
+vector_status vec_set_growth(vector *vec, const vector_growth *growth) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	vec->_growth = growth;
+	return VECTOR_STATUS_OK;
+}
+
+vector_status vec_shrink_to_fit(vector *vec) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	return vec_storage_shrink(vec, vec->count);
+}
+
+vector_status vec_auto_shrink(vector *vec) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (vec->_growth == NULL || !vec->_growth->auto_shrink
+		|| vec->_alloc_count < SHRINK_MIN
+		|| vec->count >= vec->_alloc_count / SHRINK_RATIO) {
+		return VECTOR_STATUS_OK;
+	}
+
+	// Leave room to grow again without reallocating
+	return vec_storage_shrink(vec, vec->count * 2);
+}
+
 vector_status vec_push(vector *vec, const void *value) {
 	if (vec == NULL) {
 		return VECTOR_STATUS_NULL;
 	}
 
-	// New to grow vector
-	if (vec->count == vec->_alloc_count) {
-		// clang-format off
-		uint32_t new_count = (vec->data == NULL)
-			? FACTOR
-			: vec->_alloc_count * FACTOR;
-		// clang-format on
-		vec_reserve(vec, new_count);
+	// New to grow vector or copy shared storage
+	if (vec->count == vec->_alloc_count || vec->_refcount != NULL) {
+		vector_status status = vec_grow(vec, 1);
+		if (status != VECTOR_STATUS_OK) {
+			return status;
+		}
 	}
 
 	// Copy element
@@ -130,7 +334,7 @@ vector_status vec_push(vector *vec, const void *value) {
 	return VECTOR_STATUS_OK;
 }
 
-vector_status vec_insert(vector *vec, uint32_t index, const void *value) {
+vector_status vec_insert(vector *vec, size_t index, const void *value) {
 	if (vec == NULL) {
 		return VECTOR_STATUS_NULL;
 	}
@@ -140,18 +344,17 @@ vector_status vec_insert(vector *vec, uint32_t index, const void *value) {
 		return VECTOR_STATUS_BOUNDS;
 	}
 
-	// New to grow vector
-	if (vec->count == vec->_alloc_count) {
-		// clang-format off
-		uint32_t new_count = (vec->data == NULL)
-			? FACTOR
-			: vec->_alloc_count * FACTOR;
-		// clang-format on
-		vec_reserve(vec, new_count);
+	// New to grow vector or copy shared storage
+	if (vec->count == vec->_alloc_count || vec->_refcount != NULL) {
+		vector_status status = vec_grow(vec, 1);
+		if (status != VECTOR_STATUS_OK) {
+			return status;
+		}
 	}
 
 	// Move elements forwards
-	for (uint32_t i = vec->count; i > index; i--) {
+	vec_stats_move(vec, vec->_type_size * (vec->count - index));
+	for (size_t i = vec->count; i > index; i--) {
 		memcpy(ptr_at(vec, i), ptr_at(vec, i - 1), vec->_type_size);
 	}
 
@@ -162,7 +365,7 @@ vector_status vec_insert(vector *vec, uint32_t index, const void *value) {
 	return VECTOR_STATUS_OK;
 }
 
-vector_status vec_erase(vector *vec, uint32_t index, void *buffer) {
+vector_status vec_erase(vector *vec, size_t index, void *buffer) {
 	if (vec == NULL) {
 		return VECTOR_STATUS_NULL;
 	}
@@ -171,25 +374,99 @@ vector_status vec_erase(vector *vec, uint32_t index, void *buffer) {
 		return VECTOR_STATUS_BOUNDS;
 	}
 
+	vector_status status = vec_unshare(vec);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
 	// Copy element if needed
 	if (buffer != NULL) {
 		memcpy(buffer, ptr_at(vec, index), vec->_type_size);
 	}
 
 	// Move elements backwards
-	for (uint32_t i = index + 1; i < vec->count; i++) {
+	vec_stats_move(vec, vec->_type_size * (vec->count - index - 1));
+	for (size_t i = index + 1; i < vec->count; i++) {
 		memcpy(ptr_at(vec, i - 1), ptr_at(vec, i), vec->_type_size);
 	}
 	vec->count--;
 
+	// Best effort, the element is removed either way
+	vec_auto_shrink(vec);
 	return VECTOR_STATUS_OK;
 }
 
-const void *vec_at(const vector *vec, uint32_t index) {
-	return vec_at_mut(vec, index);
+vector_status vec_swap_remove(vector *vec, size_t index, void *buffer) {
+	if (vec == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	if (index >= vec->count) {
+		return VECTOR_STATUS_BOUNDS;
+	}
+
+	vector_status status = vec_unshare(vec);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	// Copy element if needed
+	if (buffer != NULL) {
+		memcpy(buffer, ptr_at(vec, index), vec->_type_size);
+	}
+
+	// Fill the hole with the last element
+	vec->count--;
+	if (index != vec->count) {
+		vec_stats_move(vec, vec->_type_size);
+		memcpy(ptr_at(vec, index), ptr_at(vec, vec->count), vec->_type_size);
+	}
+
+	vec_auto_shrink(vec);
+	return VECTOR_STATUS_OK;
 }
 
-void *vec_at_mut(const vector *vec, uint32_t index) {
+vector_status vec_retain(vector *vec,
+	bool (*pred)(const void *elem, void *ctx),
+	void *ctx) {
+	if (vec == NULL || pred == NULL) {
+		return VECTOR_STATUS_NULL;
+	}
+
+	vector_status status = vec_unshare(vec);
+	if (status != VECTOR_STATUS_OK) {
+		return status;
+	}
+
+	size_t kept = 0;
+	size_t i = 0;
+	while (i < vec->count) {
+		// Skip removed elements
+		while (i < vec->count && !pred(ptr_at(vec, i), ctx)) {
+			i++;
+		}
+
+		// Move a whole run of kept elements
+		size_t run_start = i;
+		while (i < vec->count && pred(ptr_at(vec, i), ctx)) {
+			i++;
+		}
+
+		size_t run_count = i - run_start;
+		if (run_count > 0 && run_start != kept) {
+			vec_stats_move(vec, vec->_type_size * run_count);
+			memmove(ptr_at(vec, kept), ptr_at(vec, run_start),
+				vec->_type_size * run_count);
+		}
+		kept += run_count;
+	}
+
+	vec->count = kept;
+	vec_auto_shrink(vec);
+	return VECTOR_STATUS_OK;
+}
+
+const void *vec_at(const vector *vec, size_t index) {
 	if (vec == NULL || index >= vec->count) {
 		return NULL;
 	}
@@ -197,16 +474,70 @@ void *vec_at_mut(const vector *vec, uint32_t index) {
 	return ptr_at(vec, index);
 }
 
+void *vec_at_mut(vector *vec, size_t index) {
+	if (vec == NULL || index >= vec->count) {
+		return NULL;
+	}
+
+	if (vec_unshare(vec) != VECTOR_STATUS_OK) {
+		return NULL;
+	}
+
+	return ptr_at(vec, index);
+}
+
 void *vec_collect(vector *vec) {
 	if (vec == NULL) {
 		return NULL;
 	}
 
-	void *retrieved = vec->data;
-
-	vec->data = NULL;
+	void *retrieved = vec_storage_take(vec);
 	vec->count = 0;
-	vec->_alloc_count = 0;
 
 	return retrieved;
 }
+
+/**
+ * @brief Compute grown capacity.
+ *
+ * @param[in] growth - Growth policy.
+ * @param[in] alloc_count - Current capacity.
+ * @param[in] min_count - Capacity needed.
+ * @param[in] max_count - Largest addressable capacity, at least min_count.
+ * @return New capacity, at least min_count.
+ */
+static size_t grow_count(const vector_growth *growth,
+	size_t alloc_count,
+	size_t min_count,
+	size_t max_count) {
+	size_t new_count = alloc_count;
+	while (new_count < min_count) {
+		size_t step = MIN_CAPACITY;
+		if (new_count != 0) {
+			// clang-format off
+			step = (growth->factor == VECTOR_GROWTH_HALF)
+				? new_count / 2 + 1
+				: new_count;
+			// clang-format on
+		}
+
+		// Capped steps are linear, so take all of them at once
+		if (growth->max_step != 0 && step > growth->max_step) {
+			size_t missing = min_count - new_count;
+			size_t steps = missing / growth->max_step
+				+ (missing % growth->max_step != 0);
+			step = (steps > (max_count - new_count) / growth->max_step)
+				? max_count - new_count
+				: steps * growth->max_step;
+		}
+
+		// Take exactly what is needed if growing further would overflow
+		if (step > max_count - new_count) {
+			return min_count;
+		}
+
+		new_count += step;
+	}
+
+	return new_count;
+}
@@ -1,9 +1,15 @@
 extern "C" {
 #include "../include/vector.h"
+#include "../src/config.h"
 }
 
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <fcntl.h>
 #include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
 
 static char element0 = '0';
 static char element1 = '1';
@@ -13,6 +19,43 @@ static int int_element0 = 123;
 static int int_element1 = 456;
 static int int_element2 = 789;
 
+struct counting_ctx {
+	int allocs;
+	int frees;
+	bool fail;
+};
+
+static void *counting_alloc(void *ctx, size_t size) {
+	counting_ctx *counter = (counting_ctx *)ctx;
+	if (counter->fail) {
+		return nullptr;
+	}
+
+	counter->allocs++;
+	return malloc(size);
+}
+
+static void *counting_resize(
+	void *ctx, void *ptr, size_t old_size, size_t new_size) {
+	(void)old_size;
+	counting_ctx *counter = (counting_ctx *)ctx;
+	if (counter->fail) {
+		return nullptr;
+	}
+
+	return realloc(ptr, new_size);
+}
+
+static void counting_release(void *ctx, void *ptr, size_t size) {
+	(void)size;
+	counting_ctx *counter = (counting_ctx *)ctx;
+	counter->frees++;
+	free(ptr);
+}
+
+VECTOR_DECLARE(intvec, int)
+VECTOR_DEFINE(intvec, int)
+
 TEST(Vector, VecInitOk) {
 	vector vec = vec_init(sizeof(char));
 
@@ -33,12 +76,10 @@ TEST(Vector, VecNewOk) {
 TEST(Vector, VecInitCloneOk) {
 	char orig_data[] = { element0, element1, element2 };
 
-	vector vec = {
-		.data = orig_data,
-		.count = 3,
-		._type_size = sizeof(char),
-		._alloc_count = 3,
-	};
+	vector vec = vec_init(sizeof(char));
+	vec.data = orig_data;
+	vec.count = 3;
+	vec._alloc_count = 3;
 
 	vector cloned_vec = vec_init_clone(&vec);
 
@@ -62,12 +103,10 @@ TEST(Vector, VecInitCloneOk) {
 TEST(Vector, VecNewCloneOk) {
 	char orig_data[] = { element0, element1, element2 };
 
-	vector vec = {
-		.data = orig_data,
-		.count = 3,
-		._type_size = sizeof(char),
-		._alloc_count = 3,
-	};
+	vector vec = vec_init(sizeof(char));
+	vec.data = orig_data;
+	vec.count = 3;
+	vec._alloc_count = 3;
 
 	vector *cloned_vec = vec_new_clone(&vec);
 
@@ -89,6 +128,627 @@ TEST(Vector, VecNewCloneOk) {
 	free(cloned_vec);
 }
 
+TEST(Vector, VecInitCloneCowOk) {
+	vector vec = vec_init(sizeof(char));
+	vec_push(&vec, &element0);
+	vec_push(&vec, &element1);
+
+	vector cloned_vec = vec_init_clone_cow(&vec);
+
+	// Storage is shared
+	EXPECT_EQ(cloned_vec.data, vec.data);
+	EXPECT_EQ(cloned_vec.count, vec.count);
+	EXPECT_NE(vec._refcount, nullptr);
+	EXPECT_EQ(cloned_vec._refcount, vec._refcount);
+	EXPECT_EQ(*vec._refcount, 2);
+	EXPECT_EQ(*(char *)vec_at(&cloned_vec, 1), element1);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(*(char *)vec_at(&cloned_vec, 0), element0);
+	EXPECT_EQ(vec_deinit(&cloned_vec), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecNewCloneCowOk) {
+	vector vec = vec_init(sizeof(char));
+	vec_push(&vec, &element0);
+
+	vector *cloned_vec = vec_new_clone_cow(&vec);
+	EXPECT_NE(cloned_vec, nullptr);
+	EXPECT_EQ(cloned_vec->data, vec.data);
+
+	EXPECT_EQ(vec_delete(cloned_vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(*vec._refcount, 1);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecCloneCowInline) {
+	char buffer[4];
+	vector vec = vec_init_inline(sizeof(char), buffer, 4);
+	vec_push(&vec, &element0);
+
+	// Inline storage is copied right away
+	vector cloned_vec = vec_init_clone_cow(&vec);
+	EXPECT_NE(cloned_vec.data, buffer);
+	EXPECT_EQ(cloned_vec._refcount, nullptr);
+	EXPECT_EQ(*(char *)vec_at(&cloned_vec, 0), element0);
+
+	EXPECT_EQ(vec_deinit(&cloned_vec), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecCloneCowWrite) {
+	vector vec = vec_init(sizeof(char));
+	vec_push(&vec, &element0);
+	vec_push(&vec, &element1);
+
+	vector push_vec = vec_init_clone_cow(&vec);
+	vector insert_vec = vec_init_clone_cow(&vec);
+	vector erase_vec = vec_init_clone_cow(&vec);
+	vector at_vec = vec_init_clone_cow(&vec);
+	EXPECT_EQ(*vec._refcount, 5);
+
+	// Every modification copies the storage first
+	EXPECT_EQ(vec_push(&push_vec, &element2), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_insert(&insert_vec, 0, &element2), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_erase(&erase_vec, 0, nullptr), VECTOR_STATUS_OK);
+	*(char *)vec_at_mut(&at_vec, 0) = element2;
+	EXPECT_EQ(*vec._refcount, 1);
+
+	EXPECT_NE(push_vec.data, vec.data);
+	EXPECT_EQ(push_vec._refcount, nullptr);
+	EXPECT_EQ(*(char *)vec_at(&push_vec, 2), element2);
+	EXPECT_EQ(*(char *)vec_at(&insert_vec, 0), element2);
+	EXPECT_EQ(*(char *)vec_at(&erase_vec, 0), element1);
+	EXPECT_EQ(*(char *)vec_at(&at_vec, 0), element2);
+
+	// Original is untouched
+	EXPECT_EQ(vec.count, 2);
+	EXPECT_EQ(*(char *)vec_at(&vec, 0), element0);
+	EXPECT_EQ(*(char *)vec_at(&vec, 1), element1);
+
+	// Last owner keeps the buffer
+	void *data = vec.data;
+	*(char *)vec_at_mut(&vec, 0) = element2;
+	EXPECT_EQ(vec.data, data);
+	EXPECT_EQ(vec._refcount, nullptr);
+
+	vec_deinit(&vec);
+	vec_deinit(&push_vec);
+	vec_deinit(&insert_vec);
+	vec_deinit(&erase_vec);
+	vec_deinit(&at_vec);
+}
+
+TEST(Vector, VecCloneCowCollect) {
+	vector vec = vec_init(sizeof(char));
+	vec_push(&vec, &element0);
+	vector cloned_vec = vec_init_clone_cow(&vec);
+
+	char *inner_data = (char *)vec_collect(&cloned_vec);
+	EXPECT_NE(inner_data, vec.data);
+	EXPECT_EQ(inner_data[0], element0);
+	free(inner_data);
+
+	EXPECT_EQ(*vec._refcount, 1);
+	EXPECT_EQ(*(char *)vec_at(&vec, 0), element0);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecInitInlineOk) {
+	char buffer[4];
+	vector vec = vec_init_inline(sizeof(char), buffer, 4);
+
+	EXPECT_EQ(vec.data, buffer);
+	EXPECT_EQ(vec.count, 0);
+	EXPECT_EQ(vec._alloc_count, 4);
+
+	// Fits in inline storage
+	EXPECT_EQ(vec_push(&vec, &element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_insert(&vec, 0, &element1), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.data, buffer);
+	EXPECT_EQ(buffer[0], element1);
+	EXPECT_EQ(buffer[1], element0);
+
+	char erased = 123;
+	EXPECT_EQ(vec_erase(&vec, 0, &erased), VECTOR_STATUS_OK);
+	EXPECT_EQ(erased, element1);
+	EXPECT_EQ(*(char *)vec_at(&vec, 0), element0);
+
+	// Deinit does not free inline storage
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecInlineSpill) {
+	int buffer[2];
+	vector vec = vec_init_inline(sizeof(int), buffer, 2);
+
+	EXPECT_EQ(vec_push(&vec, &int_element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &int_element1), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.data, buffer);
+
+	// Overflow moves elements to the heap
+	EXPECT_EQ(vec_push(&vec, &int_element2), VECTOR_STATUS_OK);
+	EXPECT_NE(vec.data, buffer);
+	EXPECT_GE(vec._alloc_count, 3);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element0);
+	EXPECT_EQ(*(int *)vec_at(&vec, 1), int_element1);
+	EXPECT_EQ(*(int *)vec_at(&vec, 2), int_element2);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecInlineCollect) {
+	char buffer[4];
+	vector vec = vec_init_inline(sizeof(char), buffer, 4);
+
+	vec_push(&vec, &element0);
+	vec_push(&vec, &element1);
+
+	// Data is copied out of inline storage
+	char *inner_data = (char *)vec_collect(&vec);
+	EXPECT_NE(inner_data, nullptr);
+	EXPECT_NE(inner_data, buffer);
+	EXPECT_EQ(inner_data[0], element0);
+	EXPECT_EQ(inner_data[1], element1);
+	free(inner_data);
+
+	// Inline storage is reused
+	EXPECT_EQ(vec.count, 0);
+	EXPECT_EQ(vec_push(&vec, &element2), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.data, buffer);
+	EXPECT_EQ(buffer[0], element2);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecInitAlignedOk) {
+	vector vec = vec_init_aligned(sizeof(char), 48, false);
+
+	// Rounded up to a power of two
+	EXPECT_EQ(vec._alignment, 64);
+	EXPECT_EQ(vec.data, nullptr);
+
+	vector small_vec = vec_init_aligned(sizeof(char), 1, false);
+	EXPECT_EQ(small_vec._alignment, sizeof(void *));
+}
+
+TEST(Vector, VecNewAlignedOk) {
+	vector *vec = vec_new_aligned(sizeof(int), 64, false);
+
+	EXPECT_NE(vec, nullptr);
+	EXPECT_EQ(vec->_alignment, 64);
+	EXPECT_EQ(vec_push(vec, &int_element0), VECTOR_STATUS_OK);
+	EXPECT_EQ((uintptr_t)vec->data % 64, 0);
+
+	EXPECT_EQ(vec_delete(vec), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecAlignedGrowth) {
+	vector vec = vec_init_aligned(sizeof(int), 128, false);
+
+	// Every growth keeps alignment
+	for (int i = 0; i < 1000; i++) {
+		EXPECT_EQ(vec_push(&vec, &i), VECTOR_STATUS_OK);
+		EXPECT_EQ((uintptr_t)vec.data % 128, 0);
+	}
+	EXPECT_EQ(vec_insert(&vec, 0, &int_element0), VECTOR_STATUS_OK);
+	EXPECT_EQ((uintptr_t)vec.data % 128, 0);
+
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element0);
+	EXPECT_EQ(*(int *)vec_at(&vec, 1000), 999);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecAlignedPadTail) {
+	vector vec = vec_init_aligned(sizeof(char), 64, true);
+
+	// Storage fills whole aligned blocks
+	EXPECT_EQ(vec_reserve(&vec, 10), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._alloc_count, 64);
+	EXPECT_EQ((uintptr_t)vec.data % 64, 0);
+
+	EXPECT_EQ(vec_reserve(&vec, 65), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._alloc_count, 128);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecAlignedClone) {
+	vector vec = vec_init_aligned(sizeof(int), 64, true);
+	vec_push(&vec, &int_element0);
+	vec_push(&vec, &int_element1);
+
+	vector clone = vec_init_clone(&vec);
+	EXPECT_EQ(clone._alignment, 64);
+	EXPECT_EQ((uintptr_t)clone.data % 64, 0);
+	EXPECT_EQ(clone._alloc_count, 16);
+	EXPECT_EQ(*(int *)vec_at(&clone, 1), int_element1);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_deinit(&clone), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecOpenFileNull) {
+	vector *vec = nullptr;
+
+	EXPECT_EQ(vec_open_file(vec, "unused", sizeof(int)), VECTOR_STATUS_NULL);
+}
+
+TEST(Vector, VecOpenFileIo) {
+	vector vec;
+
+	EXPECT_EQ(vec_open_file(&vec, "/nonexistent/vector", sizeof(int)),
+		VECTOR_STATUS_IO);
+}
+
+TEST(Vector, VecOpenFileBounds) {
+	std::string path = testing::TempDir() + "vector_file_bounds";
+	remove(path.c_str());
+
+	// Rejected before the file is created
+	vector vec;
+	EXPECT_EQ(vec_open_file(&vec, path.c_str(), 0), VECTOR_STATUS_BOUNDS);
+	EXPECT_NE(access(path.c_str(), F_OK), 0);
+}
+
+TEST(Vector, VecOpenFileOk) {
+	std::string path = testing::TempDir() + "vector_file_ok";
+	remove(path.c_str());
+
+	vector vec;
+	EXPECT_EQ(vec_open_file(&vec, path.c_str(), sizeof(int)), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.count, 0);
+
+	EXPECT_EQ(vec_push(&vec, &int_element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &int_element1), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_sync(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_insert(&vec, 0, &int_element2), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+
+	// Elements persist in the file
+	EXPECT_EQ(vec_open_file(&vec, path.c_str(), sizeof(int)), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.count, 3);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element2);
+	EXPECT_EQ(*(int *)vec_at(&vec, 1), int_element0);
+	EXPECT_EQ(*(int *)vec_at(&vec, 2), int_element1);
+
+	// Grow past the first page
+	for (int i = 0; i < 4096; i++) {
+		EXPECT_EQ(vec_push(&vec, &i), VECTOR_STATUS_OK);
+	}
+	EXPECT_EQ(vec.count, 4099);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element2);
+	EXPECT_EQ(*(int *)vec_at(&vec, 4098), 4095);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+
+	EXPECT_EQ(vec_open_file(&vec, path.c_str(), sizeof(int)), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.count, 4099);
+	EXPECT_EQ(*(int *)vec_at(&vec, 4098), 4095);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+
+	remove(path.c_str());
+}
+
+TEST(Vector, VecOpenFileFormat) {
+	std::string path = testing::TempDir() + "vector_file_format";
+	remove(path.c_str());
+
+	vector vec;
+	EXPECT_EQ(vec_open_file(&vec, path.c_str(), sizeof(int)), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+
+	// Mismatched type size
+	EXPECT_EQ(vec_open_file(&vec, path.c_str(), sizeof(char)),
+		VECTOR_STATUS_FORMAT);
+
+	// Not a vector file
+	FILE *file = fopen(path.c_str(), "w");
+	fputs("not a vector file, but long enough to hold a header..........",
+		file);
+	fclose(file);
+	EXPECT_EQ(vec_open_file(&vec, path.c_str(), sizeof(int)),
+		VECTOR_STATUS_FORMAT);
+
+	remove(path.c_str());
+}
+
+TEST(Vector, VecCollectFile) {
+	std::string path = testing::TempDir() + "vector_file_collect";
+	remove(path.c_str());
+
+	vector vec;
+	EXPECT_EQ(vec_open_file(&vec, path.c_str(), sizeof(int)), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &int_element0), VECTOR_STATUS_OK);
+
+	// Data is copied out of the file
+	int *inner_data = (int *)vec_collect(&vec);
+	EXPECT_NE(inner_data, nullptr);
+	EXPECT_EQ(inner_data[0], int_element0);
+	free(inner_data);
+
+	// File is still attached
+	EXPECT_EQ(vec.count, 0);
+	EXPECT_EQ(vec_push(&vec, &int_element1), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+
+	EXPECT_EQ(vec_open_file(&vec, path.c_str(), sizeof(int)), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.count, 1);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element1);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+
+	remove(path.c_str());
+}
+
+TEST(Vector, VecWriteFdNull) {
+	vector *vec = nullptr;
+
+	EXPECT_EQ(vec_write_fd(vec, 0), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_read_fd(vec, 0, sizeof(int)), VECTOR_STATUS_NULL);
+}
+
+TEST(Vector, VecWriteFdOk) {
+	std::string path = testing::TempDir() + "vector_write_fd_ok";
+
+	vector vec = vec_init(sizeof(int));
+	for (int i = 0; i < 1000; i++) {
+		EXPECT_EQ(vec_push(&vec, &i), VECTOR_STATUS_OK);
+	}
+
+	vector empty = vec_init(sizeof(int));
+	int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	EXPECT_EQ(vec_write_fd(&vec, fd), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_write_fd(&empty, fd), VECTOR_STATUS_OK);
+
+	// Vectors are read back in order
+	vector read_vec;
+	lseek(fd, 0, SEEK_SET);
+	EXPECT_EQ(vec_read_fd(&read_vec, fd, sizeof(int)), VECTOR_STATUS_OK);
+	EXPECT_EQ(read_vec.count, 1000);
+	for (int i = 0; i < 1000; i++) {
+		EXPECT_EQ(*(int *)vec_at(&read_vec, i), i);
+	}
+	EXPECT_EQ(vec_deinit(&read_vec), VECTOR_STATUS_OK);
+
+	EXPECT_EQ(vec_read_fd(&read_vec, fd, sizeof(int)), VECTOR_STATUS_OK);
+	EXPECT_EQ(read_vec.count, 0);
+	EXPECT_EQ(vec_deinit(&read_vec), VECTOR_STATUS_OK);
+
+	// End of file
+	EXPECT_EQ(vec_read_fd(&read_vec, fd, sizeof(int)), VECTOR_STATUS_FORMAT);
+
+	close(fd);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_deinit(&empty), VECTOR_STATUS_OK);
+	remove(path.c_str());
+}
+
+TEST(Vector, VecReadFdFormat) {
+	std::string path = testing::TempDir() + "vector_read_fd_format";
+
+	vector vec = vec_init(sizeof(int));
+	for (int i = 0; i < 100; i++) {
+		EXPECT_EQ(vec_push(&vec, &i), VECTOR_STATUS_OK);
+	}
+
+	int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	EXPECT_EQ(vec_write_fd(&vec, fd), VECTOR_STATUS_OK);
+
+	// Mismatched type size
+	vector read_vec;
+	lseek(fd, 0, SEEK_SET);
+	EXPECT_EQ(vec_read_fd(&read_vec, fd, sizeof(char)), VECTOR_STATUS_FORMAT);
+
+	// Corrupted element
+	int corrupt = -1;
+	EXPECT_EQ(pwrite(fd, &corrupt, sizeof(int), 64 + 50 * sizeof(int)),
+		(ssize_t)sizeof(int));
+	lseek(fd, 0, SEEK_SET);
+	EXPECT_EQ(vec_read_fd(&read_vec, fd, sizeof(int)), VECTOR_STATUS_FORMAT);
+	EXPECT_EQ(vec_map_readonly(&read_vec, path.c_str(), sizeof(int), true),
+		VECTOR_STATUS_FORMAT);
+
+	// Count far beyond the file, rejected before allocating
+	uint64_t huge_count = (uint64_t)1 << 40;
+	EXPECT_EQ(pwrite(fd, &huge_count, sizeof(huge_count), 24),
+		(ssize_t)sizeof(huge_count));
+	lseek(fd, 0, SEEK_SET);
+	EXPECT_EQ(vec_read_fd(&read_vec, fd, sizeof(int)), VECTOR_STATUS_FORMAT);
+	EXPECT_EQ(pwrite(fd, &vec.count, sizeof(uint64_t), 24),
+		(ssize_t)sizeof(uint64_t));
+
+	// Truncated file
+	EXPECT_EQ(ftruncate(fd, 64 + 10 * sizeof(int)), 0);
+	lseek(fd, 0, SEEK_SET);
+	EXPECT_EQ(vec_read_fd(&read_vec, fd, sizeof(int)), VECTOR_STATUS_FORMAT);
+	EXPECT_EQ(vec_map_readonly(&read_vec, path.c_str(), sizeof(int), false),
+		VECTOR_STATUS_FORMAT);
+
+	close(fd);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+	remove(path.c_str());
+}
+
+TEST(Vector, VecMapReadonlyNull) {
+	vector *vec = nullptr;
+
+	EXPECT_EQ(vec_map_readonly(vec, "unused", sizeof(int), false),
+		VECTOR_STATUS_NULL);
+}
+
+TEST(Vector, VecMapReadonlyOk) {
+	std::string path = testing::TempDir() + "vector_map_readonly_ok";
+
+	vector vec = vec_init(sizeof(int));
+	for (int i = 0; i < 1000; i++) {
+		EXPECT_EQ(vec_push(&vec, &i), VECTOR_STATUS_OK);
+	}
+
+	int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	EXPECT_EQ(vec_write_fd(&vec, fd), VECTOR_STATUS_OK);
+	close(fd);
+
+	vector mapped;
+	EXPECT_EQ(vec_map_readonly(&mapped, path.c_str(), sizeof(int), true),
+		VECTOR_STATUS_OK);
+	EXPECT_EQ(mapped.count, 1000);
+	EXPECT_EQ(*(int *)vec_at(&mapped, 999), 999);
+
+	// First write copies to the heap
+	const void *mapped_data = mapped.data;
+	int *first = (int *)vec_at_mut(&mapped, 0);
+	EXPECT_NE(first, nullptr);
+	EXPECT_NE(mapped.data, mapped_data);
+	*first = int_element0;
+	EXPECT_EQ(vec_push(&mapped, &int_element1), VECTOR_STATUS_OK);
+	EXPECT_EQ(mapped.count, 1001);
+	EXPECT_EQ(*(int *)vec_at(&mapped, 0), int_element0);
+	EXPECT_EQ(*(int *)vec_at(&mapped, 999), 999);
+	EXPECT_EQ(*(int *)vec_at(&mapped, 1000), int_element1);
+	EXPECT_EQ(vec_deinit(&mapped), VECTOR_STATUS_OK);
+
+	EXPECT_EQ(vec_map_readonly(&mapped, path.c_str(), sizeof(int), true),
+		VECTOR_STATUS_OK);
+	EXPECT_EQ(mapped.count, 1000);
+	EXPECT_EQ(*(int *)vec_at(&mapped, 0), 0);
+
+	// Collected data is a copy
+	int *inner_data = (int *)vec_collect(&mapped);
+	EXPECT_NE(inner_data, nullptr);
+	EXPECT_EQ(inner_data[999], 999);
+	free(inner_data);
+	EXPECT_EQ(vec_deinit(&mapped), VECTOR_STATUS_OK);
+
+	// Shared mapping is copied by removals too
+	EXPECT_EQ(vec_map_readonly(&mapped, path.c_str(), sizeof(int), false),
+		VECTOR_STATUS_OK);
+	vector clone = vec_init_clone_cow(&mapped);
+	EXPECT_EQ(vec_erase(&mapped, 0, nullptr), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_deinit(&clone), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_swap_remove(&mapped, 0, nullptr), VECTOR_STATUS_OK);
+	EXPECT_EQ(mapped.count, 998);
+	EXPECT_EQ(*(int *)vec_at(&mapped, 0), 999);
+	EXPECT_EQ(vec_deinit(&mapped), VECTOR_STATUS_OK);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+	remove(path.c_str());
+}
+
+TEST(Vector, VecOpenFileWritten) {
+	std::string path = testing::TempDir() + "vector_file_written";
+
+	vector vec = vec_init(sizeof(int));
+	EXPECT_EQ(vec_push(&vec, &int_element0), VECTOR_STATUS_OK);
+	int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	EXPECT_EQ(vec_write_fd(&vec, fd), VECTOR_STATUS_OK);
+	close(fd);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+
+	// Modified in place, checksum must not reject it afterwards
+	EXPECT_EQ(vec_open_file(&vec, path.c_str(), sizeof(int)), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &int_element1), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+
+	fd = open(path.c_str(), O_RDONLY);
+	EXPECT_EQ(vec_read_fd(&vec, fd, sizeof(int)), VECTOR_STATUS_OK);
+	close(fd);
+	EXPECT_EQ(vec.count, 2);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element0);
+	EXPECT_EQ(*(int *)vec_at(&vec, 1), int_element1);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+
+	EXPECT_EQ(vec_map_readonly(&vec, path.c_str(), sizeof(int), true),
+		VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.count, 2);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+
+	remove(path.c_str());
+}
+
+TEST(Vector, VecMapReadonlyFile) {
+	std::string path = testing::TempDir() + "vector_map_readonly_file";
+	remove(path.c_str());
+
+	vector vec;
+	EXPECT_EQ(vec_open_file(&vec, path.c_str(), sizeof(int)), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &int_element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &int_element1), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+
+	// Files without a checksum are accepted
+	EXPECT_EQ(vec_map_readonly(&vec, path.c_str(), sizeof(int), true),
+		VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.count, 2);
+	EXPECT_EQ(*(int *)vec_at(&vec, 1), int_element1);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+
+	remove(path.c_str());
+}
+
+TEST(Vector, VecWriterNull) {
+	vector_writer *writer = nullptr;
+
+	EXPECT_EQ(vec_writer_open(writer, 0, sizeof(int)), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_writer_write(writer, &int_element0, 1), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_writer_finish(writer), VECTOR_STATUS_NULL);
+}
+
+TEST(Vector, VecWriterBounds) {
+	std::string path = testing::TempDir() + "vector_writer_bounds";
+
+	// Nothing is written for a zero type size
+	int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	vector_writer writer;
+	EXPECT_EQ(vec_writer_open(&writer, fd, 0), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(lseek(fd, 0, SEEK_END), 0);
+	close(fd);
+
+	remove(path.c_str());
+}
+
+TEST(Vector, VecWriterOk) {
+	std::string path = testing::TempDir() + "vector_writer_ok";
+
+	vector vec = vec_init(sizeof(int));
+	for (int i = 0; i < 1000; i++) {
+		EXPECT_EQ(vec_push(&vec, &i), VECTOR_STATUS_OK);
+	}
+
+	// Uneven chunks give the same file as a single write
+	int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	vector_writer writer;
+	EXPECT_EQ(vec_writer_open(&writer, fd, sizeof(int)), VECTOR_STATUS_OK);
+	for (size_t i = 0; i < 1000; i += 7) {
+		size_t count = (1000 - i < 7) ? 1000 - i : 7;
+		EXPECT_EQ(vec_writer_write(&writer, vec_at(&vec, i), count),
+			VECTOR_STATUS_OK);
+	}
+	EXPECT_EQ(vec_writer_finish(&writer), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_write_fd(&vec, fd), VECTOR_STATUS_OK);
+
+	char chunked[64];
+	char single[64];
+	EXPECT_EQ(pread(fd, chunked, 64, 0), 64);
+	EXPECT_EQ(pread(fd, single, 64, 64 + 1000 * sizeof(int)), 64);
+	EXPECT_EQ(memcmp(chunked, single, 64), 0);
+	close(fd);
+
+	vector mapped;
+	EXPECT_EQ(vec_map_readonly(&mapped, path.c_str(), sizeof(int), true),
+		VECTOR_STATUS_OK);
+	EXPECT_EQ(mapped.count, 1000);
+	EXPECT_EQ(*(int *)vec_at(&mapped, 500), 500);
+	EXPECT_EQ(vec_deinit(&mapped), VECTOR_STATUS_OK);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+	remove(path.c_str());
+}
+
+TEST(Vector, VecSyncNull) {
+	vector *vec = nullptr;
+
+	EXPECT_EQ(vec_sync(vec), VECTOR_STATUS_NULL);
+}
+
 TEST(Vector, VecDeinitNullArg) {
 	vector *vec = nullptr;
 
@@ -96,23 +756,16 @@ TEST(Vector, VecDeinitNullArg) {
 }
 
 TEST(Vector, VecDeinitNullData) {
-	vector vec = {
-		.data = nullptr,
-		.count = 0,
-		._type_size = 1,
-		._alloc_count = 0,
-	};
+	vector vec = vec_init(1);
 
 	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
 }
 
 TEST(Vector, VecDeinitOk) {
-	vector vec = {
-		.data = malloc(8),
-		.count = 0,
-		._type_size = 1,
-		._alloc_count = 8,
-	};
+	vector vec = vec_init(1);
+	vec.data = malloc(8);
+	vec.count = 0;
+	vec._alloc_count = 8;
 
 	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
 }
@@ -125,14 +778,16 @@ TEST(Vector, VecDeleteNullArg) {
 
 TEST(Vector, VecDeleteNullData) {
 	vector *vec = (vector *)malloc(sizeof(vector));
-	vec->data = nullptr;
+	*vec = vec_init(sizeof(char));
 
 	EXPECT_EQ(vec_delete(vec), VECTOR_STATUS_OK);
 }
 
 TEST(Vector, VecDeleteOk) {
 	vector *vec = (vector *)malloc(sizeof(vector));
+	*vec = vec_init(sizeof(char));
 	vec->data = malloc(8);
+	vec->_alloc_count = 8;
 
 	EXPECT_EQ(vec_delete(vec), VECTOR_STATUS_OK);
 }
@@ -144,12 +799,7 @@ TEST(Vector, VecReserveNull) {
 }
 
 TEST(Vector, VecReserveEmpty) {
-	vector vec = {
-		.data = nullptr,
-		.count = 0,
-		._type_size = 1,
-		._alloc_count = 0,
-	};
+	vector vec = vec_init(1);
 
 	EXPECT_EQ(vec_reserve(&vec, 6), VECTOR_STATUS_OK);
 	EXPECT_NE(vec.data, nullptr);
@@ -159,12 +809,10 @@ TEST(Vector, VecReserveEmpty) {
 }
 
 TEST(Vector, VecReserveOk) {
-	vector vec = {
-		.data = malloc(8),
-		.count = 0,
-		._type_size = 1,
-		._alloc_count = 8,
-	};
+	vector vec = vec_init(1);
+	vec.data = malloc(8);
+	vec.count = 0;
+	vec._alloc_count = 8;
 
 	// Less than allocated
 	EXPECT_EQ(vec_reserve(&vec, 6), VECTOR_STATUS_OK);
@@ -181,6 +829,302 @@ TEST(Vector, VecReserveOk) {
 	free(vec.data);
 }
 
+TEST(Vector, VecReserveOverflow) {
+	vector vec = vec_init(sizeof(int));
+
+	EXPECT_EQ(vec_reserve(&vec, SIZE_MAX / 2), VECTOR_STATUS_OVERFLOW);
+	EXPECT_EQ(vec.data, nullptr);
+	EXPECT_EQ(vec._alloc_count, 0);
+}
+
+TEST(Vector, VecGrowNull) {
+	vector *vec = nullptr;
+
+	EXPECT_EQ(vec_grow(vec, 1), VECTOR_STATUS_NULL);
+}
+
+TEST(Vector, VecGrowOk) {
+	vector vec = vec_init(1);
+
+	EXPECT_EQ(vec_grow(&vec, 1), VECTOR_STATUS_OK);
+	EXPECT_NE(vec.data, nullptr);
+	EXPECT_EQ(vec._alloc_count, 2);
+
+	// Already fits
+	vec.count = 1;
+	EXPECT_EQ(vec_grow(&vec, 1), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._alloc_count, 2);
+
+	// Multiple growth steps
+	EXPECT_EQ(vec_grow(&vec, 6), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._alloc_count, 8);
+
+	free(vec.data);
+}
+
+TEST(Vector, VecGrowOverflow) {
+	vector vec = vec_init(sizeof(int));
+	vec.data = nullptr;
+	vec.count = 8;
+	vec._alloc_count = 8;
+
+	EXPECT_EQ(vec_grow(&vec, SIZE_MAX - 4), VECTOR_STATUS_OVERFLOW);
+	EXPECT_EQ(vec_grow(&vec, SIZE_MAX / sizeof(int)), VECTOR_STATUS_OVERFLOW);
+	EXPECT_EQ(vec._alloc_count, 8);
+}
+
+TEST(Vector, VecReserveMmap) {
+	vector vec = vec_init(sizeof(int));
+	size_t large_count = MMAP_THRESHOLD / sizeof(int);
+
+	EXPECT_EQ(vec_push(&vec, &int_element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &int_element1), VECTOR_STATUS_OK);
+
+	// Large storage is page aligned
+	EXPECT_EQ(vec_reserve(&vec, large_count), VECTOR_STATUS_OK);
+	EXPECT_GE(vec._alloc_count, large_count);
+	EXPECT_EQ((uintptr_t)vec.data % 4096, 0);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element0);
+	EXPECT_EQ(*(int *)vec_at(&vec, 1), int_element1);
+
+	// Grow mapped storage
+	EXPECT_EQ(vec_reserve(&vec, large_count * 2), VECTOR_STATUS_OK);
+	EXPECT_GE(vec._alloc_count, large_count * 2);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element0);
+	EXPECT_EQ(*(int *)vec_at(&vec, 1), int_element1);
+
+	vec.count = vec._alloc_count;
+	EXPECT_EQ(vec_push(&vec, &int_element2), VECTOR_STATUS_OK);
+	EXPECT_EQ(*(int *)vec_at(&vec, vec.count - 1), int_element2);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecCollectMmap) {
+	vector vec = vec_init(sizeof(int));
+	size_t large_count = MMAP_THRESHOLD / sizeof(int);
+
+	EXPECT_EQ(vec_reserve(&vec, large_count), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &int_element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &int_element1), VECTOR_STATUS_OK);
+
+	// Mapped data is copied into freeable memory
+	int *inner_data = (int *)vec_collect(&vec);
+	EXPECT_NE(inner_data, nullptr);
+	EXPECT_EQ(inner_data[0], int_element0);
+	EXPECT_EQ(inner_data[1], int_element1);
+	free(inner_data);
+
+	EXPECT_EQ(vec.data, nullptr);
+	EXPECT_EQ(vec.count, 0);
+	EXPECT_EQ(vec._alloc_count, 0);
+
+	// Usable after collect
+	EXPECT_EQ(vec_push(&vec, &int_element2), VECTOR_STATUS_OK);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element2);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecSetGrowthNull) {
+	vector_growth growth = {
+		.factor = VECTOR_GROWTH_HALF,
+		.max_step = 0,
+		.usable_size = false,
+		.auto_shrink = false,
+	};
+
+	EXPECT_EQ(vec_set_growth(nullptr, &growth), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_shrink_to_fit(nullptr), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_auto_shrink(nullptr), VECTOR_STATUS_NULL);
+}
+
+TEST(Vector, VecGrowZeroSize) {
+	vector vec = vec_init(0);
+
+	EXPECT_EQ(vec_grow(&vec, 1), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec_reserve(&vec, 8), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec_push(&vec, &element0), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec.data, nullptr);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+
+TEST(Vector, VecGrowPolicy) {
+	vector_growth growth = {
+		.factor = VECTOR_GROWTH_HALF,
+		.max_step = 0,
+		.usable_size = false,
+		.auto_shrink = false,
+	};
+	vector vec = vec_init(sizeof(int));
+	EXPECT_EQ(vec_set_growth(&vec, &growth), VECTOR_STATUS_OK);
+
+	// Grow by half
+	size_t expected[] = { 2, 4, 7, 11, 17 };
+	for (size_t capacity : expected) {
+		vec.count = vec._alloc_count;
+		EXPECT_EQ(vec_grow(&vec, 1), VECTOR_STATUS_OK);
+		EXPECT_EQ(vec._alloc_count, capacity);
+	}
+
+	// Linear once steps are capped
+	growth.factor = VECTOR_GROWTH_DOUBLE;
+	growth.max_step = 10;
+	vec.count = vec._alloc_count;
+	EXPECT_EQ(vec_grow(&vec, 1), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._alloc_count, 27);
+	EXPECT_EQ(vec_grow(&vec, 25), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._alloc_count, 47);
+
+	// Clones keep the policy
+	vector cloned_vec = vec_init_clone(&vec);
+	EXPECT_EQ(cloned_vec._growth, &growth);
+
+	vec.count = 0;
+	EXPECT_EQ(vec_set_growth(&vec, nullptr), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_grow(&vec, 100), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._alloc_count, 188);
+
+	vec_deinit(&vec);
+	vec_deinit(&cloned_vec);
+}
+
+TEST(Vector, VecGrowUsableSize) {
+	vector_growth growth = {
+		.factor = VECTOR_GROWTH_DOUBLE,
+		.max_step = 0,
+		.usable_size = true,
+		.auto_shrink = false,
+	};
+	vector vec = vec_init(sizeof(char));
+	vec_set_growth(&vec, &growth);
+
+	EXPECT_EQ(vec_push(&vec, &element0), VECTOR_STATUS_OK);
+	EXPECT_GE(vec._alloc_count, 2);
+
+	// Slack is writable capacity
+	size_t capacity = vec._alloc_count;
+	while (vec.count < capacity) {
+		EXPECT_EQ(vec_push(&vec, &element1), VECTOR_STATUS_OK);
+	}
+	EXPECT_EQ(vec._alloc_count, capacity);
+	EXPECT_EQ(*(char *)vec_at(&vec, capacity - 1), element1);
+
+	vec_deinit(&vec);
+}
+
+TEST(Vector, VecShrinkToFitOk) {
+	vector vec = vec_init(sizeof(int));
+	for (int i = 0; i < 100; i++) {
+		vec_push(&vec, &i);
+	}
+
+	vec.count = 10;
+	EXPECT_EQ(vec_shrink_to_fit(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._alloc_count, 10);
+	EXPECT_EQ(*(int *)vec_at(&vec, 9), 9);
+
+	// Shared storage is kept
+	vector cloned_vec = vec_init_clone_cow(&vec);
+	cloned_vec.count = 5;
+	EXPECT_EQ(vec_shrink_to_fit(&cloned_vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(cloned_vec._alloc_count, 10);
+	EXPECT_EQ(cloned_vec.data, vec.data);
+	vec_deinit(&cloned_vec);
+
+	vec.count = 0;
+	EXPECT_EQ(vec_shrink_to_fit(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.data, nullptr);
+	EXPECT_EQ(vec._alloc_count, 0);
+
+	// Usable after shrinking to nothing
+	EXPECT_EQ(vec_push(&vec, &int_element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element0);
+
+	vec_deinit(&vec);
+}
+
+TEST(Vector, VecShrinkToFitInline) {
+	int buffer[8];
+	vector vec = vec_init_inline(sizeof(int), buffer, 8);
+	vec_push(&vec, &int_element0);
+
+	EXPECT_EQ(vec_shrink_to_fit(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.data, buffer);
+	EXPECT_EQ(vec._alloc_count, 8);
+
+	vec_deinit(&vec);
+}
+
+TEST(Vector, VecShrinkToFitMmap) {
+	vector vec = vec_init(sizeof(int));
+	size_t large_count = MMAP_THRESHOLD / sizeof(int);
+
+	EXPECT_EQ(vec_reserve(&vec, large_count * 2), VECTOR_STATUS_OK);
+	vec.count = large_count + 1;
+	((int *)vec.data)[large_count] = int_element0;
+
+	// Mapping shrinks to whole pages
+	EXPECT_EQ(vec_shrink_to_fit(&vec), VECTOR_STATUS_OK);
+	EXPECT_GE(vec._alloc_count, large_count + 1);
+	EXPECT_LT(vec._alloc_count, large_count * 2);
+	EXPECT_EQ(*(int *)vec_at(&vec, large_count), int_element0);
+
+	// Small storage moves back to the heap
+	vec.count = 2;
+	((int *)vec.data)[1] = int_element1;
+	EXPECT_EQ(vec_shrink_to_fit(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._alloc_count, 2);
+	EXPECT_EQ(*(int *)vec_at(&vec, 1), int_element1);
+
+	int *inner_data = (int *)vec_collect(&vec);
+	free(inner_data);
+	vec_deinit(&vec);
+}
+
+TEST(Vector, VecAutoShrinkOk) {
+	vector_growth growth = {
+		.factor = VECTOR_GROWTH_DOUBLE,
+		.max_step = 0,
+		.usable_size = false,
+		.auto_shrink = true,
+	};
+	vector vec = vec_init(sizeof(int));
+	for (int i = 0; i < 1024; i++) {
+		vec_push(&vec, &i);
+	}
+
+	// Default policy never shrinks
+	for (int i = 0; i < 1000; i++) {
+		vec_erase(&vec, vec.count - 1, nullptr);
+	}
+	EXPECT_EQ(vec._alloc_count, 1024);
+
+	for (int i = 24; i < 1024; i++) {
+		vec_push(&vec, &i);
+	}
+	vec_set_growth(&vec, &growth);
+
+	// Shrinks to twice the count below a quarter
+	for (int i = 0; i < 769; i++) {
+		vec_erase(&vec, vec.count - 1, nullptr);
+	}
+	EXPECT_EQ(vec._alloc_count, 510);
+	EXPECT_EQ(*(int *)vec_at(&vec, 254), 254);
+
+	EXPECT_EQ(vec_swap_remove(&vec, 0, nullptr), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._alloc_count, 510);
+
+	// Small storage is kept
+	vec.count = 1;
+	EXPECT_EQ(vec_auto_shrink(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._alloc_count, 2);
+	EXPECT_EQ(vec_auto_shrink(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._alloc_count, 2);
+
+	vec_deinit(&vec);
+}
+
 TEST(Vector, VecPushNull) {
 	vector *vec = nullptr;
 
@@ -188,12 +1132,7 @@ TEST(Vector, VecPushNull) {
 }
 
 TEST(Vector, VecPushOk) {
-	vector vec = {
-		.data = nullptr,
-		.count = 0,
-		._type_size = sizeof(char),
-		._alloc_count = 0,
-	};
+	vector vec = vec_init(sizeof(char));
 
 	EXPECT_EQ(vec_push(&vec, &element0), VECTOR_STATUS_OK);
 	EXPECT_NE(vec.data, nullptr);
@@ -222,12 +1161,7 @@ TEST(Vector, VecInsertNull) {
 }
 
 TEST(Vector, VecInsertBounds) {
-	vector vec = {
-		.data = nullptr,
-		.count = 0,
-		._type_size = sizeof(char),
-		._alloc_count = 0,
-	};
+	vector vec = vec_init(sizeof(char));
 
 	EXPECT_EQ(vec_insert(&vec, 1, &element0), VECTOR_STATUS_BOUNDS);
 	EXPECT_EQ(vec.data, nullptr);
@@ -235,12 +1169,7 @@ TEST(Vector, VecInsertBounds) {
 }
 
 TEST(Vector, VecInsertOk) {
-	vector vec = {
-		.data = nullptr,
-		.count = 0,
-		._type_size = sizeof(char),
-		._alloc_count = 0,
-	};
+	vector vec = vec_init(sizeof(char));
 
 	EXPECT_EQ(vec_insert(&vec, 0, &element0), VECTOR_STATUS_OK);
 	EXPECT_NE(vec.data, nullptr);
@@ -273,12 +1202,7 @@ TEST(Vector, VecInsertOk) {
 }
 
 TEST(Vector, VecInsertOkMultibyte) {
-	vector vec = {
-		.data = nullptr,
-		.count = 0,
-		._type_size = sizeof(int),
-		._alloc_count = 0,
-	};
+	vector vec = vec_init(sizeof(int));
 
 	EXPECT_EQ(vec_insert(&vec, 0, &int_element0), VECTOR_STATUS_OK);
 	EXPECT_NE(vec.data, nullptr);
@@ -317,12 +1241,10 @@ TEST(Vector, VecEraseNull) {
 }
 
 TEST(Vector, VecEraseBounds) {
-	vector vec = {
-		.data = malloc(sizeof(char) * 2),
-		.count = 2,
-		._type_size = sizeof(char),
-		._alloc_count = 2,
-	};
+	vector vec = vec_init(sizeof(char));
+	vec.data = malloc(sizeof(char) * 2);
+	vec.count = 2;
+	vec._alloc_count = 2;
 
 	*((char *)vec.data) = element0;
 	*((char *)vec.data + 1) = element1;
@@ -340,12 +1262,10 @@ TEST(Vector, VecEraseBounds) {
 }
 
 TEST(Vector, VecEraseOk) {
-	vector vec = {
-		.data = malloc(sizeof(char) * 3),
-		.count = 3,
-		._type_size = sizeof(char),
-		._alloc_count = 3,
-	};
+	vector vec = vec_init(sizeof(char));
+	vec.data = malloc(sizeof(char) * 3);
+	vec.count = 3;
+	vec._alloc_count = 3;
 
 	*((char *)vec.data) = element0;
 	*((char *)vec.data + 1) = element1;
@@ -370,6 +1290,94 @@ TEST(Vector, VecEraseOk) {
 	free(vec.data);
 }
 
+TEST(Vector, VecSwapRemoveNull) {
+	vector *vec = nullptr;
+
+	EXPECT_EQ(vec_swap_remove(vec, 0, nullptr), VECTOR_STATUS_NULL);
+}
+
+TEST(Vector, VecSwapRemoveBounds) {
+	vector vec = vec_init(sizeof(char));
+	vec_push(&vec, &element0);
+
+	EXPECT_EQ(vec_swap_remove(&vec, 1, nullptr), VECTOR_STATUS_BOUNDS);
+	EXPECT_EQ(vec.count, 1);
+
+	vec_deinit(&vec);
+}
+
+TEST(Vector, VecSwapRemoveOk) {
+	vector vec = vec_init(sizeof(int));
+	vec_push(&vec, &int_element0);
+	vec_push(&vec, &int_element1);
+	vec_push(&vec, &int_element2);
+
+	// Last element fills the hole
+	int buffer = 0;
+	EXPECT_EQ(vec_swap_remove(&vec, 0, &buffer), VECTOR_STATUS_OK);
+	EXPECT_EQ(buffer, int_element0);
+	EXPECT_EQ(vec.count, 2);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element2);
+	EXPECT_EQ(*(int *)vec_at(&vec, 1), int_element1);
+
+	// Removing the last element
+	EXPECT_EQ(vec_swap_remove(&vec, 1, &buffer), VECTOR_STATUS_OK);
+	EXPECT_EQ(buffer, int_element1);
+	EXPECT_EQ(vec.count, 1);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element2);
+
+	vec_deinit(&vec);
+}
+
+static bool keep_below(const void *elem, void *ctx) {
+	return *(const int *)elem < *(int *)ctx;
+}
+
+TEST(Vector, VecRetainNull) {
+	vector vec = vec_init(sizeof(int));
+
+	EXPECT_EQ(vec_retain(nullptr, keep_below, nullptr), VECTOR_STATUS_NULL);
+	EXPECT_EQ(vec_retain(&vec, nullptr, nullptr), VECTOR_STATUS_NULL);
+}
+
+TEST(Vector, VecRetainOk) {
+	vector vec = vec_init(sizeof(int));
+	int values[] = { 1, 9, 9, 2, 3, 9, 4, 9 };
+	for (int value : values) {
+		vec_push(&vec, &value);
+	}
+
+	int limit = 5;
+	EXPECT_EQ(vec_retain(&vec, keep_below, &limit), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.count, 4);
+	for (int i = 0; i < 4; i++) {
+		EXPECT_EQ(*(int *)vec_at(&vec, i), i + 1);
+	}
+
+	// Nothing kept
+	limit = 0;
+	EXPECT_EQ(vec_retain(&vec, keep_below, &limit), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.count, 0);
+
+	vec_deinit(&vec);
+}
+
+TEST(Vector, VecRetainShared) {
+	vector vec = vec_init(sizeof(int));
+	vec_push(&vec, &int_element0);
+	vec_push(&vec, &int_element1);
+	vector cloned_vec = vec_init_clone_cow(&vec);
+
+	int limit = 200;
+	EXPECT_EQ(vec_retain(&cloned_vec, keep_below, &limit), VECTOR_STATUS_OK);
+	EXPECT_EQ(cloned_vec.count, 1);
+	EXPECT_EQ(vec.count, 2);
+	EXPECT_EQ(*(int *)vec_at(&vec, 1), int_element1);
+
+	vec_deinit(&vec);
+	vec_deinit(&cloned_vec);
+}
+
 TEST(Vector, VecAtNull) {
 	vector *vec = nullptr;
 
@@ -377,12 +1385,10 @@ TEST(Vector, VecAtNull) {
 }
 
 TEST(Vector, VecAtBounds) {
-	vector vec = {
-		.data = malloc(sizeof(char) * 2),
-		.count = 2,
-		._type_size = sizeof(char),
-		._alloc_count = 2,
-	};
+	vector vec = vec_init(sizeof(char));
+	vec.data = malloc(sizeof(char) * 2);
+	vec.count = 2;
+	vec._alloc_count = 2;
 
 	EXPECT_EQ(vec_at(&vec, 3), nullptr);
 	EXPECT_EQ(vec_at(&vec, 2), nullptr);
@@ -391,12 +1397,10 @@ TEST(Vector, VecAtBounds) {
 }
 
 TEST(Vector, VecAtOk) {
-	vector vec = {
-		.data = malloc(sizeof(char) * 2),
-		.count = 2,
-		._type_size = sizeof(char),
-		._alloc_count = 2,
-	};
+	vector vec = vec_init(sizeof(char));
+	vec.data = malloc(sizeof(char) * 2);
+	vec.count = 2;
+	vec._alloc_count = 2;
 
 	*((char *)vec.data) = element0;
 	*((char *)vec.data + 1) = element1;
@@ -407,6 +1411,51 @@ TEST(Vector, VecAtOk) {
 	free(vec.data);
 }
 
+TEST(Vector, VecAtUncheckedOk) {
+	vector vec = vec_init(sizeof(int));
+	vec_push(&vec, &int_element0);
+	vec_push(&vec, &int_element1);
+
+	EXPECT_EQ(vec_at_unchecked(&vec, 0), vec_at(&vec, 0));
+	EXPECT_EQ(*(const int *)vec_at_unchecked(&vec, 1), int_element1);
+
+	vec_deinit(&vec);
+}
+
+TEST(Vector, VecPushFastOk) {
+	EXPECT_EQ(vec_push_fast(nullptr, &element0), VECTOR_STATUS_NULL);
+
+	// Specialized and generic element sizes, through growth
+	vector vec = vec_init(sizeof(int));
+	vector wide_vec = vec_init(sizeof(uint64_t));
+	vector char_vec = vec_init(sizeof(char));
+	for (int i = 0; i < 100; i++) {
+		uint64_t wide = (uint64_t)i << 40;
+		char c = (char)i;
+		EXPECT_EQ(vec_push_fast(&vec, &i), VECTOR_STATUS_OK);
+		EXPECT_EQ(vec_push_fast(&wide_vec, &wide), VECTOR_STATUS_OK);
+		EXPECT_EQ(vec_push_fast(&char_vec, &c), VECTOR_STATUS_OK);
+	}
+
+	for (int i = 0; i < 100; i++) {
+		EXPECT_EQ(*(const int *)vec_at(&vec, i), i);
+		EXPECT_EQ(*(const uint64_t *)vec_at(&wide_vec, i), (uint64_t)i << 40);
+		EXPECT_EQ(*(const char *)vec_at(&char_vec, i), (char)i);
+	}
+
+	// Shared storage goes through vec_push
+	vector cloned_vec = vec_init_clone_cow(&vec);
+	EXPECT_EQ(vec_push_fast(&cloned_vec, &int_element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.count, 100);
+	EXPECT_EQ(cloned_vec.count, 101);
+	EXPECT_NE(cloned_vec.data, vec.data);
+
+	vec_deinit(&vec);
+	vec_deinit(&wide_vec);
+	vec_deinit(&char_vec);
+	vec_deinit(&cloned_vec);
+}
+
 TEST(Vector, VecCollectNull) {
 	vector *vec = nullptr;
 
@@ -416,12 +1465,10 @@ TEST(Vector, VecCollectNull) {
 TEST(Vector, VecCollectOk) {
 	void *memory = malloc(8);
 
-	vector vec = {
-		.data = memory,
-		.count = 0,
-		._type_size = 1,
-		._alloc_count = 8,
-	};
+	vector vec = vec_init(1);
+	vec.data = memory;
+	vec.count = 0;
+	vec._alloc_count = 8;
 
 	EXPECT_EQ(vec_collect(&vec), memory);
 	EXPECT_EQ(vec.data, nullptr);
@@ -430,6 +1477,209 @@ TEST(Vector, VecCollectOk) {
 	free(memory);
 }
 
+TEST(Vector, VecInitAllocOk) {
+	counting_ctx counter = { 0, 0, false };
+	vector_allocator allocator = {
+		.alloc = counting_alloc,
+		.resize = counting_resize,
+		.release = counting_release,
+		.ctx = &counter,
+	};
+
+	vector vec = vec_init_alloc(sizeof(char), &allocator);
+	EXPECT_EQ(vec.data, nullptr);
+	EXPECT_EQ(vec._allocator, &allocator);
+
+	EXPECT_EQ(vec_push(&vec, &element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &element1), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &element2), VECTOR_STATUS_OK);
+	EXPECT_EQ(counter.allocs, 1);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(counter.frees, 1);
+}
+
+TEST(Vector, VecNewAllocOk) {
+	counting_ctx counter = { 0, 0, false };
+	vector_allocator allocator = {
+		.alloc = counting_alloc,
+		.resize = counting_resize,
+		.release = counting_release,
+		.ctx = &counter,
+	};
+
+	vector *vec = vec_new_alloc(sizeof(char), &allocator);
+	EXPECT_NE(vec, nullptr);
+	EXPECT_EQ(counter.allocs, 1);
+
+	EXPECT_EQ(vec_push(vec, &element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(counter.allocs, 2);
+
+	EXPECT_EQ(vec_delete(vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(counter.frees, 2);
+}
+
+TEST(Vector, VecAllocFail) {
+	counting_ctx counter = { 0, 0, false };
+	vector_allocator allocator = {
+		.alloc = counting_alloc,
+		.resize = counting_resize,
+		.release = counting_release,
+		.ctx = &counter,
+	};
+
+	vector vec = vec_init_alloc(sizeof(char), &allocator);
+	EXPECT_EQ(vec_push(&vec, &element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &element1), VECTOR_STATUS_OK);
+
+	// Existing data is kept on failure
+	counter.fail = true;
+	EXPECT_EQ(vec_push(&vec, &element2), VECTOR_STATUS_ALLOC);
+	EXPECT_EQ(vec.count, 2);
+	EXPECT_EQ(*((char *)vec.data), element0);
+	EXPECT_EQ(*((char *)vec.data + 1), element1);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(counter.frees, 1);
+}
+
+TEST(Vector, VecInitTaggedOk) {
+	vector vec = vec_init_tagged(sizeof(int), "tagged");
+	EXPECT_EQ(vec_set_tag(&vec, "retagged"), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &int_element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(*(int *)vec_at(&vec, 0), int_element0);
+	vec_stats_dump(stderr, &vec);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+
+#ifdef VECTOR_STATS
+TEST(Vector, VecStatsNull) {
+	vector *vec = nullptr;
+
+	EXPECT_EQ(vec_set_tag(vec, "unused"), VECTOR_STATUS_NULL);
+}
+
+TEST(Vector, VecStatsOk) {
+	vector_stats before = vec_stats_total();
+
+	vector vec = vec_init_tagged(sizeof(int), "stats");
+	EXPECT_STREQ(vec._stats.tag, "stats");
+	EXPECT_EQ(vec_reserve(&vec, 4), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._stats.reallocs, 1);
+	EXPECT_EQ(vec._stats.live_bytes, vec._alloc_count * sizeof(int));
+
+	for (int i = 0; i < 4; i++) {
+		EXPECT_EQ(vec_push(&vec, &i), VECTOR_STATUS_OK);
+	}
+
+	// Insertion moves the tail
+	EXPECT_EQ(vec_insert(&vec, 1, &int_element0), VECTOR_STATUS_OK);
+	EXPECT_GE(vec._stats.reallocs, 2);
+	size_t moved = vec._stats.bytes_moved;
+	EXPECT_EQ(vec_insert(&vec, 1, &int_element1), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._stats.bytes_moved, moved + 4 * sizeof(int));
+
+	// Removal moves the tail back
+	moved = vec._stats.bytes_moved;
+	EXPECT_EQ(vec_erase(&vec, 0, nullptr), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._stats.bytes_moved, moved + 5 * sizeof(int));
+
+	size_t peak = vec._stats.peak_bytes;
+	EXPECT_EQ(peak, vec._alloc_count * sizeof(int));
+	EXPECT_EQ(vec_shrink_to_fit(&vec), VECTOR_STATUS_OK);
+	EXPECT_LT(vec._stats.live_bytes, peak);
+	EXPECT_EQ(vec._stats.peak_bytes, peak);
+
+	vector_stats during = vec_stats_total();
+	EXPECT_GE(during.reallocs, before.reallocs + 3);
+	EXPECT_GE(during.bytes_moved, before.bytes_moved + 9 * sizeof(int));
+	EXPECT_GE(during.peak_bytes, peak);
+
+	// Released storage leaves the totals
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_stats_total().live_bytes, before.live_bytes);
+}
+
+TEST(Vector, VecStatsClone) {
+	vector_stats before = vec_stats_total();
+
+	vector vec = vec_init_tagged(sizeof(int), "clone");
+	EXPECT_EQ(vec_push(&vec, &int_element0), VECTOR_STATUS_OK);
+	vector clone = vec_init_clone(&vec);
+	EXPECT_STREQ(clone._stats.tag, "clone");
+	vector cow = vec_init_clone_cow(&vec);
+	EXPECT_STREQ(cow._stats.tag, "clone");
+	EXPECT_EQ(cow._stats.reallocs, 0);
+	EXPECT_EQ(cow._stats.live_bytes, 0);
+
+	// Shared storage is released once
+	EXPECT_EQ(vec_push(&cow, &int_element1), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_deinit(&cow), VECTOR_STATUS_OK);
+
+	int *inner_data = (int *)vec_collect(&clone);
+	EXPECT_EQ(vec_stats_total().live_bytes, before.live_bytes);
+	free(inner_data);
+}
+
+TEST(Vector, VecStatsFile) {
+	std::string path = testing::TempDir() + "vector_file_stats";
+	remove(path.c_str());
+
+	// Opening a file starts from fresh statistics
+	vector vec;
+	memset(&vec, 0xff, sizeof(vec));
+	EXPECT_EQ(vec_open_file(&vec, path.c_str(), sizeof(int)), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec._stats.tag, nullptr);
+	EXPECT_EQ(vec._stats.reallocs, 0);
+	EXPECT_EQ(vec._stats.live_bytes, 0);
+	EXPECT_EQ(vec_set_tag(&vec, "file"), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+
+	remove(path.c_str());
+}
+
+TEST(Vector, VecStatsAdopt) {
+	vector_stats before = vec_stats_total();
+
+	vector vec = vec_init(sizeof(int));
+	vec.data = malloc(4 * sizeof(int));
+	vec._alloc_count = 4;
+	vec_stats_adopt(&vec);
+	EXPECT_EQ(vec._stats.live_bytes, 4 * sizeof(int));
+	EXPECT_EQ(vec_stats_total().live_bytes,
+		before.live_bytes + 4 * sizeof(int));
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_stats_total().live_bytes, before.live_bytes);
+
+	// Releasing storage that was never counted does not wrap the total
+	vec.data = malloc(4 * sizeof(int));
+	vec._alloc_count = 4;
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+	EXPECT_LE(vec_stats_total().live_bytes, before.live_bytes);
+}
+
+TEST(Vector, VecStatsDump) {
+	vector vec = vec_init_tagged(sizeof(int), "dump");
+	EXPECT_EQ(vec_reserve(&vec, 8), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec_push(&vec, &int_element0), VECTOR_STATUS_OK);
+
+	char buffer[256];
+	FILE *stream = fmemopen(buffer, sizeof(buffer), "w");
+	vec_stats_dump(stream, &vec);
+	vec_stats_dump(stream, nullptr);
+	fclose(stream);
+
+	std::string output = buffer;
+	std::string slack = std::to_string((vec._alloc_count - 1) * sizeof(int));
+	EXPECT_EQ(output.find("dump: reallocs=1 moved=0"), 0);
+	EXPECT_NE(output.find("slack=" + slack + "\n"), std::string::npos);
+	EXPECT_NE(output.find("total: reallocs="), std::string::npos);
+
+	EXPECT_EQ(vec_deinit(&vec), VECTOR_STATUS_OK);
+}
+#endif
+
 TEST(Vector, FullTest) {
 	vector *vec = vec_new(sizeof(char));
 
@@ -462,3 +1712,75 @@ TEST(Vector, FullTest) {
 
 	free(inner_data);
 }
+
+TEST(Vector, TypedPushOk) {
+	vector vec = vec_init(sizeof(int));
+
+	EXPECT_EQ(intvec_push(nullptr, int_element0), VECTOR_STATUS_NULL);
+
+	EXPECT_EQ(intvec_push(&vec, int_element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(intvec_push(&vec, int_element1), VECTOR_STATUS_OK);
+	EXPECT_EQ(intvec_push(&vec, int_element2), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.count, 3);
+	EXPECT_EQ(vec._alloc_count, 4);
+
+	EXPECT_EQ(*((int *)vec.data), int_element0);
+	EXPECT_EQ(*((int *)vec.data + 1), int_element1);
+	EXPECT_EQ(*((int *)vec.data + 2), int_element2);
+
+	vec_deinit(&vec);
+}
+
+TEST(Vector, TypedPushShared) {
+	vector vec = vec_init(sizeof(int));
+	intvec_push(&vec, int_element0);
+	vector cloned_vec = vec_init_clone_cow(&vec);
+
+	EXPECT_EQ(intvec_push(&cloned_vec, int_element1), VECTOR_STATUS_OK);
+	EXPECT_EQ(intvec_insert(&vec, 0, int_element2), VECTOR_STATUS_OK);
+	EXPECT_NE(cloned_vec.data, vec.data);
+	EXPECT_EQ(*intvec_at(&cloned_vec, 0), int_element0);
+	EXPECT_EQ(*intvec_at(&cloned_vec, 1), int_element1);
+	EXPECT_EQ(*intvec_at(&vec, 0), int_element2);
+	EXPECT_EQ(*intvec_at(&vec, 1), int_element0);
+
+	vec_deinit(&vec);
+	vec_deinit(&cloned_vec);
+}
+
+TEST(Vector, TypedInsertOk) {
+	vector vec = vec_init(sizeof(int));
+
+	EXPECT_EQ(intvec_insert(nullptr, 0, int_element0), VECTOR_STATUS_NULL);
+	EXPECT_EQ(intvec_insert(&vec, 1, int_element0), VECTOR_STATUS_BOUNDS);
+
+	EXPECT_EQ(intvec_insert(&vec, 0, int_element0), VECTOR_STATUS_OK);
+	EXPECT_EQ(intvec_insert(&vec, 1, int_element1), VECTOR_STATUS_OK);
+	EXPECT_EQ(intvec_insert(&vec, 0, int_element2), VECTOR_STATUS_OK);
+	EXPECT_EQ(vec.count, 3);
+
+	EXPECT_EQ(*((int *)vec.data), int_element2);
+	EXPECT_EQ(*((int *)vec.data + 1), int_element0);
+	EXPECT_EQ(*((int *)vec.data + 2), int_element1);
+
+	vec_deinit(&vec);
+}
+
+TEST(Vector, TypedAtOk) {
+	vector vec = vec_init(sizeof(int));
+
+	EXPECT_EQ(intvec_at(nullptr, 0), nullptr);
+	EXPECT_EQ(intvec_at(&vec, 0), nullptr);
+
+	intvec_push(&vec, int_element0);
+	intvec_push(&vec, int_element1);
+
+	EXPECT_EQ(*intvec_at(&vec, 0), int_element0);
+	EXPECT_EQ(*intvec_at(&vec, 1), int_element1);
+	EXPECT_EQ(intvec_at(&vec, 2), nullptr);
+
+	// Interoperable with generic functions
+	EXPECT_EQ(intvec_at(&vec, 1), vec_at(&vec, 1));
+
+	vec_deinit(&vec);
+}